@@ -48,7 +48,7 @@
 #include <math.h> // include standard math library header file
 
 #include "mcal/mcal.h" // required to include p33SMPS_devices.h
-#include "mcal/config/devcfg_oscillator.h"
+#include "mcal/config/devcfg_clocktree.h"
 
 /*!START_OS_BEFORE_MAIN
  *****************************************************************************
@@ -281,12 +281,14 @@
 #define TASK_MGR_MASTER_PACE                (float)(100.0e-6)     // Schedule time step in [sec]
 #define TASK_MGR_RESCUE_PACE                (float)(200.0e-6)     // Rescue timer time step in [sec]
     
-#define TASK_MGR_MASTER_PERIOD              (uint16_t)((float)system_frequencies.fcy * (float)TASK_MGR_MASTER_PACE)
-#define TASK_MGR_RESCUE_PERIOD              (uint16_t)((float)system_frequencies.fcy * (float)TASK_MGR_RESCUE_PACE)
+#define TASK_MGR_MASTER_PERIOD              (uint16_t)((float)CLOCK_FCY * (float)TASK_MGR_MASTER_PACE) // resolved at compile time
+#define TASK_MGR_RESCUE_PERIOD              (uint16_t)((float)CLOCK_FCY * (float)TASK_MGR_RESCUE_PACE) // resolved at compile time
 
 #define TASK_MGR_TIMER_INDEX                1       // Index of the timer peripheral used
 #define TASK_MGR_TIMER_COUNTER_REGISTER     TMR1    // Timer counter register
 #define TASK_MGR_TIMER_PERIOD_REGISTER      PR1     // Timer Period register
+#define TASK_MGR_TIMER_ISR_FLAG_REGISTER    IFS0    // Timer interrupt flag register
+#define TASK_MGR_TIMER_ISR_FLAG_BIT_MASK    0x0002  // Timer interrupt flag bit mask (IFS0.T1IF)
 #define TASK_MGR_ISR_PRIORITY               3       // Timer ISR priority (Always leave 1))
 #define TASK_MGR_TMR_IF                     _T1IF   // Timer ISR Flag Bit
 #define TASK_MGR_TMR_IE                     _T1IE   // Timer ISR Enable Bit
@@ -363,7 +365,7 @@
 
 #endif
 
-#define TASK_MGR_CPU_LOAD_FACTOR    (uint16_t)(((float)(1000.000)/(float)(TASK_MGR_MASTER_PERIOD))*pow(2, 16))
+#define TASK_MGR_CPU_LOAD_FACTOR    (uint16_t)(((float)(1000.000)/(float)(TASK_MGR_MASTER_PERIOD))*65536.0)
 
 /*!Software CPU Reset Occurrence Limit
  * ***********************************************************************************************
@@ -374,14 +376,278 @@
  * loaded/read/executed, the fault handler will initiare a Warm CPU Reset. 
  * 
  * In case of a persistent failure, this would result in a continuously rebooting system, 
- * which may be problematic. To limit the number of reboot events, users can set a threshold 
- * here, limiting the number of restart attempts.
+ * which may be problematic. To limit the number of reboot events, all CPU resets except power-on, 
+ * brown-out and external (MCLR) resets are accumulated in a decaying reset rate counter, which is
+ * evaluated by CheckCPUResetRootCause() after every reset to select the restart profile:
+ * 
+ *     - TASK_MGR_CPU_RESET_LIMIT: Reset rate at which the system is brought into a safe stop 
+ *       (STANDBY mode, no power conversion, telemetry remains available)
+ *     - TASK_MGR_CPU_RESET_DEGRADED: Reset rate at which the system restarts in degraded mode
+ *       (only one fault recovery attempt, no warm restarts)
+ *     - TASK_MGR_CPU_RESET_DECAY_TIME: Time of uninterrupted operation after which the reset 
+ *       rate has decayed by one reset
+ * 
+ * Uncontrolled resets (traps, illegal opcode, watchdog, configuration mismatch) always restart 
+ * the system in degraded mode.
  * 
  * See also:
- * (none)
+ * fdrv_FaultHandler.c
+ * ***********************************************************************************************/
+
+#define TASK_MGR_CPU_RESET_LIMIT        10  // Reset rate threshold of safe stop
+#define TASK_MGR_CPU_RESET_DEGRADED     3   // Reset rate threshold of degraded mode
+#define TASK_MGR_CPU_RESET_DECAY_TIME   60.0 // Reset rate decay time per reset in [sec]
+#define TASK_MGR_CPU_RESET_DECAY_PERIOD (uint32_t)(TASK_MGR_CPU_RESET_DECAY_TIME / 256.0 / TASK_MGR_MASTER_PACE) // Decay period per reset rate LSB in [ticks]
+
+/*!USE_TRAP_CRASH_RECORD
+ * ***********************************************************************************************
+ * Description:
+ * When enabled, every trap vector saves a crash record into the persistent data section before
+ * the trap service routine executes any other code. The crash record holds the working registers
+ * W0-W15, SR, CORCON, the program counter and status byte of the exception frame, trap ID, task
+ * ID and operating mode as well as the topmost stack words below the exception frame.
+ *
+ *     - TRAP_CRASH_STACK_DEPTH: Number of stack words captured in the crash record
+ *
+ * The crash record survives a warm CPU reset and can be read out and symbolized against the
+ * built ELF file using tools/crash_dump_decoder.py.
+ *
+ * See also:
+ * fdrv_TrapHandler.c
+ * ***********************************************************************************************/
+
+#define USE_TRAP_CRASH_RECORD       1   // Enable/Disable crash record capture in trap service routines
+#define TRAP_CRASH_STACK_DEPTH      16  // Number of stack words captured in the crash record
+
+/*!USE_WARM_RESTART
+ * ***********************************************************************************************
+ * Description:
+ * When the main scheduler is terminated by clearing the flag run_scheduler (e.g. by a
+ * catastrophic fault), the CPU is reset and the firmware runs through the full cold start
+ * (DEVICE_Reset, CLOCK_Initialize, BOOT and FIRMWARE_INIT queues).
+ *
+ * When the warm restart is enabled, the scheduler is restarted without CPU reset, keeping clock
+ * and peripheral configurations, if
+ *
+ *     - no CPU trap has occurred since the cold start (traplog),
+ *     - the oscillator and PLLs are still locked to the configured clock source,
+ *     - the checksum of clock and OS timer configuration captured after the cold start is unchanged and
+ *     - the system is not running in degraded mode and the reset rate remains below 
+ *       TASK_MGR_CPU_RESET_LIMIT.
+ *
+ * Warm restarts resume operation with the STARTUP_SEQUENCE queue. If any of the conditions is
+ * not met, the CPU is reset and goes through the cold start.
+ *
+ * See also:
+ * os_Initialize.c
+ * ***********************************************************************************************/
+
+#define USE_WARM_RESTART            1   // Enable/Disable warm restart of the scheduler without CPU reset
+
+/*!USE_NONBLOCKING_PERIPHERAL_INIT
+ * ***********************************************************************************************
+ * Description:
+ * Peripherals such as the auxiliary PLL, ADC cores and high resolution PWM need to wait for 
+ * hardware ready bits before they can be used. The default peripheral library functions poll these 
+ * bits in blocking loops, one peripheral after the other. When enabled, the auxiliary PLL lock is 
+ * no longer awaited by CLOCK_Initialize() and all waits are executed as non-blocking sequences, 
+ * which are advanced in parallel by task exec_InitSequences() once per scheduler tick:
+ * 
+ *     - AuxOscillator_InitStart(): auxiliary PLL lock
+ *     - ADC_PowerUpStart(): ADC band gap reference, core power-up and warm-up of all selected cores
+ *     - HRPWM_EnableStart(): high resolution PWM ready and PWM generator enable
+ * 
+ * The auxiliary PLL sequence is started by CLOCK_Initialize(). The ADC and PWM sequences are started
+ * by exec_InitSequences() on its first execution, after the preceding user tasks of the FIRMWARE_INIT 
+ * task queue have configured ADC and PWM: 
+ * 
+ *     - INIT_SEQUENCE_ADC_CORES: ADC cores to be powered up (bit #n = ADC core #n, index 
+ *       ADC_SHARED_CORE_INDEX = shared ADC core). The ADC module needs to be enabled (ADON = 1).
+ *     - INIT_SEQUENCE_PWM_GENERATORS: PWM generators to be enabled (bit #0 = PG1, bit #1 = PG2, etc.)
+ * 
+ * A selection of 0x0000 disables the respective sequence. While any sequence is pending, the task 
+ * manager repeats the last task of task_queue_firmware_init[], which therefore needs to be 
+ * TASK_INIT_SEQUENCES. If a sequence is not completed within INIT_SEQUENCE_TIMEOUT or reports an 
+ * error, the system enters standby mode.
+ * 
+ * The sequences run after a CPU reset (cold start) only. Warm restarts (see USE_WARM_RESTART) skip
+ * CLOCK_Initialize() and the FIRMWARE_INIT task queue and do not run any sequence.
+ * 
+ * See also:
+ * init_sequence.c
+ * ***********************************************************************************************/
+
+#define USE_NONBLOCKING_PERIPHERAL_INIT 1   // Enable/Disable non-blocking peripheral initialization sequences
+#define INIT_SEQUENCE_TIMEOUT       (uint16_t)(20.0e-3 / TASK_MGR_MASTER_PACE) // Timeout of each initialization sequence of 20 ms in [ticks]
+#define INIT_SEQUENCE_ADC_CORES     0x0000  // ADC cores powered up by the ADC initialization sequence (0x0000 = no ADC sequence)
+#define INIT_SEQUENCE_PWM_GENERATORS 0x0000 // PWM generators enabled by the PWM initialization sequence (0x0000 = no PWM sequence)
+
+/*!USE_BOOT_PROFILER
+ * ***********************************************************************************************
+ * Description:
+ * When enabled, the end of every startup phase is time-stamped from the entry of OS_Execute() 
+ * through reset root cause evaluation, device reset, clock initialization (incl. PLL lock wait),
+ * device and OS initialization, the BOOT, FIRMWARE_INIT and STARTUP_SEQUENCE task queues up to 
+ * the first tick of the RUN task queue. Phase durations are stored in the persistent boot report 
+ * (boot_report), which can be decoded using tools/boot_report_decoder.py.
+ * 
+ * Please note:
+ * The profiler enables the Dead Man Timer (DMT) right after reset to count instruction cycles.
+ * The DMT count limit set in the device configuration bits needs to cover the entire startup 
+ * until the scheduler starts.
+ * 
+ * See also:
+ * os_BootProfiler.c
+ * ***********************************************************************************************/
+
+#define USE_BOOT_PROFILER           1   // Enable/Disable startup-time profiler
+
+/*!USE_REGISTER_IMAGES
+ * ***********************************************************************************************
+ * Description:
+ * When enabled, DEVICE_Initialize() configures peripherals by applying the constant register 
+ * images listed in register_image_list[]. Each image is written in one pass and verified by a 
+ * single checksum over the register readback instead of being configured and verified register 
+ * by register by the peripheral library. OS_WarmRestart() verifies every image and re-applies 
+ * only those images whose contents has changed. 
+ * 
+ * Register images are generated from src/apl/config/UserRegisterImages.txt by the host tool 
+ * tools/register_image_generator.py.
+ * 
+ * See also:
+ * init_regimage.c
+ * ***********************************************************************************************/
+
+#define USE_REGISTER_IMAGES         0   // Enable/Disable peripheral configuration by register images
+
+/*!FAULT_REGISTRY_SIZE
+ * ***********************************************************************************************
+ * Description:
+ * All fault objects are registered by their fault object ID in the fault registry, which allows
+ * constant-time access to fault objects by ID and masking of entire fault groups. Fault object
+ * IDs must be unique and less than FAULT_REGISTRY_SIZE.
+ * 
+ * See also:
+ * fdrv_FaultRegistry.c
+ * ***********************************************************************************************/
+
+#define FAULT_REGISTRY_SIZE         16  // Number of fault object IDs supported by the fault registry
+
+/*!USE_FAULT_RULES
+ * ***********************************************************************************************
+ * Description:
+ * When enabled, the composite fault rules listed in user_fault_rule_list[] are validated during
+ * fault handler initialization and evaluated by exec_FaultCheckAll() at the beginning of every 
+ * fault check cycle. Rules are compiled from src/apl/config/UserFaultRules.txt into 
+ * UserFaultRules.c by the host tool tools/fault_rule_compiler.py. Each rule result needs to be
+ * monitored by a fault object to take effect.
+ * 
+ * Please note:
+ * Every enabled rule adds its execution time to every fault check cycle. Rules which are not
+ * monitored by any fault object should be removed from the rule source file.
+ * 
+ * See also:
+ * fdrv_FaultRules.c
+ * ***********************************************************************************************/
+
+#define USE_FAULT_RULES             0   // Enable/Disable composite fault rules
+
+/*!USE_FAULT_HISTORY_LOG
+ * ***********************************************************************************************
+ * Description:
+ * When enabled, every fault trip event is recorded in a persistent ring buffer (fault_log), which
+ * survives warm CPU resets. Each record holds the fault ID, operating mode, task ID, system 
+ * time stamp, source value at trip and time-in-fault. Additionally, trip events and accumulated
+ * time-in-fault are counted per fault object ID.
+ * 
+ * The log can be read from RAM by a debugger or communication interface and decoded on the
+ * host using tools/fault_log_decoder.py.
+ * 
+ *     - FAULT_LOG_SIZE: Number of records in the ring buffer
+ *     - FAULT_LOG_OBJECT_COUNT: Number of fault object IDs covered by the occurrence statistics
+ *       (fault objects with IDs beyond this number are logged but not counted)
+ * 
+ * Please note:
+ * The size settings need to be passed on to the host decoder when they are changed.
+ * 
+ * See also:
+ * fdrv_FaultLog.c
+ * ***********************************************************************************************/
+
+#define USE_FAULT_HISTORY_LOG       1   // Enable/Disable persistent fault history log
+#define FAULT_LOG_SIZE              16  // Number of fault event records in persistent ring buffer
+#define FAULT_LOG_OBJECT_COUNT      16  // Number of fault object IDs tracked by occurrence statistics
+
+/*!USE_FAULT_LATENCY_INSTRUMENTATION
+ * ***********************************************************************************************
+ * Description:
+ * When enabled, the fault handler captures time stamps of the first threshold violation, the
+ * trip event, the completion of the fault response (incl. user trip function) and the entry of
+ * the fault task queue for each fault object. The measured latencies are accumulated in
+ * histograms per fault object ID (fault_latency), which can be read at runtime or from a host
+ * simulation and decoded using tools/fault_latency_report.py.
+ * 
+ *     - FAULT_LATENCY_OBJECT_COUNT: Number of fault object IDs covered by the instrumentation
+ *       (fault objects with IDs beyond this number are not measured)
+ * 
+ * Please note:
+ * The instrumentation adds execution time to every fault check cycle and requires approx.
+ * 128 bytes of RAM per fault object ID. It should only be enabled during development.
+ * 
+ * See also:
+ * fdrv_FaultLatency.c
+ * ***********************************************************************************************/
+
+#define USE_FAULT_LATENCY_INSTRUMENTATION   0   // Enable/Disable fault response latency instrumentation
+#define FAULT_LATENCY_OBJECT_COUNT          8   // Number of fault object IDs covered by latency histograms
+
+/*!USE_FAULT_FAST_PATH
+ * ***********************************************************************************************
+ * Description:
+ * Critical and catastrophic fault objects are usually detected by exec_FaultCheckAll() once per
+ * OS master period. When the fault fast path is enabled, designated fault objects are also 
+ * checked inside the control loop interrupt service routine by exec_FaultFastPathCheck(), which 
+ * overrides the PWM outputs immediately when the trip level is exceeded. The fault response is
+ * then executed by the regular fault handler at the next fault check cycle.
+ * 
+ *     - FAULT_FAST_PATH_SIZE: Maximum number of fault objects checked in interrupt context
+ * 
+ * Fault objects are designated by calling SetFaultFastPath() in their initialization function.
+ * 
+ * See also:
+ * fdrv_FaultFastPath.c
+ * ***********************************************************************************************/
+
+#define USE_FAULT_FAST_PATH                 1   // Enable/Disable fault fast path in interrupt context
+#define FAULT_FAST_PATH_SIZE                4   // Maximum number of fault objects checked in interrupt context
+
+/*!USE_FAULT_RECOVERY_ENGINE
+ * ***********************************************************************************************
+ * Description:
+ * When the staged fault recovery engine is disabled, the system restarts from fault mode as soon
+ * as all fault conditions have been cleared. When enabled, the restart is sequenced in time:
+ *
+ *     - FAULT_RECOVERY_COOL_DOWN: Time all fault conditions need to remain cleared before restart
+ *     - FAULT_RECOVERY_BACKOFF_MAX: The cool-down period is doubled with every restart attempt
+ *       within the retry window, up to 2^FAULT_RECOVERY_BACKOFF_MAX times the cool-down period
+ *     - FAULT_RECOVERY_ATTEMPTS_MAX: Number of restart attempts within the retry window before
+ *       the system is permanently locked in fault mode
+ *     - FAULT_RECOVERY_WINDOW: Retry window starting with the first restart attempt
+ *     - FAULT_RECOVERY_STAGE_DELAY: Delay between the re-enable stages of fault groups listed
+ *       in user_fault_recovery_stages[] after restart
+ *
+ * All periods are converted into number of OS master periods (system ticks).
+ *
+ * See also:
+ * fdrv_FaultRecovery.c
  * ***********************************************************************************************/
 
-#define TASK_MGR_CPU_RESET_LIMIT    10
+#define USE_FAULT_RECOVERY_ENGINE           1   // Enable/Disable staged fault recovery engine
+#define FAULT_RECOVERY_COOL_DOWN            (uint32_t)(100.0e-3 / TASK_MGR_MASTER_PACE) // Cool-down period of 100 ms in [ticks]
+#define FAULT_RECOVERY_BACKOFF_MAX          3   // Maximum cool-down period = 2^3 x 100 ms = 800 ms
+#define FAULT_RECOVERY_ATTEMPTS_MAX         5   // Maximum number of restart attempts within the retry window
+#define FAULT_RECOVERY_WINDOW               (uint32_t)(10.0 / TASK_MGR_MASTER_PACE) // Retry window of 10 sec in [ticks]
+#define FAULT_RECOVERY_STAGE_DELAY          (uint32_t)(10.0e-3 / TASK_MGR_MASTER_PACE) // Fault group re-enable stage delay of 10 ms in [ticks]
 
  /* ***********************************************************************************************
  * PROTOTYPES
@@ -0,0 +1,151 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * File:   fdrv_FaultFastPath.h
+ * Author: M91406
+ * Comments: Fault handler function driver header file of the interrupt-context fault fast path
+ * Revision history:
+ * 1.0  Initial release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef _ROOT_FUNCTION_DRIVER_FAULT_FAST_PATH_H_
+#define	_ROOT_FUNCTION_DRIVER_FAULT_FAST_PATH_H_
+
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "_root/config/task_manager_config.h"
+#include "fdrv_FaultHandler.h"
+#include "fdrv_FaultRegistry.h"
+#include "fdrv_FaultLatency.h"
+#include "os_TaskManager.h"
+#include "mcal/mcal.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!FAULT_FAST_PATH_t
+ * ***********************************************************************************************
+ * Description:
+ * Fault objects of class FLT_CLASS_CRITICAL or FLT_CLASS_CATASTROPHIC may be designated for the
+ * fast path by calling SetFaultFastPath() in their fault object initialization function. The
+ * fast path entry holds a copy of the fault criteria reduced to one unsigned 16-bit comparison,
+ * which is evaluated by exec_FaultFastPathCheck() inside the control loop interrupt service
+ * routine.
+ *
+ * FAULT_LEVEL_LESS_THAN comparisons are mapped onto FAULT_LEVEL_GREATER_THAN comparisons by
+ * inverting source value and trip level (compare_invert = 0xFFFF), so every entry is checked
+ * by the same instruction sequence in constant time.
+ *
+ * When the trip level is exceeded, all PWM generators selected by pwm_mask are overridden
+ * immediately by smpsHSPWM_OVR_Hold() and the entry is marked as tripped. The next call of
+ * exec_FaultCheckAll() hands the tripped entry over to the regular fault handler, which
+ * executes the fault response, fault log and fault latency bookkeeping of the fault object.
+ * Like the regular fault check, the fast path only monitors fault objects which are enabled
+ * (fltchk_enabled) and not member of a masked fault group (fault_registry.groups_disabled).
+ *
+ * Please note:
+ * The PWM override is not released by the fault handler. Releasing the PWM outputs is left
+ * to the power converter startup sequence following the fault recovery.
+ * ***********************************************************************************************/
+
+typedef enum {
+    FLTFAST_STATE_ARMED       = 0b0000000000000000, // Fast path entry is monitoring its source object
+    FLTFAST_STATE_TRIPPED     = 0b0000000000000001, // Fast path entry has tripped in interrupt context
+    FLTFAST_STATE_HANDED_OVER = 0b0000000000000010 // Fault object has been handed over to the fault handler
+}FAULT_FAST_PATH_STATE_e;
+
+typedef struct {
+    volatile FAULT_OBJECT_t* fltobj; // Fault object handed over to the regular fault handler
+    volatile uint16_t* source_object; // Pointer to the monitored object (copy of fault criteria)
+    volatile uint16_t source_bit_mask; // Bit mask filter of the monitored object (copy of fault criteria)
+    volatile uint16_t compare_invert; // 0x0000 = 'greater than', 0xFFFF = 'less than' comparison
+    volatile uint16_t trip_level; // Trip level (inverted for 'less than' comparisons)
+    volatile uint16_t pwm_mask; // PWM generators overridden when tripped (bit #0 = PG1, bit #1 = PG2, etc.)
+    volatile uint16_t state; // Fast path entry state (FAULT_FAST_PATH_STATE_e)
+    volatile uint32_t t_violation; // Time stamp of the trip level violation (fault latency instrumentation only)
+} FAULT_FAST_PATH_t;
+
+extern volatile FAULT_FAST_PATH_t fault_fast_path[];
+extern volatile uint16_t fault_fast_path_count;
+
+/*!exec_FaultFastPathCheck
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      (none)
+ *
+ * Description:
+ * Checks all fast path entries for trip level violations. This function is meant to be called
+ * from the control loop interrupt service routine right after the ADC results have been read.
+ * In non-tripped condition, each entry is evaluated by the same instruction sequence in constant
+ * time. Entries of disabled fault objects or of fault objects in masked fault groups are not
+ * tripped. The PWM override of a tripped entry is executed before this function returns.
+ * With fault latency instrumentation enabled, the time stamp of the violation is captured here,
+ * so the detect latency covers the time until the fault handler trips the fault object.
+ * ***********************************************************************************************/
+static inline void exec_FaultFastPathCheck(void)
+{
+    uint16_t i=0, j=0, pwm_mask=0;
+    volatile FAULT_FAST_PATH_t* entry = &fault_fast_path[0];
+
+    for(i=0; i<fault_fast_path_count; i++)
+    {
+        if(((((*entry->source_object) & entry->source_bit_mask) ^ entry->compare_invert) > entry->trip_level) &&
+            (entry->state == FLTFAST_STATE_ARMED) && (entry->fltobj->status.bits.fltchk_enabled) &&
+            (!(entry->fltobj->groups & fault_registry.groups_disabled)))
+        {
+            pwm_mask = entry->pwm_mask;
+            for(j=1; pwm_mask != 0; j++)
+            {
+                if(pwm_mask & 0x0001) { smpsHSPWM_OVR_Hold(j); } // Override PWM outputs immediately
+                pwm_mask >>= 1;
+            }
+            #if (USE_FAULT_LATENCY_INSTRUMENTATION == 1)
+            entry->t_violation = os_GetSystemTimestamp();
+            #endif
+            entry->state = FLTFAST_STATE_TRIPPED;
+        }
+        entry++;
+    }
+
+    return;
+}
+
+/* PROTOTYPES */
+extern volatile uint16_t os_FaultFastPath_Initialize(void);
+extern volatile uint16_t SetFaultFastPath(volatile FAULT_OBJECT_t* fltobj, volatile uint16_t pwm_mask);
+extern volatile uint16_t exec_FaultFastPathHandoff(void);
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* _ROOT_FUNCTION_DRIVER_FAULT_FAST_PATH_H_ */
+
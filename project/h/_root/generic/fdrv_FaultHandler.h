@@ -174,6 +174,41 @@ typedef enum {
     FAULT_LEVEL_OUT_OF_RANGE = 0b0000000000100000, // Flag to perform "greater than or less than" comparison
     FAULT_LEVEL_BOOLEAN      = 0b0000000001000000  // Flag to perform a "true/false" comparison (e.g. bit-test)
 }FLTOBJ_COMPARE_TYPE_e;
+
+/*!FLTOBJ_SOURCE_TYPE_e
+ * ***********************************************************************************************
+ * Description:
+ * FLTOBJ_SOURCE_TYPE_e specifies the data type of the monitored source object (and compare object,
+ * if used). The data type is selected when the fault object is initialized and determines which 
+ * specialized compare routine is used by the fault handler:
+ * 
+ *     - FLTOBJ_SOURCE_TYPE_UINT16 (default):
+ *       16-bit unsigned integer. Trip and reset levels are read from trip_level and reset_level.
+ * 
+ *     - FLTOBJ_SOURCE_TYPE_INT16 / FLTOBJ_SOURCE_TYPE_Q15:
+ *       16-bit signed integer resp. Q15 fractional number (e.g. bi-directional currents or signed 
+ *       error terms). Trip and reset levels are read from trip_level and reset_level and are 
+ *       interpreted as signed numbers. (Use macro FLTOBJ_LEVEL_Q15() to set Q15 levels)
+ * 
+ *     - FLTOBJ_SOURCE_TYPE_UINT32 / FLTOBJ_SOURCE_TYPE_INT32:
+ *       32-bit unsigned/signed integer (e.g. energy or event counters). Trip and reset levels are 
+ *       read from trip_level_32 and reset_level_32. Source and compare bit masks are not applied.
+ * 
+ * Please note:
+ * FLTOBJ_SOURCE_TYPE_UINT16 is zero, so fault objects which do not specify a source type 
+ * are processed as 16-bit unsigned integer objects.
+ * ***********************************************************************************************/
+
+typedef enum {
+    FLTOBJ_SOURCE_TYPE_UINT16 = 0b0000000000000000, // Source object is a 16-bit unsigned integer (default)
+    FLTOBJ_SOURCE_TYPE_INT16  = 0b0000000000000001, // Source object is a 16-bit signed integer
+    FLTOBJ_SOURCE_TYPE_UINT32 = 0b0000000000000010, // Source object is a 32-bit unsigned integer
+    FLTOBJ_SOURCE_TYPE_INT32  = 0b0000000000000011, // Source object is a 32-bit signed integer
+    FLTOBJ_SOURCE_TYPE_Q15    = 0b0000000000000100  // Source object is a 16-bit signed Q15 fractional number
+}FLTOBJ_SOURCE_TYPE_e;
+
+#define FLTOBJ_LEVEL_Q15(x)     ((uint16_t)((int16_t)((x) * 32767.0))) // Convert fractional number (-1.0 ... +1.0) into Q15 fault level
+#define FLTOBJ_LEVEL_INT16(x)   ((uint16_t)((int16_t)(x))) // Convert signed integer number into 16-bit fault level
     
 typedef struct {
     volatile uint16_t counter; // Fault event counter
@@ -182,13 +217,36 @@ typedef struct {
     volatile uint16_t* compare_object; // pointer to an object, with which the source object should be compared with (e.g. variable or SFR) 
     volatile uint16_t compare_bit_mask; // bit mask filter to monitor specific bits within OBJECT
     volatile FLTOBJ_COMPARE_TYPE_e compare_type; // specifies the kind of comparison to be performed
+    volatile FLTOBJ_SOURCE_TYPE_e source_type; // specifies the data type of source and compare object
     volatile uint16_t trip_level; // Input signal fault trip level/fault trip point
     volatile uint16_t trip_cnt_threshold; // Fault counter threshold triggering fault exception
     volatile uint16_t reset_level; // Input signal fault reset level/fault reset point
     volatile uint16_t reset_cnt_threshold; // Fault counter threshold resetting fault exception
+    volatile uint32_t trip_level_32; // 32-bit input signal fault trip level (32-bit source types only)
+    volatile uint32_t reset_level_32; // 32-bit input signal fault reset level (32-bit source types only)
 } FAULT_CONDITION_SETTINGS_t;
 
 
+/*!FAULT_GROUP_e
+ * ***********************************************************************************************
+ * Description:
+ * Every fault object can be member of one or more fault groups. Fault groups allow entire 
+ * categories of fault objects (e.g. all thermal or all input-side fault objects) to be masked 
+ * at once, e.g. during calibration or startup (see fdrv_FaultRegistry.h).
+ * ***********************************************************************************************/
+
+typedef enum {
+    FLTGRP_NONE     = 0b0000000000000000, // No group membership (fault object cannot be masked)
+    FLTGRP_OS       = 0b0000000000000001, // Operating system and task manager fault objects
+    FLTGRP_CPU      = 0b0000000000000010, // CPU and silicon-level fault objects
+    FLTGRP_INPUT    = 0b0000000000000100, // Input-side fault objects (e.g. input voltage, input current)
+    FLTGRP_OUTPUT   = 0b0000000000001000, // Output-side fault objects (e.g. output voltage, output current)
+    FLTGRP_THERMAL  = 0b0000000000010000, // Temperature fault objects
+    FLTGRP_CONTROL  = 0b0000000000100000, // Control loop and soft-start fault objects
+    FLTGRP_COMM     = 0b0000000001000000, // Communication interface fault objects
+    FLTGRP_USER     = 0b0000000010000000  // User-defined fault objects
+}FAULT_GROUP_e;
+
 /*!FAULT_OBJECT_t
  * ***********************************************************************************************
  * Description:
@@ -203,6 +261,7 @@ typedef struct {
     volatile uint32_t error_code; // error code helping to identify source module, system level and importance
     volatile FAULT_OBJECT_STATUS_t status; // status bit field
     volatile FAULT_OBJECT_CLASS_t flt_class; // fault class bit field
+    volatile uint16_t groups; // fault group membership bit mask (FAULT_GROUP_e)
     volatile FAULT_CONDITION_SETTINGS_t criteria; // Fault check settings of the  fault object
     volatile uint16_t (*trip_function)(void); // pointer to a user function called when a defined fault condition is detected
     volatile uint16_t (*reset_function)(void); // pointer to a user function called when a defined fault condition is detected
@@ -246,6 +305,39 @@ extern volatile uint16_t user_fltobj_list_size;
 #define FLT_CPU_RESET_CLASS_WARNING    0b0000000011000000
 #define FLT_CPU_RESET_CLASS_NORMAL     0b0000000000001111
 
+/*!CPU_RESTART_PROFILE_e
+ * ***********************************************************************************************
+ * Description:
+ * After every CPU reset, CheckCPUResetRootCause() classifies the reset root cause and selects
+ * one of the following restart profiles, which is kept in traplog.restart_profile:
+ * 
+ *     - CPU_RESTART_COLD:
+ *       Power-on, brown-out or external (MCLR) reset. Persistent trap log and crash record are
+ *       cleared and the reset rate counter is reset.
+ * 
+ *     - CPU_RESTART_WARM:
+ *       Software reset initiated by the firmware. Persistent logs are maintained for analysis 
+ *       and the system restarts normally.
+ * 
+ *     - CPU_RESTART_DEGRADED:
+ *       Uncontrolled reset (trap, illegal opcode, watchdog, configuration mismatch), software
+ *       reset following a trap or reset rate above TASK_MGR_CPU_RESET_DEGRADED. The system restarts with the degraded mode flag 
+ *       set, allowing only one fault recovery attempt and no warm restarts.
+ * 
+ *     - CPU_RESTART_SAFE_STOP:
+ *       Reset rate above TASK_MGR_CPU_RESET_LIMIT. The scheduler runs BOOT and FIRMWARE_INIT
+ *       queues and remains in STANDBY mode, keeping telemetry available without restarting 
+ *       the power conversion.
+ * 
+ * ***********************************************************************************************/
+
+typedef enum {
+    CPU_RESTART_COLD        = 0b0000000000000000, // Full cold start
+    CPU_RESTART_WARM        = 0b0000000000000001, // Warm start after controlled software reset
+    CPU_RESTART_DEGRADED    = 0b0000000000000010, // Start in degraded mode
+    CPU_RESTART_SAFE_STOP   = 0b0000000000000011  // Safe stop, system remains in standby mode
+}CPU_RESTART_PROFILE_e;
+
 
 /*!Fault Handler Prototypes
  * ***********************************************************************************************
@@ -256,6 +348,10 @@ extern volatile uint16_t os_FaultObjects_Initialize(void);
 
 extern volatile uint16_t CaptureCPUInterruptStatus(void);
 extern volatile uint16_t CheckCPUResetRootCause(void);
+extern volatile uint16_t ExecCPUResetRateDecay(void);
+
+extern volatile uint16_t ExecFaultTrip(volatile FAULT_OBJECT_t* fltobj);
+extern volatile uint16_t ExecFaultRecoveryRestart(void);
 
 extern volatile uint16_t exec_FaultCheckAll(void);
 extern volatile uint16_t exec_FaultCheckSequential(void);
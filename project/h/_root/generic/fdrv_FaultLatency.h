@@ -0,0 +1,127 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * File:   fdrv_FaultLatency.h
+ * Author: M91406
+ * Comments: Fault handler function driver header file of the fault response latency instrumentation
+ * Revision history:
+ * 1.0  Initial release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef _ROOT_FUNCTION_DRIVER_FAULT_LATENCY_H_
+#define	_ROOT_FUNCTION_DRIVER_FAULT_LATENCY_H_
+
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "_root/config/task_manager_config.h"
+#include "fdrv_FaultHandler.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!FAULT_LATENCY_EVENT_e
+ * ***********************************************************************************************
+ * Description:
+ * Events along the fault response path at which a time stamp is captured:
+ *
+ *     - FLTLAT_EVENT_VIOLATION: first threshold violation of the fault condition (fault counter = 1)
+ *     - FLTLAT_EVENT_TRIP: fault counter has reached its threshold and the fault status is set
+ *     - FLTLAT_EVENT_RESPONSE: fault handler and user trip function have been completed
+ *     - FLTLAT_EVENT_QUEUE_ENTRY: task manager has switched over to the fault task queue
+ *
+ * ***********************************************************************************************/
+
+typedef enum {
+    FLTLAT_EVENT_VIOLATION   = 0b0000000000000000, // First threshold violation has been detected
+    FLTLAT_EVENT_TRIP        = 0b0000000000000001, // Fault object has tripped
+    FLTLAT_EVENT_RESPONSE    = 0b0000000000000010, // Fault response/trip function has been completed
+    FLTLAT_EVENT_QUEUE_ENTRY = 0b0000000000000011  // Fault task queue has been entered
+}FAULT_LATENCY_EVENT_e;
+
+/*!FAULT_LATENCY_STAGE_e
+ * ***********************************************************************************************
+ * Description:
+ * Latencies are measured between the captured events and accumulated in one histogram per stage:
+ *
+ *     - FLTLAT_STAGE_DETECT: first threshold violation => trip (fault counter filter delay)
+ *     - FLTLAT_STAGE_RESPONSE: trip => completion of fault handler and user trip function
+ *     - FLTLAT_STAGE_QUEUE: trip => fault task queue entry (FLT_CLASS_CRITICAL objects only)
+ *
+ * ***********************************************************************************************/
+
+typedef enum {
+    FLTLAT_STAGE_DETECT   = 0, // Latency between first threshold violation and trip event
+    FLTLAT_STAGE_RESPONSE = 1, // Latency between trip event and completed fault response
+    FLTLAT_STAGE_QUEUE    = 2  // Latency between trip event and fault task queue entry
+}FAULT_LATENCY_STAGE_e;
+
+#define FAULT_LATENCY_STAGE_COUNT   3   // Number of measured latency stages
+#define FAULT_LATENCY_BINS          16  // Number of histogram bins (bin n covers 4^n ... 4^(n+1)-1 timer cycles)
+
+/*!FAULT_LATENCY_RECORD_t
+ * ***********************************************************************************************
+ * Description:
+ * Each fault object ID below FAULT_LATENCY_OBJECT_COUNT owns one latency record. Time stamps and
+ * latencies are given in cycles of the task manager timer (see TASK_MGR_MASTER_PERIOD), combining
+ * the system tick counter and the timer counter register. Latencies are sorted into logarithmic
+ * histogram bins, where bin #n counts latencies between 4^n and 4^(n+1)-1 timer cycles.
+ *
+ * Please note:
+ * The data layout must match the record definition in tools/fault_latency_report.py
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint32_t t_violation; // Time stamp of the most recent first threshold violation
+    volatile uint32_t t_trip; // Time stamp of the most recent trip event
+    volatile uint32_t t_response; // Time stamp of the most recent fault response completion
+    volatile uint16_t queue_pending; // Flag indicating that the fault queue entry of a trip event is pending
+    volatile uint16_t sample_count[FAULT_LATENCY_STAGE_COUNT]; // Number of latency samples per stage (saturating)
+    volatile uint32_t latency_max[FAULT_LATENCY_STAGE_COUNT]; // Maximum latency per stage
+    volatile uint16_t histogram[FAULT_LATENCY_STAGE_COUNT][FAULT_LATENCY_BINS]; // Latency histograms per stage (saturating)
+} FAULT_LATENCY_RECORD_t;
+
+typedef struct {
+    volatile uint16_t object_count; // Number of latency records (FAULT_LATENCY_OBJECT_COUNT)
+    volatile FAULT_LATENCY_RECORD_t record[FAULT_LATENCY_OBJECT_COUNT]; // Latency records per fault object ID
+} FAULT_LATENCY_t;
+
+extern volatile FAULT_LATENCY_t fault_latency;
+
+/* PROTOTYPES */
+extern volatile uint16_t os_FaultLatency_Initialize(void);
+extern volatile uint16_t ClearFaultLatencyStatistics(void);
+extern volatile uint16_t CaptureFaultLatencyEvent(volatile FAULT_OBJECT_t* fltobj, volatile FAULT_LATENCY_EVENT_e event);
+extern volatile uint16_t SetFaultLatencyViolation(volatile FAULT_OBJECT_t* fltobj, volatile uint32_t timestamp);
+extern volatile uint16_t CaptureFaultLatencyQueueEntry(void);
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* _ROOT_FUNCTION_DRIVER_FAULT_LATENCY_H_ */
+
@@ -0,0 +1,111 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * File:   fdrv_FaultLog.h
+ * Author: M91406
+ * Comments: Fault handler function driver header file of the persistent fault history log
+ * Revision history:
+ * 1.0  Initial release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef _ROOT_FUNCTION_DRIVER_FAULT_LOG_H_
+#define	_ROOT_FUNCTION_DRIVER_FAULT_LOG_H_
+
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "_root/config/task_manager_config.h"
+#include "fdrv_FaultHandler.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!FAULT_LOG_ENTRY_t
+ * ***********************************************************************************************
+ * Description:
+ * Every fault trip event is recorded in one FAULT_LOG_ENTRY_t record. Time stamps and time-in-
+ * fault are given in number of task manager master periods (see TASK_MGR_MASTER_PACE). The boot
+ * counter identifies the CPU start after which the event was recorded, as the system time stamp
+ * counter restarts at zero after every CPU reset.
+ *
+ * time_in_fault is set to FAULT_LOG_TIME_OPEN while the fault condition is still present.
+ *
+ * Please note:
+ * The data layout must match the record definition in tools/fault_log_decoder.py
+ * ***********************************************************************************************/
+
+#define FAULT_LOG_SIGNATURE     0xFA17      // Signature indicating valid persistent log contents
+#define FAULT_LOG_TIME_OPEN     0xFFFFFFFF  // Time-in-fault value of records of active faults
+#define FAULT_LOG_INDEX_NONE    0xFFFF      // Open record index value if no record is open
+
+typedef struct {
+    volatile uint16_t fault_id; // ID of the fault object which has tripped
+    volatile uint8_t op_mode; // operating mode at the time of the trip event
+    volatile uint8_t task_id; // ID of the most recent task at the time of the trip event
+    volatile uint16_t boot_count; // Boot counter value at the time of the trip event
+    volatile uint32_t timestamp; // System time stamp of the trip event
+    volatile uint32_t source_value; // Value of the monitored source object at the time of the trip event
+    volatile uint32_t time_in_fault; // Period between trip and release event
+} FAULT_LOG_ENTRY_t;
+
+/*!FAULT_LOG_t
+ * ***********************************************************************************************
+ * Description:
+ * The persistent fault log holds a fixed-size ring buffer of fault event records as well as
+ * occurrence statistics of each fault object ID. The log is only cleared at power-up or when
+ * its signature has been corrupted.
+ *
+ * All write operations to the log have constant execution time and do not contain any loops
+ * to prevent logging from extending fault response times.
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint16_t signature; // Signature indicating a valid log (FAULT_LOG_SIGNATURE)
+    volatile uint16_t signature_inv; // Inverted signature
+    volatile uint16_t index; // Index of the next record to be written
+    volatile uint16_t event_count; // Total number of recorded events (saturating)
+    volatile uint16_t boot_count; // Number of CPU starts since the log has been cleared
+    volatile FAULT_LOG_ENTRY_t entry[FAULT_LOG_SIZE]; // Fault event ring buffer
+    volatile uint16_t trip_count[FAULT_LOG_OBJECT_COUNT]; // Number of trip events per fault object ID (saturating)
+    volatile uint32_t fault_time[FAULT_LOG_OBJECT_COUNT]; // Accumulated time-in-fault per fault object ID (saturating)
+    volatile uint16_t open_entry[FAULT_LOG_OBJECT_COUNT]; // Record index of currently active faults per fault object ID
+} FAULT_LOG_t;
+
+extern volatile FAULT_LOG_t __attribute__((__persistent__)) fault_log;
+
+/* PROTOTYPES */
+extern volatile uint16_t os_FaultLog_Initialize(void);
+extern volatile uint16_t ClearFaultLog(void);
+extern volatile uint16_t CaptureFaultLogEntry(volatile FAULT_OBJECT_t* fltobj);
+extern volatile uint16_t ReleaseFaultLogEntry(volatile FAULT_OBJECT_t* fltobj);
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* _ROOT_FUNCTION_DRIVER_FAULT_LOG_H_ */
+
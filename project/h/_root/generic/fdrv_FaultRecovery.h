@@ -0,0 +1,124 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * File:   fdrv_FaultRecovery.h
+ * Author: M91406
+ * Comments: Fault handler function driver header file of the staged fault recovery engine
+ * Revision history:
+ * 1.0  Initial release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef _ROOT_FUNCTION_DRIVER_FAULT_RECOVERY_H_
+#define	_ROOT_FUNCTION_DRIVER_FAULT_RECOVERY_H_
+
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "_root/config/task_manager_config.h"
+#include "fdrv_FaultHandler.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!FAULT_RECOVERY_STATE_e
+ * ***********************************************************************************************
+ * Description:
+ * States of the fault recovery engine:
+ *
+ *     - FLTREC_STATE_STANDBY:
+ *       No fault recovery in progress
+ *
+ *     - FLTREC_STATE_FAULT:
+ *       The task manager is in fault mode, waiting for all fault conditions to be cleared
+ *
+ *     - FLTREC_STATE_COOL_DOWN:
+ *       All fault conditions have been cleared. The system remains in fault mode for the cool-down
+ *       period, which is doubled with every restart attempt within the retry window (backoff).
+ *       If a fault condition reappears, the engine returns to FLTREC_STATE_FAULT.
+ *
+ *     - FLTREC_STATE_STAGED_ENABLE:
+ *       The startup sequence has been launched with all fault groups listed in
+ *       user_fault_recovery_stages[] masked. The groups are unmasked stage by stage, one stage
+ *       per stage delay period.
+ *
+ *     - FLTREC_STATE_LOCKOUT:
+ *       The maximum number of restart attempts within the retry window has been exceeded. The
+ *       system remains in fault mode until the user application calls ClearFaultRecoveryLockout()
+ *       or the recovery engine is re-initialized by a CPU reset or warm restart.
+ *
+ * ***********************************************************************************************/
+
+typedef enum {
+    FLTREC_STATE_STANDBY        = 0b0000000000000000, // No fault recovery in progress
+    FLTREC_STATE_FAULT          = 0b0000000000000001, // Waiting for fault conditions to clear
+    FLTREC_STATE_COOL_DOWN      = 0b0000000000000010, // Waiting for cool-down period to expire
+    FLTREC_STATE_STAGED_ENABLE  = 0b0000000000000011, // Re-enabling fault groups stage by stage
+    FLTREC_STATE_LOCKOUT        = 0b0000000000000100  // Permanent lockout after too many restart attempts
+}FAULT_RECOVERY_STATE_e;
+
+/*!FAULT_RECOVERY_t
+ * ***********************************************************************************************
+ * Description:
+ * Status of the fault recovery engine. All time stamps and periods are given in number of task
+ * manager master periods (system tick counter).
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint16_t state; // State of the recovery engine (FAULT_RECOVERY_STATE_e)
+    volatile uint16_t stage; // Index of the next recovery stage to be re-enabled
+    volatile uint16_t attempts; // Number of restart attempts within the recent retry window
+    volatile uint16_t lockout_count; // Number of lockout events since CPU start (saturating)
+    volatile uint32_t timestamp; // Time stamp of the most recent state transition or stage
+    volatile uint32_t window_start; // Time stamp of the first restart attempt of the recent retry window
+    volatile uint32_t cool_down; // Cool-down period of the recent recovery incl. backoff
+} FAULT_RECOVERY_t;
+
+extern volatile FAULT_RECOVERY_t fault_recovery;
+
+/*!user_fault_recovery_stages[]
+ * ***********************************************************************************************
+ * Description:
+ * List of fault group masks (see FAULT_GROUP_e) re-enabled stage by stage after a restart from
+ * fault mode. All listed groups are masked when the startup sequence is launched. The first
+ * stage is unmasked after one stage delay, the next stage after another stage delay, etc.
+ * This list is defined in the user configuration (UserFaultObjects.c).
+ * ***********************************************************************************************/
+
+extern volatile uint16_t user_fault_recovery_stages[];
+extern volatile uint16_t user_fault_recovery_stages_size;
+
+/* PROTOTYPES */
+extern volatile uint16_t os_FaultRecovery_Initialize(void);
+extern volatile uint16_t exec_FaultRecovery(void);
+extern volatile uint16_t ClearFaultRecoveryLockout(void);
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* _ROOT_FUNCTION_DRIVER_FAULT_RECOVERY_H_ */
+
@@ -0,0 +1,157 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * File:   fdrv_FaultRegistry.h
+ * Author: M91406
+ * Comments: Fault handler function driver header file of the fault object registry
+ * Revision history:
+ * 1.0  Initial release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef _ROOT_FUNCTION_DRIVER_FAULT_REGISTRY_H_
+#define	_ROOT_FUNCTION_DRIVER_FAULT_REGISTRY_H_
+
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+#include <stddef.h> // include standard definition types header file
+
+#include "_root/config/task_manager_config.h"
+#include "fdrv_FaultHandler.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!FAULT_REGISTRY_t
+ * ***********************************************************************************************
+ * Description:
+ * The fault registry holds pointers to all fault objects indexed by their fault object ID, which
+ * allows constant-time access to any fault object by its ID. Additionally, the fault group
+ * membership of each fault object (see FAULT_GROUP_e) is kept in the registry.
+ *
+ * Groups are masked by setting their bits in groups_disabled, which is a single word write.
+ * The fault handler skips the fault condition checks of all fault objects of masked groups.
+ * Objects of masked groups are neither checked, nor do they execute their release functions.
+ * Their latched fault status is frozen while masked and still contributes to the global fault
+ * flags, so masking a fault group can never clear an active global fault. Fault objects without
+ * group membership (FLTGRP_NONE) cannot be masked.
+ *
+ * The registry is built by os_FaultObjects_Initialize() from os_fault_object_list[] and
+ * user_fault_object_list[]. Fault object IDs must be unique and less than FAULT_REGISTRY_SIZE.
+ * If any fault object cannot be registered (ID out of range or already in use), the registry
+ * falls back to list scan mode, where the fault handler walks both fault object lists instead
+ * of the registry. This ensures that no fault object is silently excluded from fault checks. 
+ * Initialization still reports the failure.
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint16_t groups_disabled; // Bit mask of masked fault groups (FAULT_GROUP_e)
+    volatile uint16_t size; // Highest registered fault object ID + 1
+    volatile uint16_t scan_size; // Number of scan positions walked by the fault handler
+    volatile bool list_scan; // Fault object lists are scanned instead of the registry (registration failed)
+    volatile FAULT_OBJECT_t* object[FAULT_REGISTRY_SIZE]; // Fault objects indexed by fault object ID
+    volatile uint16_t groups[FAULT_REGISTRY_SIZE]; // Fault group membership indexed by fault object ID
+} FAULT_REGISTRY_t;
+
+extern volatile FAULT_REGISTRY_t fault_registry;
+
+/* PROTOTYPES */
+extern volatile uint16_t os_FaultRegistry_Initialize(void);
+extern volatile uint16_t RegisterFaultObject(volatile FAULT_OBJECT_t* fltobj);
+extern volatile FAULT_OBJECT_t* GetFaultObject(volatile uint16_t id);
+extern volatile uint16_t SetFaultObjectEnable(volatile uint16_t id, volatile bool enable);
+extern volatile uint16_t SetFaultObjectGroups(volatile uint16_t id, volatile uint16_t groups);
+extern volatile uint16_t DisableFaultGroups(volatile uint16_t groups);
+extern volatile uint16_t EnableFaultGroups(volatile uint16_t groups);
+
+/*!GetFaultScanObject
+ * ***********************************************************************************************
+ * Parameters:
+ *      uint16_t index: Scan position (0 ... fault_registry.scan_size-1)
+ *
+ * Return:
+ *      type: FAULT_OBJECT_t*
+ *      NULL: empty registry slot
+ *      else: pointer to the fault object
+ *
+ * Description:
+ * Returns the fault object at the given scan position of the fault handler regardless of its
+ * fault group membership. In registry mode, scan positions are fault object IDs. In list scan 
+ * mode, scan positions run through os_fault_object_list[] followed by user_fault_object_list[].
+ * ***********************************************************************************************/
+
+static inline volatile FAULT_OBJECT_t* GetFaultScanObject(volatile uint16_t index)
+{
+    if(!fault_registry.list_scan)
+    { return(fault_registry.object[index]); }
+
+    if(index < os_fltobj_list_size) 
+    { return(os_fault_object_list[index]); }
+    else
+    { return(user_fault_object_list[index - os_fltobj_list_size]); }
+}
+
+/*!GetFaultCheckObject
+ * ***********************************************************************************************
+ * Parameters:
+ *      uint16_t index: Scan position (0 ... fault_registry.scan_size-1)
+ *
+ * Return:
+ *      type: FAULT_OBJECT_t*
+ *      NULL: empty registry slot or fault object of a masked fault group
+ *      else: pointer to the fault object
+ *
+ * Description:
+ * Returns the fault object at the given scan position of the fault handler. In registry mode,
+ * scan positions are fault object IDs. In list scan mode, scan positions run through 
+ * os_fault_object_list[] followed by user_fault_object_list[].
+ * ***********************************************************************************************/
+
+static inline volatile FAULT_OBJECT_t* GetFaultCheckObject(volatile uint16_t index)
+{
+    volatile FAULT_OBJECT_t* fltobj;
+    
+    if(!fault_registry.list_scan)
+    {
+        if(fault_registry.groups[index] & fault_registry.groups_disabled) { return(NULL); }
+        return(fault_registry.object[index]);
+    }
+
+    if(index < os_fltobj_list_size) 
+    { fltobj = os_fault_object_list[index]; }
+    else
+    { fltobj = user_fault_object_list[index - os_fltobj_list_size]; }
+    
+    if((fltobj == NULL) || (fltobj->groups & fault_registry.groups_disabled)) { return(NULL); }
+    return(fltobj);
+}
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* _ROOT_FUNCTION_DRIVER_FAULT_REGISTRY_H_ */
+
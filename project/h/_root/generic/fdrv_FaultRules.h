@@ -0,0 +1,173 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * File:   fdrv_FaultRules.h
+ * Author: M91406
+ * Comments: Fault handler function driver header file of the composite fault rule interpreter
+ * Revision history:
+ * 1.0  Initial release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef _ROOT_FUNCTION_DRIVER_FAULT_RULES_H_
+#define	_ROOT_FUNCTION_DRIVER_FAULT_RULES_H_
+
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!Fault Rule Settings
+ * ***********************************************************************************************
+ * Description:
+ * Composite fault rules combine states of fault objects, operating modes and timers into one
+ * boolean result. Rules are written in a small rule language and compiled into a compact
+ * bytecode by the host tool tools/fault_rule_compiler.py.
+ *
+ *     - FLTRULE_PROGRAM_SIZE_MAX:
+ *       Maximum number of 16-bit instruction words per rule. This setting limits the worst
+ *       case execution time of every rule evaluation
+ *
+ *     - FLTRULE_TIMER_COUNT:
+ *       Number of on-/off-delay timers available per rule
+ *
+ *     - FLTRULE_STACK_DEPTH:
+ *       The interpreter uses a 16-bit wide single-bit stack. Rules cannot nest deeper than
+ *       16 operands.
+ *
+ * ***********************************************************************************************/
+
+#define FLTRULE_PROGRAM_SIZE_MAX    32  // Maximum number of instruction words per rule
+#define FLTRULE_TIMER_COUNT         4   // Number of timers per rule
+#define FLTRULE_STACK_DEPTH         16  // Depth of the interpreter bit-stack (do not change)
+
+/*!FAULT_RULE_OPCODE_e
+ * ***********************************************************************************************
+ * Description:
+ * Every rule instruction is a 16-bit word. The high-byte holds the operation code, the low-byte
+ * holds the operand. Timer instructions are followed by one additional word holding the timer
+ * preset in number of fault handler execution cycles.
+ *
+ * Fault objects are addressed by their index in the fault object list. Bit #7 of the operand
+ * selects the list (0 = os_fault_object_list[], 1 = user_fault_object_list[]).
+ *
+ * Please note:
+ * Opcodes and encoding must match the definitions in tools/fault_rule_compiler.py
+ * ***********************************************************************************************/
+
+typedef enum {
+    FLTRULE_OP_END      = 0x00, // End of rule (optional, program length is also limited by list size)
+    FLTRULE_OP_ACTIVE   = 0x01, // Push fault_active flag of fault object <operand>
+    FLTRULE_OP_STATUS   = 0x02, // Push fault_status flag of fault object <operand>
+    FLTRULE_OP_OPMODE   = 0x03, // Push 1 if task manager op_mode matches bit-mask <operand>
+    FLTRULE_OP_CONST    = 0x04, // Push constant <operand> (0 or 1)
+    FLTRULE_OP_NOT      = 0x10, // Invert top of stack
+    FLTRULE_OP_AND      = 0x11, // Pop two values, push logic AND
+    FLTRULE_OP_OR       = 0x12, // Pop two values, push logic OR
+    FLTRULE_OP_XOR      = 0x13, // Pop two values, push logic XOR
+    FLTRULE_OP_ATLEAST  = 0x14, // Pop n=<operand[3:0]> values, push 1 if at least k=<operand[7:4]> are true
+    FLTRULE_OP_ON_DELAY = 0x20, // Timer <operand>: top of stack is true for at least <preset> cycles
+    FLTRULE_OP_OFF_DELAY= 0x21  // Timer <operand>: top of stack has been true within the past <preset> cycles
+} FAULT_RULE_OPCODE_e;
+
+#define FLTRULE_OPERAND_USER_LIST   0x0080  // Operand bit selecting the user fault object list
+#define FLTRULE_OPERAND_INDEX_MASK  0x007F  // Operand bit-mask of the fault object list index
+
+/*!FAULT_RULE_STATUS_t
+ * ***********************************************************************************************
+ * Description:
+ * FAULT_RULE_STATUS_t holds the recent rule result as well as enable and error flags. Bit #0
+ * holds the rule result and can be monitored by a common fault object using
+ * compare type FAULT_LEVEL_BOOLEAN and source bit mask FLTRULE_STATUS_RESULT. Thus composite
+ * rules inherit fault classes, counter filters and user responses of the fault handler.
+ * ***********************************************************************************************/
+
+typedef enum {
+    FLTRULE_STATUS_RESULT   = 0b0000000000000001, // Rule result bit-mask
+    FLTRULE_STATUS_ERROR    = 0b0100000000000000, // Rule validation error bit-mask
+    FLTRULE_STATUS_ENABLED  = 0b1000000000000000  // Rule enable bit-mask
+} FAULT_RULE_STATUS_e;
+
+typedef union
+{
+    struct {
+        volatile bool result :1;    // Bit #0:  Result of the most recent rule evaluation
+        volatile unsigned :1;	// Bit #1:  Reserved
+        volatile unsigned :1;	// Bit #2:  Reserved
+        volatile unsigned :1;	// Bit #3:  Reserved
+        volatile unsigned :1;	// Bit #4:  Reserved
+        volatile unsigned :1;	// Bit #5:  Reserved
+        volatile unsigned :1;	// Bit #6:  Reserved
+        volatile unsigned :1;	// Bit #7:  Reserved
+        volatile unsigned :1;	// Bit #8:  Reserved
+        volatile unsigned :1;	// Bit #9:  Reserved
+        volatile unsigned :1;	// Bit #10: Reserved
+        volatile unsigned :1;	// Bit #11: Reserved
+        volatile unsigned :1;	// Bit #12: Reserved
+        volatile unsigned :1;	// Bit #13: Reserved
+        volatile bool error   :1;   // Bit #14: Flag bit indicating the rule program failed validation
+        volatile bool enabled :1;   // Bit #15: Rule evaluation enable/disable flag bit
+    }__attribute__((packed))bits;
+	volatile uint16_t value; // buffer for 16-bit word read/write operations
+}FAULT_RULE_STATUS_t;
+
+/*!FAULT_RULE_t
+ * ***********************************************************************************************
+ * Description:
+ * The fault rule object FAULT_RULE_t points to a constant bytecode program generated by the
+ * host tool and holds the run-time state (timers and result) of this rule.
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint16_t id; // identifier of this fault rule
+    volatile FAULT_RULE_STATUS_t status; // status bit field holding the rule result
+    const uint16_t* program; // pointer to the bytecode program of this rule
+    volatile uint16_t length; // number of 16-bit words of the bytecode program
+    volatile uint16_t timer[FLTRULE_TIMER_COUNT]; // on-/off-delay timer counters
+} FAULT_RULE_t;
+
+/*!user_fault_rule_list[]
+ * ***********************************************************************************************
+ * Description:
+ * The user_fault_rule_list[] array is a list of all composite fault rules defined for this
+ * project. Rules are evaluated in list order at the beginning of every fault check cycle.
+ * ***********************************************************************************************/
+
+extern volatile FAULT_RULE_t *user_fault_rule_list[];
+extern volatile uint16_t user_fltrule_list_size;
+
+/* PROTOTYPES */
+extern volatile uint16_t os_FaultRules_Initialize(void);
+extern volatile uint16_t exec_FaultRulesAll(void);
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* _ROOT_FUNCTION_DRIVER_FAULT_RULES_H_ */
+
@@ -59,6 +59,8 @@
 #include <xc.h> // include processor files - each processor file is guarded.  
 #include <stdint.h> // include standard integer types header file
 #include <stdbool.h> // include standard boolean types header file
+
+#include "_root/config/task_manager_config.h"
 		
 // =================================================================================================
 //
@@ -212,7 +214,7 @@ typedef union {
 
         // Status bits
         volatile bool sw_reset : 1;             // Bit 8:  Flag indicating CPU was reset by software (read only)
-        volatile unsigned : 1;                  // Bit 9:  (reserved)
+        volatile bool crash_record_new : 1;     // Bit 9:  Flag indicating a crash record which has not been evaluated after a CPU reset (read only)
         volatile unsigned : 1;                  // Bit 10: (reserved)
         volatile unsigned : 1;                  // Bit 11: (reserved)
         volatile unsigned : 1;                  // Bit 12: (reserved)
@@ -249,6 +251,9 @@ typedef struct {
 	volatile CPU_RCON_t rcon_reg;       // Captures the RESET CONTROL register
     volatile CPU_INTTREG_t inttreg;     // Interrupt Vector and Priority register capture
     volatile TASK_INFO_t task_capture;  // Information of last task executed
+    volatile uint16_t reset_rate;       // Decaying CPU reset rate counter (8.8 fixed point, 256 = one reset)
+    volatile uint16_t restart_profile;  // Restart profile selected after the most recent CPU reset (CPU_RESTART_PROFILE_e)
+    volatile uint16_t boot_trap_count;  // Trap counter value captured after the most recent CPU reset
     
 }TRAP_LOGGER_t; // Global data structure for trap event capturing
 
@@ -257,6 +262,47 @@ typedef struct {
 // Global data structure used as buffer for trap monitoring
 extern volatile TRAP_LOGGER_t __attribute__((__persistent__))traplog; 
 
+// =================================================================================================
+//
+//	GLOBAL DATA STRUCTURE - TRAP CRASH RECORD
+//
+// =================================================================================================
+//
+// The working registers, SR, CORCON and the exception frame are saved by assembly code emitted
+// before the compiler-generated prologue of each trap service routine (see TRAP_CRASH_CAPTURE
+// in fdrv_TrapHandler.c). This code addresses the data fields by fixed byte offsets. Do not
+// change the order of the fields w_reg[] to pc_high.
+//
+// The program counter of the exception frame is composed of pc_low (PC<15:0>) and
+// pc_high<6:0> (PC<22:16>). pc_high<15:8> holds the lower byte of the status register (SRL)
+// and pc_high<7> the IPL3 bit of the interrupted code.
+//
+// =================================================================================================
+
+#define TRAP_CRASH_RECORD_SIGNATURE     0xDEAD  // Crash record signature (valid record)
+
+typedef struct {
+
+    volatile uint16_t w_reg[16];    // Offset  0: Working registers W0-W15 at trap entry (W15 incl. exception frame)
+    volatile uint16_t sr;           // Offset 32: Status register at trap entry
+    volatile uint16_t corcon;       // Offset 34: Core control register at trap entry
+    volatile uint16_t pc_low;       // Offset 36: Exception frame PC<15:0>
+    volatile uint16_t pc_high;      // Offset 38: Exception frame SRL<7:0>, IPL3, PC<22:16>
+    volatile uint16_t signature;    // Crash record signature (TRAP_CRASH_RECORD_SIGNATURE = valid)
+    volatile uint16_t trap_id;      // Trap-ID of the captured incident (TRAP_ID_e)
+    volatile uint16_t task_id;      // Task ID of the task executed when the trap occurred
+    volatile uint16_t op_mode;      // Operating Mode ID of the task manager when the trap occurred
+    volatile uint16_t stack_count;  // Number of valid stack words
+    volatile uint16_t stack[TRAP_CRASH_STACK_DEPTH]; // Topmost stack words below the exception frame (most recent first)
+    volatile uint16_t checksum;     // Inverted 16-bit sum of all preceding words
+
+}TRAP_CRASH_RECORD_t; // Global data structure for crash record capturing
+
+// Global data structure holding the crash record of the most recent trap
+#if (USE_TRAP_CRASH_RECORD == 1)
+extern volatile TRAP_CRASH_RECORD_t __attribute__((__persistent__))crashlog;
+#endif
+
 // =================================================================================================
 //
 //	PROTOTYPES
@@ -0,0 +1,132 @@
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ */
+
+/*
+ * File:   os_BootProfiler.h
+ * Author: M91406
+ * Comments: Header file of the OS startup-time profiler
+ * Revision history:
+ * 1.0  Initial release
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.
+#ifndef _ROOT_OS_BOOT_PROFILER_H_
+#define	_ROOT_OS_BOOT_PROFILER_H_
+
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "_root/config/task_manager_config.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*!BOOT_PHASE_e
+ * ***********************************************************************************************
+ * Description:
+ * Startup phases measured by the boot profiler in order of execution:
+ *
+ *     - BOOT_PHASE_RESET_CAUSE: entry of OS_Execute() => reset root cause evaluated
+ *     - BOOT_PHASE_DEVICE_RESET: GPIO/PMD reset and user startup code
+ *     - BOOT_PHASE_CLOCK_SWITCH: main oscillator switch-over incl. PLL lock wait
+ *     - BOOT_PHASE_CLOCK_AUX: auxiliary PLL lock wait and OS timer setup
+ *     - BOOT_PHASE_DEVICE_INIT: CPU/DSP, interrupt controller and GPIO initialization
+ *     - BOOT_PHASE_OS_INIT: task manager and fault object initialization
+ *     - BOOT_PHASE_BOOT_QUEUE: scheduler start => end of BOOT task queue
+ *     - BOOT_PHASE_FIRMWARE_INIT: FIRMWARE_INIT task queue
+ *     - BOOT_PHASE_STARTUP_SEQUENCE: STARTUP_SEQUENCE task queue
+ *     - BOOT_PHASE_FIRST_RUN: IDLE task queue => first RUN task queue tick
+ *
+ * Phases which are not executed in the recent configuration (e.g. when using MCC generated
+ * initialization code) are reported with zero duration.
+ * ***********************************************************************************************/
+
+typedef enum {
+    BOOT_PHASE_RESET_CAUSE       = 0, // Reset root cause evaluation
+    BOOT_PHASE_DEVICE_RESET      = 1, // Device reset and user startup code
+    BOOT_PHASE_CLOCK_SWITCH      = 2, // Main oscillator switch-over and PLL lock
+    BOOT_PHASE_CLOCK_AUX         = 3, // Auxiliary PLL lock and OS timer setup
+    BOOT_PHASE_DEVICE_INIT       = 4, // CPU/DSP, interrupt controller and GPIO initialization
+    BOOT_PHASE_OS_INIT           = 5, // Task manager and fault object initialization
+    BOOT_PHASE_BOOT_QUEUE        = 6, // BOOT task queue
+    BOOT_PHASE_FIRMWARE_INIT     = 7, // FIRMWARE_INIT task queue
+    BOOT_PHASE_STARTUP_SEQUENCE  = 8, // STARTUP_SEQUENCE task queue
+    BOOT_PHASE_FIRST_RUN         = 9  // IDLE until first RUN tick
+}BOOT_PHASE_e;
+
+#define BOOT_PHASE_COUNT            10      // Number of measured startup phases
+#define BOOT_PHASE_NONE             0xFFFF  // Phase index value if no phase has been interrupted
+
+#define BOOT_REPORT_SIGNATURE       0xB007  // Signature indicating valid persistent boot report contents
+#define BOOT_PROFILER_FRC_FCY       (CLOCK_FRC_FREQUENCY / 2UL) // Instruction frequency in [Hz] when running from the internal FRC oscillator
+
+/*!BOOT_REPORT_t
+ * ***********************************************************************************************
+ * Description:
+ * The persistent boot report holds the duration of each startup phase of the most recent boot in
+ * CPU instruction cycles and in microseconds. Phases before the scheduler starts are measured by 
+ * the Dead Man Timer (DMT) counter, which counts instruction cycles from the entry of OS_Execute(), 
+ * all subsequent phases by the task manager timer. The instruction cycles of each phase are 
+ * converted into microseconds using the instruction frequency of the oscillator the phase has 
+ * started on.
+ * 
+ * If the previous boot did not complete (e.g. CPU reset during startup), the interrupted phase is 
+ * kept in aborted_phase. The report is only cleared at power-up or when its signature has been 
+ * corrupted.
+ *
+ * Please note:
+ * The data layout must match the record definition in tools/boot_report_decoder.py
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint32_t cycles; // Phase duration in CPU instruction cycles
+    volatile uint32_t duration; // Phase duration in [us]
+    volatile uint16_t clock; // Oscillator source (OSCCON.COSC) the phase has been started on
+} BOOT_PHASE_RECORD_t;
+
+typedef struct {
+    volatile uint16_t signature; // Signature indicating a valid report (BOOT_REPORT_SIGNATURE)
+    volatile uint16_t signature_inv; // Inverted signature
+    volatile uint16_t boot_count; // Number of CPU starts since the report has been cleared
+    volatile uint16_t phase_index; // Index of the next phase to be captured (BOOT_PHASE_COUNT = boot complete)
+    volatile uint16_t aborted_phase; // Phase in which the previous boot was interrupted (BOOT_PHASE_NONE = completed)
+    volatile uint16_t restart_profile; // Restart profile selected by CheckCPUResetRootCause() (see CPU_RESTART_PROFILE_e)
+    volatile uint32_t total_duration; // Total startup time of all completed phases in [us]
+    volatile BOOT_PHASE_RECORD_t phase[BOOT_PHASE_COUNT]; // Startup phase records
+} BOOT_REPORT_t;
+
+extern volatile BOOT_REPORT_t __attribute__((__persistent__)) boot_report;
+
+/* PROTOTYPES */
+extern volatile uint16_t os_BootProfiler_Initialize(void);
+extern volatile uint16_t ClearBootReport(void);
+extern volatile uint16_t CaptureBootPhase(volatile BOOT_PHASE_e phase);
+
+
+#ifdef	__cplusplus
+}
+#endif /* __cplusplus */
+
+#endif	/* _ROOT_OS_BOOT_PROFILER_H_ */
+
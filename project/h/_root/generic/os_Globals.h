@@ -50,10 +50,17 @@
 
 #include "fdrv_FaultHandler.h"
 #include "fdrv_FaultObjects.h"
+#include "fdrv_FaultRegistry.h"
+#include "fdrv_FaultLog.h"
+#include "fdrv_FaultLatency.h"
+#include "fdrv_FaultFastPath.h"
+#include "fdrv_FaultRecovery.h"
+#include "fdrv_FaultRules.h"
 #include "fdrv_TrapHandler.h"
 #include "os_Initialize.h"
 #include "os_TaskManager.h"
 #include "os_Scheduler.h"
+#include "os_BootProfiler.h"
 
 /* ***********************************************************************************************
  * PROJECT SPECIFIC INCLUDES
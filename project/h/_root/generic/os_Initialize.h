@@ -32,12 +32,32 @@
 #define	_ROOT_OS_INITIALIZER_H_
 
 #include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "_root/config/task_manager_config.h"
 
 
 #ifdef	__cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+/*!OS_WARM_RESTART_t
+ * ***********************************************************************************************
+ * Description:
+ * Reference values captured after the cold start, which are used to validate a warm restart of
+ * the scheduler without CPU reset (see USE_WARM_RESTART).
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint16_t config_checksum; // Checksum of clock and OS timer configuration captured after cold start
+    volatile uint16_t trap_count; // Trap counter of the traplog object captured after cold start
+    volatile uint16_t warm_restarts; // Number of warm restarts since cold start
+    volatile uint16_t adc_core_enable; // ADC core enable bits (ADCON3H) disabled by OS_WarmRestartSafeState()
+} OS_WARM_RESTART_t;
+
+extern volatile OS_WARM_RESTART_t os_warm_restart;
+
 /* ***********************************************************************************************
  * PROTOTYPES
  * ***********************************************************************************************/
@@ -54,6 +74,13 @@ extern volatile uint16_t CLOCK_Initialize(void);     // Declare prototype if MCC
 
 extern volatile uint16_t DEVICE_Initialize(void);
 
+#if (USE_WARM_RESTART == 1)
+extern volatile uint16_t OS_GetConfigChecksum(void);
+extern volatile uint16_t OS_CaptureWarmRestartConfig(void);
+extern volatile uint16_t OS_WarmRestartSafeState(void);
+extern volatile bool OS_WarmRestart(void);
+#endif
+
 #ifdef	__cplusplus
 }
 #endif /* __cplusplus */
@@ -98,6 +98,8 @@ typedef enum {
     EXEC_STAT_TSKMGR_PER_OVR        = 0b0000000000001000, // Task manager base timer period overrun flag bit
     EXEC_STAT_RESCUE_TMR_OVR        = 0b0000000000010000, // Rescue timer period overrun flag bit
     EXEC_STAT_OS_COMP_CHECK         = 0b0000000000100000, // Task manager internal component check flag bit
+    EXEC_STAT_DEGRADED_MODE         = 0b0000000001000000, // System has been restarted in degraded mode
+    EXEC_STAT_INIT_PENDING          = 0b0000000010000000, // Peripheral initialization sequences are pending
         
     EXEC_STAT_NOTIFICATION_PENDING  = 0b0010000000000000, // Some condition raised a notification flag
     EXEC_STAT_WARNING_PENDING       = 0b0100000000000000, // Some condition raised a warning flag
@@ -112,8 +114,8 @@ typedef union  {
         volatile bool task_mgr_period_overrun :1; // Bit #3:  Flag bit indicating task manager base time has overrun before an execution period was complete
         volatile bool rescue_timer_overrun :1; // Bit #4: Flag bit indicating that the RESCUE TIMER has killed a task
         volatile bool os_component_check :1; // Bit #5: OS component function return value validation (0=failure, 1=success)
-        volatile unsigned :1; // Bit #6:  (reserved)
-        volatile unsigned :1; // Bit #7:  (reserved)
+        volatile bool degraded_mode :1; // Bit #6: Flag bit indicating that the system has been restarted in degraded mode (see CPU_RESTART_PROFILE_e)
+        volatile bool init_pending :1; // Bit #7: Flag bit indicating that peripheral initialization sequences are pending (see USE_NONBLOCKING_PERIPHERAL_INIT)
 
         volatile unsigned :1; // Bit #8:  (reserved)
         volatile unsigned :1; // Bit #9:  (reserved)
@@ -170,9 +172,12 @@ typedef struct {
         volatile uint16_t index; // specifies the timer used for the task manager (e.g. 1 for Timer1)
         volatile uint16_t *reg_period; // Pointer to Timer period register (e.g. PR1)
         volatile uint16_t *reg_counter; // Pointer to Timer counter register (e.g. TMR1))
+        volatile uint16_t *reg_isr_flag; // Pointer to Timer interrupt flag register (e.g. IFS0)
+        volatile uint16_t isr_flag_mask; // Timer interrupt flag bit mask within the interrupt flag register
         volatile uint16_t master_period; // Task manager/OS Master Period (basic OS pace tick period)
         volatile uint16_t rescue_period; // Rescue timer period (maximum period after which stalled tasks should be killed)
         volatile uint16_t task_period_max; // Logging buffer variable of longest task execution period
+        volatile uint32_t tick_counter; // System time stamp counter (number of master periods since OS start)
     } os_timer; // Operating system base timer settings
     
 } TASK_MANAGER_t;
@@ -187,6 +192,7 @@ extern volatile uint16_t os_TaskManager_Initialize(void);
 
 extern volatile uint16_t os_ProcessTaskQueue(void);
 extern volatile uint16_t os_CheckOperationModeStatus(void);
+extern volatile uint32_t os_GetSystemTimestamp(void);
 
 extern volatile uint16_t task_Idle(void);
 
@@ -49,7 +49,8 @@ typedef enum {
         
     FLTOBJ_POWER_SOURCE_FAILURE, // Input voltage is out of range preventing DC/DC converters to run
     FLTOBJ_POWER_CONTROL_FAILURE_PORT_A, // A critical fault was detected in DC/DC converter of port A
-    FLTOBJ_POWER_CONTROL_FAILURE_PORT_B // A critical fault was detected in DC/DC converter of port B
+    FLTOBJ_POWER_CONTROL_FAILURE_PORT_B, // A critical fault was detected in DC/DC converter of port B
+    FLTOBJ_MY_FAULT_OBJECT // Template of a user-defined fault object (see UserFaultObjects.c)
 //    FLTOBJ_SOFT_START, // Fault object Soft-Start Failure
         
 //    FLTOBJ_UVLO, // Fault object Under Voltage Lock-Out
@@ -138,6 +138,7 @@ typedef enum {
     
     // Cross-function modules
     TASK_INIT_APPLICATION, // Task initializing system-wide application data structure
+    TASK_INIT_SEQUENCES, // Task advancing non-blocking peripheral initialization sequences
 
     /* ===== USER FUNCTIONS LIST ===== */
 
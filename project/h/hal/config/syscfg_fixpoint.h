@@ -0,0 +1,96 @@
+/*!syscfg_fixpoint.h
+ * ****************************************************************************
+ * File:   syscfg_fixpoint.h
+ *
+ * Description:
+ * Fixed-point scaling constants generated by tools/fixed_point_scaling.py
+ * from syscfg_fixpoint.txt. Do not edit manually.
+ *
+ * Each define is followed by the exact value of its design expression and the
+ * quantization error in LSB and percent. Q15 factors are applied by
+ * (x * <factor>) >> (15 - <factor>_BSFT) (see hal_scaling.h).
+ ******************************************************************************/
+
+#ifndef _HARDWARE_ABSTRACTION_LAYER_SYSTEM_FIXPOINT_H_
+#define	_HARDWARE_ABSTRACTION_LAYER_SYSTEM_FIXPOINT_H_
+
+#define C4SWBB_VOUT_OFFSET            0u         // 0 (+0.000 LSB, 0.000 %)
+#define C4SWBB_VOUT_REF               853u       // 853.445 (-0.445 LSB, 0.052 %)
+#define C4SWBB_VOUT_OVP               3584u      // 3584.47 (-0.468 LSB, 0.013 %)
+#define C4SWBB_VOUT_HYST              171u       // 170.689 (+0.311 LSB, 0.182 %)
+#define C4SWBB_VOUT_UDEVI             341u       // 341.378 (-0.378 LSB, 0.111 %)
+#define C4SWBB_VOUT_LDEVI             137u       // 136.551 (+0.449 LSB, 0.329 %)
+#define C4SWBB_VOUT_REF_5V            853u       // 853.445 (-0.445 LSB, 0.052 %)
+#define C4SWBB_VOUT_REF_9V            1536u      // 1536.2 (-0.201 LSB, 0.013 %)
+#define C4SWBB_VOUT_REF_12V           2048u      // 2048.27 (-0.268 LSB, 0.013 %)
+#define C4SWBB_VOUT_REF_15V           2560u      // 2560.33 (-0.335 LSB, 0.013 %)
+#define C4SWBB_VOUT_REF_20V           3414u      // 3413.78 (+0.221 LSB, 0.006 %)
+#define C4SWBB_VIN_UVLO               642u       // 641.522 (+0.478 LSB, 0.075 %)
+#define C4SWBB_VIN_OVLO               1833u      // 1832.92 (+0.081 LSB, 0.004 %)
+#define C4SWBB_VIN_HYST               92u        // 91.646 (+0.354 LSB, 0.386 %)
+#define VIN_FB_OFFSET                 0u         // 0 (+0.000 LSB, 0.000 %) Input voltage sense offset in [ADC ticks]
+#define VOUT_FB_OFFSET                0          // 0 (+0.000 LSB, 0.000 %) Output voltage sense offset in [ADC ticks]
+#define IOUT_SCALER_RATIO_TICKS       248u       // 248.242 (-0.242 LSB, 0.098 %) Current feedback ratio in [ticks/A]
+#define IOUT_SCALER_OFFSET_TICKS      0u         // 0 (+0.000 LSB, 0.000 %) Current sense offset in [ADC ticks]
+#define IOUT_COMMON_MODE_V_MIN        427u       // 426.722 (+0.278 LSB, 0.065 %) Current sense minimum common mode voltage in [ADC ticks]
+#define VIN2VOUT_NORMALIZATION        0x7733     // 1.86248 (+0.094 LSB, 0.000 %) Input voltage feedback normalized to output voltage feedback
+#define VIN2VOUT_NORM_BSFT            1          // Bit-shift of VIN2VOUT_NORMALIZATION
+#define VIN_ADC2MV_FACTOR             0x574B     // 10.9116 (+0.136 LSB, 0.001 %) Input voltage [ADC ticks] to [mV]
+#define VIN_ADC2MV_BSFT               4          // Bit-shift of VIN_ADC2MV_FACTOR
+#define VIN_MV2ADC_FACTOR             0x5DD8     // 0.091646 (-0.441 LSB, 0.002 %) Input voltage [mV] to [ADC ticks]
+#define VIN_MV2ADC_BSFT               (-3)       // Bit-shift of VIN_MV2ADC_FACTOR
+#define VOUT_ADC2MV_FACTOR            0x5DBD     // 5.85861 (+0.136 LSB, 0.001 %) Output voltage [ADC ticks] to [mV]
+#define VOUT_ADC2MV_BSFT              3          // Bit-shift of VOUT_ADC2MV_FACTOR
+#define VOUT_MV2ADC_FACTOR            0x5765     // 0.170689 (+0.455 LSB, 0.002 %) Output voltage [mV] to [ADC ticks]
+#define VOUT_MV2ADC_BSFT              (-2)       // Bit-shift of VOUT_MV2ADC_FACTOR
+#define IOUT_ADC2MA_FACTOR            0x4074     // 4.02832 (+0.000 LSB, 0.000 %) Output current [ADC ticks] to [mA]
+#define IOUT_ADC2MA_BSFT              3          // Bit-shift of IOUT_ADC2MA_FACTOR
+#define IOUT_MA2ADC_FACTOR            0x7F1A     // 0.248242 (+0.369 LSB, 0.001 %) Output current [mA] to [ADC ticks]
+#define IOUT_MA2ADC_BSFT              (-2)       // Bit-shift of IOUT_MA2ADC_FACTOR
+#define SWITCHING_PERIOD              11428u     // 11427.6 (+0.429 LSB, 0.004 %)
+#define PWM_PHASE_SFT                 5713u      // 5713.29 (-0.286 LSB, 0.005 %)
+#define PWM_DUTY_RATIO_MAX            10285u     // 10285.2 (-0.200 LSB, 0.002 %)
+#define PWM_DUTY_RATIO_MIN            114u       // 114.28 (-0.280 LSB, 0.245 %)
+#define SSM_PERIOD_DEVIATION          571u       // 571.4 (-0.400 LSB, 0.070 %)
+#define LEB_PERIOD                    300u       // 300 (+0.000 LSB, 0.000 %)
+#define ADC_TRIG_OFFSET_VOUT          240u       // 240 (+0.000 LSB, 0.000 %)
+#define ADC_TRIG_OFFSET_IOUT          240u       // 240 (+0.000 LSB, 0.000 %)
+#define ADC_TRIG_DELAY_VOUT           480u       // 480 (+0.000 LSB, 0.000 %) Total ADC trigger delay (see hal_adc_trigger.h)
+#define ADC_TRIG_DELAY_IOUT           2720u      // 2720 (+0.000 LSB, 0.000 %)
+#define IOUT_PROPAGATION_DELAY        2240u      // 2240 (+0.000 LSB, 0.000 %) Current feedback signal phase shift
+#define PWM_DEAD_TIME_LE              100u       // 100 (+0.000 LSB, 0.000 %)
+#define PWM_DEAD_TIME_FE              120u       // 120 (+0.000 LSB, 0.000 %)
+#define VIN_UVLO_TRIP                 825u       // 824.814 (+0.186 LSB, 0.023 %)
+#define VIN_UVLO_RELEASE              871u       // 870.637 (+0.363 LSB, 0.042 %)
+#define VIN_FB_REF_ADC                1265u      // 1264.71 (+0.286 LSB, 0.023 %)
+#define VIN_OVLO_TRIP                 1650u      // 1649.63 (+0.373 LSB, 0.023 %)
+#define VIN_OVLO_RELEASE              1604u      // 1603.8 (+0.196 LSB, 0.012 %)
+#define VOUT_UVLO_TRIP                683u       // 682.756 (+0.244 LSB, 0.036 %)
+#define VOUT_UVLO_RELEASE             768u       // 768.1 (-0.100 LSB, 0.013 %)
+#define VOUT_FB_REF_ADC               853u       // 853.445 (-0.445 LSB, 0.052 %)
+#define VOUT_OVP_TRIP                 3755u      // 3755.16 (-0.157 LSB, 0.004 %)
+#define VOUT_OVP_RELEASE              3670u      // 3669.81 (+0.187 LSB, 0.005 %)
+#define VOUT_MAX_DEV                  85u        // 85.3445 (-0.344 LSB, 0.404 %)
+#define IOUT_LCL_CLAMP                0u         // 0 (+0.000 LSB, 0.000 %)
+#define IOUT_INRUSH_CLAMP             248u       // 248.242 (-0.242 LSB, 0.098 %)
+#define IOUT_OCL_TRIP                 869u       // 868.848 (+0.152 LSB, 0.017 %)
+#define IOUT_4SWBB_UTH_CONV1          273u       // 273.067 (-0.067 LSB, 0.024 %)
+#define IOUT_4SWBB_LTH_CONV1          223u       // 223.418 (-0.418 LSB, 0.187 %)
+#define IOUT_4SWBB_UTH_CONV2          273u       // 273.067 (-0.067 LSB, 0.024 %)
+#define IOUT_4SWBB_LTH_CONV2          223u       // 223.418 (-0.418 LSB, 0.187 %)
+#define IOUT_MPH_UTH_PHASE2           372u       // 372.364 (-0.364 LSB, 0.098 %)
+#define IOUT_MPH_LTH_PHASE2           298u       // 297.891 (+0.109 LSB, 0.037 %)
+#define IOUT_MPH_UTH_PHASE3           546u       // 546.133 (-0.133 LSB, 0.024 %)
+#define IOUT_MPH_LTH_PHASE3           472u       // 471.661 (+0.339 LSB, 0.072 %)
+#define IOUT_MPH_UTH_PHASE4           720u       // 719.903 (+0.097 LSB, 0.013 %)
+#define IOUT_MPH_LTH_PHASE4           645u       // 645.43 (-0.430 LSB, 0.067 %)
+#define IOUT_MPH_ADD_DLY              1u         // 1 (+0.000 LSB, 0.000 %) Phase add delay in [task manager ticks]
+#define IOUT_MPH_SHED_DLY             49u        // 49 (+0.000 LSB, 0.000 %) Phase shed delay in [task manager ticks]
+#define DUTY_RATIO_MIN_REG            686u       // 685.68 (+0.320 LSB, 0.047 %)
+#define DUTY_RATIO_MAX_REG            10285u     // 10285.2 (-0.200 LSB, 0.002 %)
+#define DUTY_RATIO_INIT_BUCK_REG      686u       // 685.68 (+0.320 LSB, 0.047 %)
+#define DUTY_RATIO_INIT_BOOST_REG     1257u      // 1257.08 (-0.080 LSB, 0.006 %)
+
+#endif	/* _HARDWARE_ABSTRACTION_LAYER_SYSTEM_FIXPOINT_H_ */
+
+// EOF
@@ -66,6 +66,15 @@
 #define IOUT_4SWBB_TRIP_CONV2   1.100       // [A] Upper boost switch threshold for output current - PWM5&PWM7 Buck-Boost leg
 #define IOUT_4SWBB_RESET_CONV2  0.900       // [A] Lower boost switch threshold for output current - PWM5&PWM7 Buck-Boost leg
 
+#define IOUT_MPH_TRIP_PHASE2    1.500       // [A] Output current above which converter phase #2 is added
+#define IOUT_MPH_RESET_PHASE2   1.200       // [A] Output current below which converter phase #2 is shed
+#define IOUT_MPH_TRIP_PHASE3    2.200       // [A] Output current above which converter phase #3 is added
+#define IOUT_MPH_RESET_PHASE3   1.900       // [A] Output current below which converter phase #3 is shed
+#define IOUT_MPH_TRIP_PHASE4    2.900       // [A] Output current above which converter phase #4 is added
+#define IOUT_MPH_RESET_PHASE4   2.600       // [A] Output current below which converter phase #4 is shed
+#define IOUT_MPH_ADD_DELAY      200e-6      // [sec] Time the output current has to exceed an add-threshold before a phase is added
+#define IOUT_MPH_SHED_DELAY     5e-3        // [sec] Time the output current has to stay below a shed-threshold before a phase is shed
+
 #define DUTY_RATIO_MIN          0.060       // Minimum duty ration 
 #define DUTY_RATIO_MAX          0.900       // maximum duty ratio
 
@@ -78,43 +87,14 @@
  * Set of defines and marcos for easy hardware migration/changes
  *
  * Description:
- * The following macros translate physical values from defines above to 
- * integer values which can be written to registers.
+ * The physical values from defines above are translated into integer values, which can be 
+ * written to registers, by the host tool tools/fixed_point_scaling.py (e.g. VIN_UVLO_TRIP, 
+ * IOUT_OCL_TRIP, DUTY_RATIO_MAX_REG). The generated constants are declared in syscfg_fixpoint.h.
  * 
  * See also:
+ * syscfg_fixpoint.txt, syscfg_scaling.h
  * ************************************************************************************************/
 
-#define VIN_UVLO_TRIP           (uint16_t)(VIN_MINIMUM * VIN_DIVIDER_RATIO * ADC_SCALER) // Input voltage sense ADC ticks
-#define VIN_UVLO_RELEASE        (uint16_t)((VIN_MINIMUM + VIN_MINIMUM_HYST) * VIN_DIVIDER_RATIO * ADC_SCALER) // Input voltage sense ADC ticks
-#define VIN_FB_REF_ADC          (uint16_t)((float)VIN_DIVIDER_RATIO * (float)VIN_NOMINAL * ADC_SCALER)   // Input voltage feedback in ADC ticks
-#define VIN_OVLO_TRIP           (uint16_t)((float)VIN_MAXIMUM * (float)VIN_DIVIDER_RATIO * (float)ADC_SCALER) // Input voltage sense ADC ticks
-#define VIN_OVLO_RELEASE        (uint16_t)(((float)VIN_MAXIMUM - (float)VIN_MAXIMUM_HYST) * (float)VIN_DIVIDER_RATIO * (float)ADC_SCALER) // Input voltage sense ADC ticks
-
-#define VOUT_UVLO_TRIP          (uint16_t)(VOUT_MINIMUM * VOUT_DIVIDER_RATIO * ADC_SCALER) // Input voltage sense ADC ticks
-#define VOUT_UVLO_RELEASE       (uint16_t)((VOUT_MINIMUM + VOUT_MINIMUM_HYST) * VOUT_DIVIDER_RATIO * ADC_SCALER) // Input voltage sense ADC ticks
-#define VOUT_FB_REF_ADC         (uint16_t)((float)VOUT_DIVIDER_RATIO * (float)VOUT_NOMINAL * ADC_SCALER)   // Output voltage feedback in ADC ticks
-#define VOUT_OVP_TRIP           (uint16_t)((float)VOUT_MAXIMUM * (float)VOUT_DIVIDER_RATIO * (float)ADC_SCALER) // Output voltage sense ADC ticks
-#define VOUT_OVP_RELEASE        (uint16_t)(((float)VOUT_MAXIMUM - (float)VOUT_MAXIMUM_HYST) * (float)VOUT_DIVIDER_RATIO * (float)ADC_SCALER) // Input voltage sense ADC ticks
-#define VOUT_MAX_DEV            (uint16_t)((float)VOUT_DIVIDER_RATIO * (float)VOUT_MAX_DEVIATION * ADC_SCALER)   // Maximum allowed output voltage deviation in ADC ticks 
-
-#define IOUT_LCL_CLAMP          (uint16_t)((((float)IOUT_MINIMUM * (float)IOUT_SCALER_RATIO_I2V)) * (float)ADC_SCALER) // Output voltage sense ADC ticks
-#define IOUT_INRUSH_CLAMP       (uint16_t)((((float)IOUT_MAX_STARTUP * (float)IOUT_SCALER_RATIO_I2V)) * (float)ADC_SCALER) // Output voltage sense ADC ticks
-#define IOUT_OCL_TRIP           (uint16_t)((((float)IOUT_MAXIMUM * (float)IOUT_SCALER_RATIO_I2V)) * (float)ADC_SCALER) // Output voltage sense ADC ticks
-
-// 4-Switch Buck/Boost operation PWM-leg control
-
-#define IOUT_4SWBB_UTH_CONV1    (uint16_t)((((float)IOUT_4SWBB_TRIP_CONV1 * (float)IOUT_SCALER_RATIO_I2V)) * (float)ADC_SCALER) // Output voltage sense ADC ticks
-#define IOUT_4SWBB_LTH_CONV1    (uint16_t)((((float)IOUT_4SWBB_RESET_CONV1 * (float)IOUT_SCALER_RATIO_I2V)) * (float)ADC_SCALER) // Output voltage sense ADC ticks
-#define IOUT_4SWBB_UTH_CONV2    (uint16_t)((((float)IOUT_4SWBB_TRIP_CONV2 * (float)IOUT_SCALER_RATIO_I2V)) * (float)ADC_SCALER) // Output voltage sense ADC ticks
-#define IOUT_4SWBB_LTH_CONV2    (uint16_t)((((float)IOUT_4SWBB_RESET_CONV2 * (float)IOUT_SCALER_RATIO_I2V)) * (float)ADC_SCALER) // Output voltage sense ADC ticks
-
-#define DUTY_RATIO_MIN_REG          (uint16_t)((float)DUTY_RATIO_MIN * (float)SWITCHING_PERIOD)
-#define DUTY_RATIO_MAX_REG          (uint16_t)((float)DUTY_RATIO_MAX * (float)SWITCHING_PERIOD)
-#define DUTY_RATIO_INIT_BUCK_REG    (uint16_t)((float)DUTY_RATIO_BUCK_LEG_INIT * (float)SWITCHING_PERIOD)
-#define DUTY_RATIO_INIT_BOOST_REG   (uint16_t)((float)DUTY_RATIO_BOOST_LEG_INIT * (float)SWITCHING_PERIOD)
-
-
-
 
 #endif	/* __SYSTEM_DESIGN_LIMITS_H__ */
 
@@ -40,6 +40,12 @@
 #define DEBUG_PIN_MODE      DBG_MODE_GPIO   // This option selects the Debug Mode GPIO, DAC or PWM
 
 #define USE_SPREAD_SPECTRUM_MODULATION 0       // This option will enable/disable spread spectrum modulation
+#define USE_PHASE_SHEDDING  1       // This option enables/disables automatic phase shedding of multiphase converters
+
+#define SSM_PROFILE_TRIANGULAR  0   // Switching frequency is swept up and down along a triangular profile
+#define SSM_PROFILE_RANDOM      1   // Switching frequency steps through a pseudo-random sequence
+
+#define SSM_PROFILE         SSM_PROFILE_TRIANGULAR  // Set spread spectrum modulation profile
 
 
 #define CURRENT_SENSE_TRANSFORMER  1 // Current sensor is a current sense transformer
@@ -55,7 +55,6 @@
 
 #define ADC_REF              3.300 // ADC reference voltage in V
 #define ADC_RESOLUTION       12.0  // ADC resolution in [bit]
-#define ADC_GRANULARITY      (float)(ADC_REF / pow(2.0, ADC_RESOLUTION)) // ADC granularity in [V/tick]
 
 /*!Hardware Abstraction
  * *************************************************************************************************
@@ -97,21 +96,6 @@
     #define C4SWBB_VOUT_AMP_GAIN         1.000  // Gain factor or additional op-amp (set to 1.0 if none is used)
     #define C4SWBB_VOUT_SENSE_OFFSET     0.000  // Output voltage sense offset
 
-    //~~~~~~~~~~~~~~~~~ conversion macros ~~~~~~~~~~~~~~~~~~
-    #define C4SWBB_VOUT_FB_GAIN      (float)(C4SWBB_VOUT_AMP_GAIN * (((float)C4SWBB_VOUT_R2) / (((float)C4SWBB_VOUT_R1) + ((float)C4SWBB_VOUT_R2))))
-    #define C4SWBB_VOUT_OFFSET       (uint16_t)(C4SWBB_VOUT_SENSE_OFFSET * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VOUT_REF          (uint16_t)(C4SWBB_VOUT_NOMINAL * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VOUT_OVP          (uint16_t)(C4SWBB_VOUT_MAXIMUM * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VOUT_HYST         (uint16_t)(C4SWBB_VOUT_HYSTERESIS * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VOUT_UDEVI        (uint16_t)(C4SWBB_VOUT_UPPER_DEVIATION * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VOUT_LDEVI        (uint16_t)(C4SWBB_VOUT_LOWER_DEVIATION * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-
-    #define C4SWBB_VOUT_REF_5V       (uint16_t)(C4SWBB_VOUT_LEVEL_5V * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VOUT_REF_9V       (uint16_t)(C4SWBB_VOUT_LEVEL_9V * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VOUT_REF_12V      (uint16_t)(C4SWBB_VOUT_LEVEL_12V * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VOUT_REF_15V      (uint16_t)(C4SWBB_VOUT_LEVEL_15V * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VOUT_REF_20V      (uint16_t)(C4SWBB_VOUT_LEVEL_20V * C4SWBB_VOUT_FB_GAIN / ADC_GRANULARITY)
-    //~~~~~~~~~~~~~~~~~
 
     // Input Voltage Feedback Scaling
     #define C4SWBB_VIN_DIVIDER_R1          36000       // Resitance of upper voltage divider resistor in Ohm
@@ -123,15 +107,6 @@
     #define C4SWBB_VIN_MAXIMUM      20.0        // Maximum input voltage in [V]
     #define C4SWBB_VIN_HYSTERESIS   1.0         // Input voltage protection hysteresis in [V]
 
-    //~~~~~~~~~~~~~~~~~ conversion macros ~~~~~~~~~~~~~~~~~~
-    #define C4SWBB_VIN_FB_GAIN       (float)((C4SWBB_VIN_R2) / (C4SWBB_VIN_R1 + C4SWBB_VIN_R2))
-    #define C4SWBB_VIN_UVLO          (uint16_t)(C4SWBB_VIN_MINIMUM * C4SWBB_VIN_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VIN_OVLO          (uint16_t)(C4SWBB_VIN_MAXIMUM * C4SWBB_VIN_FB_GAIN / ADC_GRANULARITY)
-    #define C4SWBB_VIN_HYST          (uint16_t)(C4SWBB_VIN_HYSTERESIS * C4SWBB_VIN_FB_GAIN / ADC_GRANULARITY)
-
-    #define VIN2VOUT_NORMALIZATION  0x7fff  // (int16_t)(ceiling(log(VOUT_DIVIDER_RATIO/VIN_DIVIDER_RATIO)))
-    #define VIN2VOUT_NORM_BSFT      1       // Fixed-Point Bit-Shift of normalization factor
-    //~~~~~~~~~~~~~~~~~
 
     #define C4SWBB_CS_AMP_GAIN          50.000      // Current sense amplifier gain in [V/V]
     #define C4SWBB_CS_SHUNT_RESISTANCE  4.0e-3      // Current sense resistor value in [Ohm]
@@ -143,11 +118,13 @@
 
     // System Settings
     #define SWITCHING_FREQUENCY         350e+3      // Nominal switching frequency per converter phase in [Hz]
-    #define PWM_PHASE_SHIFT             (SWITCHING_PERIOD / 2.0) // Phase shift of the PWM switching frequency
+    #define PWM_PHASE_COUNT             2           // Number of interleaved converter phases
+    #define PWM_PHASE_SHIFT             ((1.0/(float)(SWITCHING_FREQUENCY))/(float)(PWM_PHASE_COUNT)) // Phase shift between two adjacent converter phases in [sec]
     #define PWM_DEAD_TIME_RISING        50e-9       // Nominal dead time at the leading edge in [ns]
     #define PWM_DEAD_TIME_FALLING       60e-9       // Nominal dead time at the falling edge in [ns]
     #define PWM_DUTY_RATIO_MAXIMUM      0.90        // Maximum duty ratio in [%]
     #define PWM_DUTY_RATIO_MINIMUM      0.01        // Minimum duty ratio in [%]
+    #define SSM_MODULATION_DEPTH        0.05        // Spread spectrum switching period deviation in [%] (+/-)
     #define LEADING_EDGE_BLANKING_PER   150e-9		// Leading Edge Blanking period in nanoseconds
     #define ADC_TRIGGER_OFFSET_VOUT     120e-9      // ADC trigger offset compensating for propagat6ion delays (voltage feedback)
     #define ADC_TRIGGER_OFFSET_IOUT     120e-9      // ADC trigger offset compensating for propagat6ion delays (current feedback)
@@ -165,50 +142,22 @@
  * Set of defines and marcos for easy hardware migration/changes
  *
  * Description:
- * The following macros translate physical values of hardware specifications and signals into 
- * integer values which can be written to registers.
+ * The physical values of hardware specifications and signals defined above are translated into 
+ * integer values, which can be written to registers, by the host tool tools/fixed_point_scaling.py.
+ * The generated constants (e.g. SWITCHING_PERIOD, C4SWBB_VOUT_REF, LEB_PERIOD) and the Q15 
+ * unit conversion factors are declared in syscfg_fixpoint.h, which needs to be regenerated 
+ * whenever one of the values above is changed:
+ * 
+ *     python tools/fixed_point_scaling.py project/h/hal/config/syscfg_fixpoint.txt -o project/h/hal/config/syscfg_fixpoint.h
  * 
  * See also:
+ * syscfg_fixpoint.txt, syscfg_limits.h, hal_scaling.h
  * ************************************************************************************************/
 
-// Macros are used to translate physical values into register values
-
-#define SWITCHING_PERIOD            ((uint16_t)(((float)((1.0/(float)(SWITCHING_FREQUENCY))/T_ACLK)-1)))
-#define PWM_PHASE_SFT               ((uint16_t)(((float)(((float)(PWM_PHASE_SHIFT)/T_ACLK)-1))))
-#define PWM_DUTY_RATIO_MAX          ((uint16_t)(PWM_DUTY_RATIO_MAXIMUM * (float)SWITCHING_PERIOD))
-#define PWM_DUTY_RATIO_MIN          ((uint16_t)(PWM_DUTY_RATIO_MINIMUM * (float)SWITCHING_PERIOD))
-
-// Macro calculating Leading Edge Blanking period counter value based on time base frequency selection
+// Register bit field masks limiting the generated constants (see syscfg_fixpoint.txt)
 #define REG_LEB_PERIOD_MASK         0b1111111111111111
-#define LEB_PERIOD                  ((uint16_t)((uint16_t)(((float)(LEADING_EDGE_BLANKING_PER))/((float)(T_ACLK))) >> PWM_PCLKDIV_PRIMARY))
-
-// Macro calculating ADC offset period counter value based on time base frequency selection
-#define ADC_TRIG_OFFSET_VOUT        ((uint16_t)((uint16_t)(((float)(ADC_TRIGGER_OFFSET_VOUT))/((float)(T_ACLK))) >> PWM_PCLKDIV_PRIMARY) & REG_LEB_PERIOD_MASK)
-#define ADC_TRIG_OFFSET_IOUT        ((uint16_t)((uint16_t)(((float)(ADC_TRIGGER_OFFSET_IOUT))/((float)(T_ACLK))) >> PWM_PCLKDIV_PRIMARY) & REG_LEB_PERIOD_MASK)
-
-// Macros calculating Dead Time Rising/Falling Edge period counter value based on time base frequency selection
 #define REG_DTRx_VALID_BIT_MSK      0b0011111111111111
 #define REG_ALTDTRx_VALID_BIT_MSK   0b0011111111111111
-#define PWM_DEAD_TIME_LE            ((uint16_t)((uint16_t)(((float)(PWM_DEAD_TIME_RISING))/((float)(T_ACLK))) >> PWM_PCLKDIV_PRIMARY) & REG_DTRx_VALID_BIT_MSK)
-#define PWM_DEAD_TIME_FE            ((uint16_t)((uint16_t)(((float)(PWM_DEAD_TIME_FALLING))/((float)(T_ACLK))) >> PWM_PCLKDIV_PRIMARY) & REG_ALTDTRx_VALID_BIT_MSK)
-
-// Macros calculating register values based on the physical values given above
-
-#define VIN_DIVIDER_RATIO           (float)((float)C4SWBB_VIN_AMP_GAIN * ((float)C4SWBB_VIN_DIVIDER_R2) / ((float)(C4SWBB_VIN_DIVIDER_R1 + C4SWBB_VIN_DIVIDER_R2)))
-#define VIN_DIVIDER_RATIO_INV       (float)( 1.0 / VIN_DIVIDER_RATIO )
-#define VIN_FB_OFFSET               (uint16_t)(C4SWBB_VIN_FEEDBACK_OFFSET * ADC_SCALER)    // Input voltage sense offset ADC ticks
-
-#define VOUT_DIVIDER_RATIO          (float)((float)C4SWBB_VOUT_AMP_GAIN * ((float)C4SWBB_VOUT_R2) / ((float)(C4SWBB_VOUT_R1 + C4SWBB_VOUT_R2)))
-#define VOUT_DIVIDER_RATIO_INV      (float)( 1.0 / VOUT_DIVIDER_RATIO )
-#define VOUT_FB_OFFSET              (int16_t)(C4SWBB_VOUT_SENSE_OFFSET * ADC_SCALER)   // Output voltage sense offset ADC ticks
-
-#define IOUT_SCALER_RATIO_I2V       (float)((float)C4SWBB_CS_SHUNT_RESISTANCE * (float)C4SWBB_CS_AMP_GAIN) // Current feeback ratio in [V/A] => used to convert current into feedback voltage
-#define IOUT_SCALER_RATIO_V2I       (float)(1.0/((float)IOUT_SCALER_RATIO_I2V))  // Current feeback ratio in [A/V] => used to convert feedback voltage into current
-#define IOUT_SCALER_RATIO_TICKS     (uint16_t)((float)IOUT_SCALER_RATIO_I2V * (float)ADC_SCALER) // Current feeback ratio in [Ticks/A] => used to convert current into ADC ticks
-
-#define IOUT_SCALER_OFFSET_TICKS    (uint16_t)((float)C4SWBB_IOUT_FEEDBACK_OFFSET * (float)ADC_SCALER) // Current sense offset ADC ticks
-#define IOUT_PROPAGATION_DELAY      (uint16_t)((float)C4SWBB_CS_PROPAGATION_DELAY /(float)T_ACLK) // current feedback signal phase shift
-#define IOUT_COMMON_MODE_V_MIN      (uint16_t)((float)C4SWBB_CS_COMMON_MODE_V_MIN * (float)VOUT_DIVIDER_RATIO * (float)ADC_SCALER) // Current sense minimum common mode voltage ADC ticks
 
 
 #endif	/* _HARDWARE_ABSTRACTION_LAYER_SYSTEM_SCALING_H_ */
@@ -41,6 +41,15 @@
 #include "hal/config/syscfg_scaling.h"
 #include "hal/config/syscfg_options.h"
 #include "hal/config/syscfg_startup.h"
+#include "hal/config/syscfg_fixpoint.h"
+
+// Fixed-point unit conversion
+#include "hal/hal_scaling.h"
+
+// Power stage drivers
+#include "hal/hal_multiphase.h"
+#include "hal/hal_spread_spectrum.h"
+#include "hal/hal_adc_trigger.h"
 
 
 /* ***********************************************************************************************
@@ -0,0 +1,137 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!hal_adc_trigger.h
+ * ***************************************************************************
+ * File:   hal_adc_trigger.h
+ * Author: M91406
+ *
+ * Description:
+ * PWM-synchronized ADC trigger placement. Instead of using a fixed trigger 
+ * position, the ADC triggers A and B of a PWM generator are recalculated with
+ * every duty cycle update, so that the feedback signal is sampled in the 
+ * middle of the on-time or in the middle of the off-time, where it is furthest
+ * away from switching edges and the sampled value equals the average of a 
+ * linear ramp (e.g. inductor current).
+ * 
+ * The delay added to each trigger compensates for the propagation delay of 
+ * the sense signal path (see ADC_TRIG_DELAY_VOUT/ADC_TRIG_DELAY_IOUT, which 
+ * include C4SWBB_CS_PROPAGATION_DELAY for current feedback). Trigger positions
+ * are written into the update data of the PWM generator and applied with the 
+ * duty cycle by the same update request (e.g. HSPWM_GroupWrite()/MPH_Update()).
+ * ***************************************************************************/
+
+#ifndef HAL_ADC_TRIGGER_PLACEMENT_H
+#define	HAL_ADC_TRIGGER_PLACEMENT_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "mcal/mcal.h"
+
+/*!ADCTRG_PLACEMENT_e
+ * ***********************************************************************************************
+ * Description:
+ * Sampling point of an ADC trigger within the switching period
+ * ***********************************************************************************************/
+
+typedef enum {
+    ADCTRG_MID_ON_TIME  = 0, // Trigger in the middle of the on-time (DC / 2)
+    ADCTRG_MID_OFF_TIME = 1  // Trigger in the middle of the off-time (DC + (PER - DC) / 2)
+} ADCTRG_PLACEMENT_e;
+
+/*!ADC_TRIGGER_t
+ * ***********************************************************************************************
+ * Description:
+ * Placement settings of ADC trigger A and B of one PWM generator. Delays are given in [PWM 
+ * ticks] (e.g. ADC_TRIG_DELAY_IOUT).
+ * ***********************************************************************************************/
+
+typedef struct {
+    ADCTRG_PLACEMENT_e placement_a; // Sampling point of trigger A
+    ADCTRG_PLACEMENT_e placement_b; // Sampling point of trigger B
+    uint16_t delay_a; // Propagation delay compensation of trigger A
+    uint16_t delay_b; // Propagation delay compensation of trigger B
+} ADC_TRIGGER_t;
+
+/*!ADCTRG_GetPosition()
+ * ************************************************************************************************
+ * Summary:
+ * Calculates the trigger position of one sampling point
+ *
+ * Parameters:
+ * ADCTRG_PLACEMENT_e placement: Sampling point within the switching period
+ * uint16_t delay:      Propagation delay compensation in [PWM ticks]
+ * uint16_t duty_cycle: Most recent duty cycle in [PWM ticks]
+ * uint16_t period:     Switching period in [PWM ticks]
+ *
+ * Returns:
+ * Trigger position in [PWM ticks] relative to the start of the PWM cycle
+ *
+ * Description:
+ * Both halves are shifted separately to prevent an overflow of (DC + PER). Trigger positions
+ * exceeding the switching period wrap around into the next PWM cycle.
+ *
+ * ***********************************************************************************************/
+
+static inline uint16_t ADCTRG_GetPosition(ADCTRG_PLACEMENT_e placement, uint16_t delay, uint16_t duty_cycle, uint16_t period)
+{
+    uint16_t position;
+
+    if (placement == ADCTRG_MID_ON_TIME)
+        position = (duty_cycle >> 1);
+    else
+        position = ((duty_cycle >> 1) + (period >> 1));
+
+    position += delay;
+    if (position >= period)
+        position -= period;
+
+    return(position);
+}
+
+/*!ADCTRG_Update()
+ * ************************************************************************************************
+ * Summary:
+ * Writes duty cycle and recalculated ADC triggers into the update data of a PWM generator
+ *
+ * Parameters:
+ * const ADC_TRIGGER_t* trg:  Pointer to the trigger placement settings
+ * HSPWM_GROUP_DATA_t* data:  Update data of the PWM generator
+ * uint16_t duty_cycle:       New duty cycle in [PWM ticks]
+ * uint16_t period:           Switching period in [PWM ticks] (e.g. SSM_ENTRY_t.period)
+ *
+ * Description:
+ * Called by the control loop after the new duty cycle has been calculated and clamped. The
+ * data is written to the PWM generator by the next call of HSPWM_GroupWrite().
+ *
+ * ***********************************************************************************************/
+
+static inline void ADCTRG_Update(const ADC_TRIGGER_t* trg, HSPWM_GROUP_DATA_t* data, uint16_t duty_cycle, uint16_t period)
+{
+    data->duty_cycle = duty_cycle;
+    data->trigger_a = ADCTRG_GetPosition(trg->placement_a, trg->delay_a, duty_cycle, period);
+    data->trigger_b = ADCTRG_GetPosition(trg->placement_b, trg->delay_b, duty_cycle, period);
+}
+
+#endif	/* HAL_ADC_TRIGGER_PLACEMENT_H */
+
@@ -0,0 +1,181 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!hal_multiphase.h
+ * ***************************************************************************
+ * File:   hal_multiphase.h
+ * Author: M91406
+ *
+ * Description:
+ * Interleaving manager of multiphase converters. Each converter phase is driven
+ * by one PWM generator. All generators of a converter are combined in one PWM
+ * update group, with the generator of phase #1 being the master. The phase
+ * offset of the active phases is evenly distributed across the switching period
+ * (phase k is shifted by k * PERIOD / N, where N is the number of active phases).
+ *
+ * At light load, phases are shed one by one to reduce switching and gate drive
+ * losses. Phases are added again when the load current rises. Each transition
+ * has its own current threshold and dwell time, with the shed threshold below
+ * the add threshold (see IOUT_MPH_TRIP_PHASEx/IOUT_MPH_RESET_PHASEx in
+ * syscfg_limits.h), preventing the phase count from toggling around a threshold.
+ *
+ * PWM generators are expected to run in Variable Phase PWM mode, where PGxPHASE
+ * delays the leading edge and PGxDC determines the on-time of the phase.
+ * ***************************************************************************/
+
+#ifndef HAL_MULTIPHASE_MANAGER_H
+#define	HAL_MULTIPHASE_MANAGER_H
+
+#include <xc.h> // include processor files - each processor file is guarded.
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "mcal/mcal.h"
+
+#define MPH_PHASE_COUNT_MAX     4   // Maximum number of phases supported by the multiphase manager
+
+/*!MPH_PHASE_CONFIG_t
+ * ***********************************************************************************************
+ * Summary:
+ * Phase configuration shared between multiphase manager task and control loop
+ *
+ * Description:
+ * The multiphase manager task runs at lower priority than the control loop, which may interrupt
+ * it at any time. A new number of active phases and their phase distance are therefore prepared 
+ * in the shadow configuration, which is not used by the control loop, and published by a single 
+ * (atomic) write of the configuration pointer. MPH_Update() reads the pointer once per call and 
+ * always works on a consistent set of phase count and phase distance.
+ * 
+ * The phase distance is given as fraction of the switching period (65536 / N), so that 
+ * MPH_Update() can scale the phase offsets to the period of every PWM cycle, which changes
+ * from cycle to cycle when spread spectrum modulation is enabled.
+ * ***********************************************************************************************/
+
+typedef struct {
+    uint16_t active_phases; // Number of active phases
+    uint16_t phase_step; // Phase distance of adjacent phases in [1/65536 of the switching period]
+} MPH_PHASE_CONFIG_t;
+
+/*!MULTIPHASE_t
+ * ***********************************************************************************************
+ * Summary:
+ * Multiphase converter data structure
+ *
+ * Description:
+ * The phase distance of all phases is recalculated by the multiphase manager task each time
+ * the number of active phases changes and are published to the control loop by swapping the
+ * phase configuration pointer (see MPH_PHASE_CONFIG_t). The register data of all phases is 
+ * only written by the control loop, which adds the latest duty cycle and ADC trigger positions
+ * and writes all phases at once using MPH_Update(). Register data of inactive phases is kept 
+ * at zero duty cycle while their outputs are held in override state. The outputs of an added phase are released by the next
+ * call of the multiphase manager task, after the control loop has written its duty cycle.
+ *
+ * The optional phase current balancing hook is called by the multiphase manager task and
+ * may adjust the duty cycle trim value of each phase (e.g. based on the difference between
+ * the phase current and the average current of all active phases).
+ * ***********************************************************************************************/
+
+typedef struct MULTIPHASE_s {
+    HSPWM_HANDLE_t pg[MPH_PHASE_COUNT_MAX]; // PWM generator handles of all phases (pg[0] = master)
+    HSPWM_GROUP_t group; // PWM update group of all phases
+    HSPWM_GROUP_DATA_t data[MPH_PHASE_COUNT_MAX]; // Register data of all phases written by MPH_Update()
+    MPH_PHASE_CONFIG_t phase_config[2]; // Active and shadow phase configuration
+    const MPH_PHASE_CONFIG_t* volatile config; // Phase configuration used by MPH_Update()
+    int16_t duty_trim[MPH_PHASE_COUNT_MAX]; // Phase current balancing duty cycle correction in [PWM ticks]
+    uint16_t add_threshold[MPH_PHASE_COUNT_MAX]; // Output current above which phase [k] is added in [ADC ticks]
+    uint16_t shed_threshold[MPH_PHASE_COUNT_MAX]; // Output current below which phase [k] is shed in [ADC ticks]
+    uint16_t add_delay; // Phase add dwell time in [task manager ticks]
+    uint16_t shed_delay; // Phase shed dwell time in [task manager ticks]
+    uint16_t counter; // Dwell time counter of a pending phase add/shed transition
+    uint16_t period; // Nominal switching period in [PWM ticks]
+    uint16_t phase_count; // Number of installed phases
+    uint16_t min_phases; // Minimum number of active phases
+    uint16_t active_phases; // Number of currently active phases (multiphase manager task)
+    uint16_t ovr_hold; // Bit mask of phases with outputs held in override state
+    bool shedding_enable; // Enables/disables automatic phase shedding
+    void (*balance)(struct MULTIPHASE_s* mph); // Phase current balancing hook (NULL = no balancing)
+} MULTIPHASE_t;
+
+/* ***********************************************************************************************
+ * PROTOTYPES
+ * ***********************************************************************************************/
+
+extern volatile uint16_t MPH_Initialize(MULTIPHASE_t* mph, const uint16_t* instance, uint16_t phase_count, uint16_t period);
+extern volatile uint16_t MPH_SetActivePhases(MULTIPHASE_t* mph, uint16_t active_phases);
+extern volatile uint16_t MPH_Execute(MULTIPHASE_t* mph, uint16_t load_current);
+
+/*!MPH_Update()
+ * ************************************************************************************************
+ * Summary:
+ * Writes duty cycle and ADC trigger positions to all active phases
+ *
+ * Parameters:
+ * MULTIPHASE_t* mph:   Pointer to the multiphase converter data structure
+ * uint16_t period:     Switching period of the next PWM cycle in [PWM ticks] (e.g. mph->period
+ *                      or SSM_ENTRY_t.period when spread spectrum modulation is enabled)
+ * uint16_t duty_cycle: Common duty cycle of all active phases in [PWM ticks]
+ * uint16_t trigger_a:  ADC trigger A position relative to the leading edge in [PWM ticks]
+ * uint16_t trigger_b:  ADC trigger B position relative to the leading edge in [PWM ticks]
+ *
+ * Description:
+ * Called by the control loop. The phase current balancing trim is added to the duty cycle of
+ * each active phase, the phase offsets are scaled to the given switching period, the ADC triggers
+ * are shifted by the phase offset (wrapping around at the end of the given switching period) and 
+ * the data of all phases is committed by a single update request of the master generator. Duty 
+ * cycle and triggers of inactive phases are cleared. Trigger positions need to be given for the
+ * same period (e.g. SSM_ENTRY_t.trigger_a).
+ *
+ * ***********************************************************************************************/
+
+static inline void MPH_Update(MULTIPHASE_t* mph, uint16_t period, uint16_t duty_cycle, uint16_t trigger_a, uint16_t trigger_b)
+{
+    const MPH_PHASE_CONFIG_t* config = mph->config;
+    HSPWM_GROUP_DATA_t* data = mph->data;
+    const int16_t* trim = mph->duty_trim;
+    uint16_t i, position = 0;
+
+    for (i = config->active_phases; i > 0; i--)
+    {
+        data->duty_cycle = duty_cycle + *trim++;
+        data->phase = (uint16_t)(((uint32_t)period * (uint32_t)position) >> 16);
+        position += config->phase_step;
+        data->trigger_a = data->phase + trigger_a;
+        if (data->trigger_a >= period)
+            data->trigger_a -= period;
+        data->trigger_b = data->phase + trigger_b;
+        if (data->trigger_b >= period)
+            data->trigger_b -= period;
+        data++;
+    }
+
+    for (i = (mph->phase_count - config->active_phases); i > 0; i--)
+    {
+        data->duty_cycle = 0;
+        data->trigger_a = 0;
+        data->trigger_b = 0;
+        data++;
+    }
+
+    HSPWM_GroupWrite(&mph->group, mph->data);
+}
+
+#endif	/* HAL_MULTIPHASE_MANAGER_H */
+
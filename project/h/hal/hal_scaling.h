@@ -0,0 +1,107 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!hal_scaling.h
+ * ***************************************************************************
+ * File:   hal_scaling.h
+ * Author: M91406
+ *
+ * Description:
+ * Runtime unit conversion using the fixed-point scaling factors generated by
+ * tools/fixed_point_scaling.py (see syscfg_fixpoint.h). Each factor is given
+ * as Q15 fraction and normalization bit-shift. A conversion is executed by a 
+ * single 16x16-bit hardware multiplication and a right-shift of the 32-bit 
+ * product, without pulling floating point support libraries into the image:
+ * 
+ *     result = (value * factor) >> (15 - bsft)
+ * 
+ * The caller is responsible for the value range: the result has to fit into
+ * 16 bits (e.g. VOUT_ADC2MV_FACTOR converts ADC results of up to 
+ * 65535 / 5.86 = 11186 ticks).
+ * ***************************************************************************/
+
+#ifndef HAL_FIXED_POINT_SCALING_H
+#define	HAL_FIXED_POINT_SCALING_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "hal/config/syscfg_fixpoint.h"
+
+/*!FXP_ScaleU16()
+ * ************************************************************************************************
+ * Summary:
+ * Scales an unsigned 16-bit value by a Q15 factor with normalization bit-shift
+ *
+ * Parameters:
+ * uint16_t value:  Unsigned value (e.g. ADC result)
+ * int16_t factor:  Q15 scaling factor (e.g. VOUT_ADC2MV_FACTOR)
+ * int16_t bsft:    Normalization bit-shift of the scaling factor (e.g. VOUT_ADC2MV_BSFT)
+ *
+ * Returns:
+ * Scaled value
+ * 
+ * Description:
+ * When factor and bit-shift are constants, the compiler reduces this function to one 
+ * MUL.SU instruction followed by a constant shift of the 32-bit product.
+ *
+ * ***********************************************************************************************/
+
+static inline uint16_t FXP_ScaleU16(uint16_t value, int16_t factor, int16_t bsft)
+{
+    return((uint16_t)(__builtin_mulsu(factor, value) >> (15 - bsft)));
+}
+
+/*!FXP_ScaleS16()
+ * ************************************************************************************************
+ * Summary:
+ * Scales a signed 16-bit value by a Q15 factor with normalization bit-shift
+ *
+ * Parameters:
+ * int16_t value:   Signed value (e.g. offset corrected ADC result or control error)
+ * int16_t factor:  Q15 scaling factor (e.g. VIN2VOUT_NORMALIZATION)
+ * int16_t bsft:    Normalization bit-shift of the scaling factor (e.g. VIN2VOUT_NORM_BSFT)
+ *
+ * Returns:
+ * Scaled value
+ * 
+ * ***********************************************************************************************/
+
+static inline int16_t FXP_ScaleS16(int16_t value, int16_t factor, int16_t bsft)
+{
+    return((int16_t)(__builtin_mulss(value, factor) >> (15 - bsft)));
+}
+
+/* ***********************************************************************************************
+ * UNIT CONVERSION MACROS
+ * ***********************************************************************************************/
+
+#define FXP_VIN_ADC2MV(x)   FXP_ScaleU16((x), VIN_ADC2MV_FACTOR, VIN_ADC2MV_BSFT)   // Input voltage [ADC ticks] to [mV]
+#define FXP_VIN_MV2ADC(x)   FXP_ScaleU16((x), VIN_MV2ADC_FACTOR, VIN_MV2ADC_BSFT)   // Input voltage [mV] to [ADC ticks]
+#define FXP_VOUT_ADC2MV(x)  FXP_ScaleU16((x), VOUT_ADC2MV_FACTOR, VOUT_ADC2MV_BSFT) // Output voltage [ADC ticks] to [mV]
+#define FXP_VOUT_MV2ADC(x)  FXP_ScaleU16((x), VOUT_MV2ADC_FACTOR, VOUT_MV2ADC_BSFT) // Output voltage [mV] to [ADC ticks]
+#define FXP_IOUT_ADC2MA(x)  FXP_ScaleU16((x), IOUT_ADC2MA_FACTOR, IOUT_ADC2MA_BSFT) // Output current [ADC ticks] to [mA]
+#define FXP_IOUT_MA2ADC(x)  FXP_ScaleU16((x), IOUT_MA2ADC_FACTOR, IOUT_MA2ADC_BSFT) // Output current [mA] to [ADC ticks]
+#define FXP_VIN2VOUT(x)     FXP_ScaleU16((x), VIN2VOUT_NORMALIZATION, VIN2VOUT_NORM_BSFT) // Input voltage feedback normalized to output voltage feedback [ADC ticks]
+
+#endif	/* HAL_FIXED_POINT_SCALING_H */
+
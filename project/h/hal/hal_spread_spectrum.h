@@ -0,0 +1,139 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!hal_spread_spectrum.h
+ * ***************************************************************************
+ * File:   hal_spread_spectrum.h
+ * Author: M91406
+ *
+ * Description:
+ * Spread spectrum modulation of the switching frequency. The switching period
+ * is dithered around its nominal value by stepping through a table of periods
+ * precomputed at startup along a triangular or pseudo-random profile (see 
+ * SSM_PROFILE and SSM_MODULATION_DEPTH). Each table entry also holds the duty
+ * cycle limits and the ADC trigger position rescaled to its period, so that
+ * the control loop keeps the same duty ratio limits and sampling point while
+ * the period changes.
+ * 
+ * SSM_Execute() is called once per PWM cycle at the beginning of the control 
+ * loop interrupt service routine. It writes the next period to all PWM 
+ * generators of an update group and returns the table entry whose limits and
+ * trigger are to be used by the control loop. The new period is applied with
+ * the duty cycle by the same update request of the master generator 
+ * (e.g. HSPWM_GroupWrite() or MPH_Update()). Phase offsets of interleaved 
+ * generators need to follow the period of every cycle, which is done by 
+ * passing entry->period to MPH_Update().
+ * ***************************************************************************/
+
+#ifndef HAL_SPREAD_SPECTRUM_MODULATION_H
+#define	HAL_SPREAD_SPECTRUM_MODULATION_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "mcal/mcal.h"
+
+#define SSM_TABLE_SIZE          64  // Number of switching periods per modulation cycle (power of 2)
+
+/*!SSM_ENTRY_t
+ * ***********************************************************************************************
+ * Description:
+ * Switching period and the period-dependent settings of one step of the modulation profile.
+ * All values are given in [PWM ticks].
+ * ***********************************************************************************************/
+
+typedef struct {
+    uint16_t period; // Switching period
+    uint16_t duty_min; // Minimum duty cycle rescaled to this period
+    uint16_t duty_max; // Maximum duty cycle rescaled to this period
+    uint16_t trigger_a; // ADC trigger position rescaled to this period
+} SSM_ENTRY_t;
+
+/*!SPREAD_SPECTRUM_t
+ * ***********************************************************************************************
+ * Description:
+ * Spread spectrum modulation data structure. The table is filled by SSM_Initialize() and 
+ * indexed by SSM_Execute(). The additional last entry holds the nominal period and settings
+ * used while modulation is disabled. With a table of SSM_TABLE_SIZE entries, the modulation frequency 
+ * of the triangular profile is the switching frequency divided by SSM_TABLE_SIZE.
+ * ***********************************************************************************************/
+
+typedef struct {
+    SSM_ENTRY_t table[SSM_TABLE_SIZE + 1]; // Precomputed modulation profile followed by the nominal period
+    const HSPWM_GROUP_t* group; // PWM update group of all modulated generators
+    const SSM_ENTRY_t* entry; // Table entry of the most recent PWM cycle
+    uint16_t index; // Table index of the most recent PWM cycle
+    bool enable; // Enables/disables modulation (the nominal period is used when disabled)
+} SPREAD_SPECTRUM_t;
+
+/* ***********************************************************************************************
+ * PROTOTYPES
+ * ***********************************************************************************************/
+
+#if (USE_SPREAD_SPECTRUM_MODULATION == 1)
+
+extern volatile uint16_t SSM_Initialize(SPREAD_SPECTRUM_t* ssm, const HSPWM_GROUP_t* group, 
+            uint16_t period, uint16_t deviation, uint16_t duty_min, uint16_t duty_max, uint16_t trigger);
+
+/*!SSM_Execute()
+ * ************************************************************************************************
+ * Summary:
+ * Advances the modulation profile by one step
+ *
+ * Parameters:
+ * SPREAD_SPECTRUM_t* ssm: Pointer to the spread spectrum modulation data structure
+ *
+ * Returns:
+ * Table entry with period, duty cycle limits and ADC trigger position of the next PWM cycle
+ *
+ * Description:
+ * The table index is incremented and wrapped by a bit mask (or set to the nominal entry while
+ * modulation is disabled) and the period of the new entry is
+ * written to all generators of the update group. No data is computed at runtime. The period
+ * registers are not committed here; they are applied together with the duty cycle by the 
+ * update request of the control loop.
+ *
+ * ***********************************************************************************************/
+
+static inline const SSM_ENTRY_t* SSM_Execute(SPREAD_SPECTRUM_t* ssm)
+{
+    const HSPWM_HANDLE_t* const* pg = ssm->group->pg;
+    const SSM_ENTRY_t* entry;
+    uint16_t i;
+
+    if (ssm->enable)
+        ssm->index = ((ssm->index + 1) & (SSM_TABLE_SIZE - 1));
+    else
+        ssm->index = SSM_TABLE_SIZE;
+    entry = &ssm->table[ssm->index];
+
+    for (i = ssm->group->size; i > 0; i--)
+    { *(*pg++)->pgxper = entry->period; }
+
+    ssm->entry = entry;
+    return(entry);
+}
+
+#endif
+
+#endif	/* HAL_SPREAD_SPECTRUM_MODULATION_H */
+
@@ -0,0 +1,254 @@
+/* ****************************************************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * *****************************************************************************************************
+ * File:   devcfg_clocktree.h
+ * Author: M91406
+ * Comments: Compile-time clock tree solver resolving PLL and auxiliary PLL settings of the user 
+ *           clock configuration in devcfg_oscillator.h into constant register values and frequencies
+ * Revision history: 
+ *  10/18/2026  initial release
+ * *****************************************************************************************************/
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef MCAL_DEVICE_CONFIGURATION_CLOCKTREE_H
+#define	MCAL_DEVICE_CONFIGURATION_CLOCKTREE_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#include "mcal/config/devcfg_oscillator.h"
+
+/*!Clock Tree Solver
+ * ***********************************************************************************************
+ * Description:
+ * The clock tree solver determines the PLL divider and multiplier settings required to generate
+ * the user clock frequencies MAIN_CLOCK_FCY and AUX_CLOCK_AFPLLO from the internal FRC oscillator
+ * by the preprocessor. Results are available as constant register values and frequencies. No 
+ * oscillator register needs to be read back and no frequency needs to be calculated at runtime.
+ * 
+ *      FPFD   = FPLLI / N1                 (N1 = PLLPRE)
+ *      FVCO   = FPFD x M                   (M  = PLLFBDIV)
+ *      FPLLO  = FVCO / (N2 x N3)           (N2 = POST1DIV, N3 = POST2DIV)
+ *      FOSC   = FPLLO / 2
+ *      FCY    = FP = FOSC / 2
+ * 
+ * The input divider N1 is selected to operate the phase frequency detector at its lowest input 
+ * frequency (finest multiplier resolution). The post dividers N2 and N3 are selected by searching 
+ * the lowest post divider ratio resulting in a VCO frequency within its operating range and an 
+ * integer feedback multiplier M. The search starts at the post divider ratio of 1:2 used by the 
+ * default settings of the peripheral library, keeping the VCO off the lower end of its operating
+ * range. A ratio of 1:1 is only used if no other setting is valid. The auxiliary PLL is resolved 
+ * the same way.
+ * 
+ * Please note:
+ * Clock settings which cannot be generated exactly or which would operate the PLL outside of its
+ * operating ranges stop the build with an error message.
+ * ***********************************************************************************************/
+
+/* PLL operating ranges (see device data sheet, section electrical characteristics) */
+#define CLOCK_FRC_FREQUENCY     8000000UL   // Frequency of the internal FRC oscillator in [Hz]
+#define CLOCK_FPLLI_MIN         8000000UL   // Minimum PLL input frequency in [Hz]
+#define CLOCK_FPLLI_MAX         64000000UL  // Maximum PLL input frequency in [Hz]
+#define CLOCK_FPFD_MIN          8000000UL   // Minimum phase frequency detector input frequency in [Hz]
+#define CLOCK_FVCO_MIN          400000000UL // Minimum VCO frequency in [Hz]
+#define CLOCK_FVCO_MAX          1600000000UL // Maximum VCO frequency in [Hz]
+#define CLOCK_PLLFBDIV_MIN      16          // Minimum feedback divider setting
+#define CLOCK_PLLFBDIV_MAX      200         // Maximum feedback divider setting
+#define CLOCK_PLLPRE_MAX        8           // Maximum input divider setting
+#define CLOCK_FCY_MAX           100000000UL // Maximum instruction frequency in [Hz]
+#define CLOCK_AFPLLO_MAX        800000000UL // Maximum auxiliary PLL output frequency in [Hz]
+
+// Returns TRUE if output frequency FOUT can be generated with post dividers N2/N3 at an PFD frequency FPFD
+#define CLOCK_PLL_VALID(fout, fpfd, n2, n3)  ( \
+            (((fout) * (n2) * (n3)) >= CLOCK_FVCO_MIN) && (((fout) * (n2) * (n3)) <= CLOCK_FVCO_MAX) && \
+            ((((fout) * (n2) * (n3)) % (fpfd)) == 0) && \
+            ((((fout) * (n2) * (n3)) / (fpfd)) >= CLOCK_PLLFBDIV_MIN) && \
+            ((((fout) * (n2) * (n3)) / (fpfd)) <= CLOCK_PLLFBDIV_MAX) )
+
+/* ===========================================================================
+ * PLL INPUT DIVIDER N1 (FRC input is shared by main and auxiliary PLL)
+ * ===========================================================================*/
+
+#define CLOCK_FPLLI             CLOCK_FRC_FREQUENCY
+
+#if ((CLOCK_FPLLI < CLOCK_FPLLI_MIN) || (CLOCK_FPLLI > CLOCK_FPLLI_MAX))
+    #error "=== PLL input frequency is out of range ==="
+#endif
+
+#if ((CLOCK_FPLLI / CLOCK_FPFD_MIN) > CLOCK_PLLPRE_MAX)
+    #define CLOCK_PLL_N1        CLOCK_PLLPRE_MAX
+#else
+    #define CLOCK_PLL_N1        (CLOCK_FPLLI / CLOCK_FPFD_MIN)
+#endif
+
+#if ((CLOCK_FPLLI % CLOCK_PLL_N1) != 0)
+    #error "=== PLL input frequency cannot be divided down to an integer PFD frequency ==="
+#endif
+
+#define CLOCK_FPFD              (CLOCK_FPLLI / CLOCK_PLL_N1)    // Phase frequency detector input frequency in [Hz]
+#define CLOCK_APLL_N1           CLOCK_PLL_N1
+#define CLOCK_AFPFD             CLOCK_FPFD
+
+/* ===========================================================================
+ * MAIN PLL
+ * ===========================================================================*/
+
+#if ((MAIN_CLOCK_FCY == 0) || (MAIN_CLOCK_FCY > CLOCK_FCY_MAX))
+    #error "=== MAIN_CLOCK_FCY is out of range ==="
+#endif
+#if ((MAIN_CLOCK_VCODIV < 1) || (MAIN_CLOCK_VCODIV > 4))
+    #error "=== MAIN_CLOCK_VCODIV is out of range ==="
+#endif
+
+#define CLOCK_FPLLO             (4UL * MAIN_CLOCK_FCY)  // PLL output frequency in [Hz]
+
+#if   CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 2, 1)
+    #define CLOCK_PLL_N2    2
+    #define CLOCK_PLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 3, 1)
+    #define CLOCK_PLL_N2    3
+    #define CLOCK_PLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 4, 1)
+    #define CLOCK_PLL_N2    4
+    #define CLOCK_PLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 5, 1)
+    #define CLOCK_PLL_N2    5
+    #define CLOCK_PLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 6, 1)
+    #define CLOCK_PLL_N2    6
+    #define CLOCK_PLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 7, 1)
+    #define CLOCK_PLL_N2    7
+    #define CLOCK_PLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 4, 2)
+    #define CLOCK_PLL_N2    4
+    #define CLOCK_PLL_N3    2
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 3, 3)
+    #define CLOCK_PLL_N2    3
+    #define CLOCK_PLL_N3    3
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 5, 2)
+    #define CLOCK_PLL_N2    5
+    #define CLOCK_PLL_N3    2
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 6, 2)
+    #define CLOCK_PLL_N2    6
+    #define CLOCK_PLL_N3    2
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 7, 2)
+    #define CLOCK_PLL_N2    7
+    #define CLOCK_PLL_N3    2
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 5, 3)
+    #define CLOCK_PLL_N2    5
+    #define CLOCK_PLL_N3    3
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 4, 4)
+    #define CLOCK_PLL_N2    4
+    #define CLOCK_PLL_N3    4
+#elif CLOCK_PLL_VALID(CLOCK_FPLLO, CLOCK_FPFD, 1, 1)
+    #define CLOCK_PLL_N2    1
+    #define CLOCK_PLL_N3    1
+#else
+    #error "=== MAIN_CLOCK_FCY cannot be generated by the PLL within its operating ranges ==="
+#endif
+
+#define CLOCK_PLL_M             ((CLOCK_FPLLO * CLOCK_PLL_N2 * CLOCK_PLL_N3) / CLOCK_FPFD)
+#define CLOCK_PLL_VCODIV        MAIN_CLOCK_VCODIV
+
+#define CLOCK_FVCO              (CLOCK_FPFD * CLOCK_PLL_M)          // VCO frequency in [Hz]
+#define CLOCK_FVCODIV           (CLOCK_FVCO / CLOCK_PLL_VCODIV)     // VCO divider output frequency in [Hz]
+#define CLOCK_FOSC              (CLOCK_FPLLO / 2UL)                 // Oscillator frequency in [Hz]
+#define CLOCK_FP                (CLOCK_FOSC / 2UL)                  // Peripheral bus frequency in [Hz]
+#define CLOCK_FCY               CLOCK_FP                            // Instruction frequency in [Hz] (DOZE disabled)
+#define CLOCK_TCY               (float)(1.0 / (float)CLOCK_FCY)     // Instruction period in [sec]
+
+#define CLOCK_REG_CLKDIV_PLLPRE CLOCK_PLL_N1    // CLKDIV<3:0> PLLPRE
+#define CLOCK_REG_PLLFBD        CLOCK_PLL_M     // PLLFBD<7:0> PLLFBDIV
+#define CLOCK_REG_PLLDIV        (uint16_t)(((4 - CLOCK_PLL_VCODIV) << 8) | (CLOCK_PLL_N2 << 4) | CLOCK_PLL_N3)
+
+/* ===========================================================================
+ * AUXILIARY PLL
+ * ===========================================================================*/
+
+#if ((AUX_CLOCK_AFPLLO == 0) || (AUX_CLOCK_AFPLLO > CLOCK_AFPLLO_MAX))
+    #error "=== AUX_CLOCK_AFPLLO is out of range ==="
+#endif
+#if ((AUX_CLOCK_AVCODIV < 1) || (AUX_CLOCK_AVCODIV > 4))
+    #error "=== AUX_CLOCK_AVCODIV is out of range ==="
+#endif
+
+#define CLOCK_AFPLLO            AUX_CLOCK_AFPLLO    // Auxiliary PLL output frequency in [Hz]
+
+#if   CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 2, 1)
+    #define CLOCK_APLL_N2    2
+    #define CLOCK_APLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 3, 1)
+    #define CLOCK_APLL_N2    3
+    #define CLOCK_APLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 4, 1)
+    #define CLOCK_APLL_N2    4
+    #define CLOCK_APLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 5, 1)
+    #define CLOCK_APLL_N2    5
+    #define CLOCK_APLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 6, 1)
+    #define CLOCK_APLL_N2    6
+    #define CLOCK_APLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 7, 1)
+    #define CLOCK_APLL_N2    7
+    #define CLOCK_APLL_N3    1
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 4, 2)
+    #define CLOCK_APLL_N2    4
+    #define CLOCK_APLL_N3    2
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 3, 3)
+    #define CLOCK_APLL_N2    3
+    #define CLOCK_APLL_N3    3
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 5, 2)
+    #define CLOCK_APLL_N2    5
+    #define CLOCK_APLL_N3    2
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 6, 2)
+    #define CLOCK_APLL_N2    6
+    #define CLOCK_APLL_N3    2
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 7, 2)
+    #define CLOCK_APLL_N2    7
+    #define CLOCK_APLL_N3    2
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 5, 3)
+    #define CLOCK_APLL_N2    5
+    #define CLOCK_APLL_N3    3
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 4, 4)
+    #define CLOCK_APLL_N2    4
+    #define CLOCK_APLL_N3    4
+#elif CLOCK_PLL_VALID(CLOCK_AFPLLO, CLOCK_AFPFD, 1, 1)
+    #define CLOCK_APLL_N2    1
+    #define CLOCK_APLL_N3    1
+#else
+    #error "=== AUX_CLOCK_AFPLLO cannot be generated by the auxiliary PLL within its operating ranges ==="
+#endif
+
+#define CLOCK_APLL_M            ((CLOCK_AFPLLO * CLOCK_APLL_N2 * CLOCK_APLL_N3) / CLOCK_AFPFD)
+#define CLOCK_APLL_AVCODIV      AUX_CLOCK_AVCODIV
+
+#define CLOCK_AFVCO             (CLOCK_AFPFD * CLOCK_APLL_M)        // Auxiliary VCO frequency in [Hz]
+#define CLOCK_AFVCODIV          (CLOCK_AFVCO / CLOCK_APLL_AVCODIV)  // Auxiliary VCO divider output frequency in [Hz]
+
+#define CLOCK_REG_ACLKCON1      (uint16_t)(0x8000 | 0x0100 | CLOCK_APLL_N1)  // APLLEN=1, FRCSEL=FRC, APLLPRE=N1
+#define CLOCK_REG_APLLFBD1      CLOCK_APLL_M    // APLLFBD1<7:0> APLLFBDIV
+#define CLOCK_REG_APLLDIV1      (uint16_t)(((4 - CLOCK_APLL_AVCODIV) << 8) | (CLOCK_APLL_N2 << 4) | CLOCK_APLL_N3)
+
+#endif	/* MCAL_DEVICE_CONFIGURATION_CLOCKTREE_H */
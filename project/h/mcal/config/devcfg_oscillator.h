@@ -37,17 +37,36 @@
 
 #include "mcal/mcal.h"
 
-// ToDo: Add your user setting here
+/*!Clock Tree Configuration
+ * ***********************************************************************************************
+ * Description:
+ * Requested clock frequencies of the main and the auxiliary clock domain. The PLL settings 
+ * required to generate these frequencies from the internal FRC oscillator are determined at 
+ * compile time by the clock tree solver in devcfg_clocktree.h, which also rejects settings 
+ * violating the PLL operating ranges given in the device data sheet.
+ * 
+ * MAIN_CLOCK_FCY:      Instruction frequency in [Hz] (max. 100 MIPS)
+ * MAIN_CLOCK_VCODIV:   Divider of the PLL VCO output clock FVCODIV (1, 2, 3 or 4)
+ * AUX_CLOCK_AFPLLO:    Auxiliary PLL output frequency in [Hz] used by PWM, ADC and DAC (max. 800 MHz)
+ * AUX_CLOCK_AVCODIV:   Divider of the auxiliary PLL VCO output clock AFVCODIV (1, 2, 3 or 4)
+ * 
+ * Please note:
+ * Only frequencies which can be generated exactly are accepted. 
+ * ***********************************************************************************************/
 
 #if defined (__P33SMPS_CK__) || defined (__P33SMPS_CH_SLV__)
 
-    #define MAIN_CLOCK_SPEED    CPU_SPEED_100_MIPS
-    #define AUX_CLOCK_SPEED     AFPLLO_500_MHZ
+    #define MAIN_CLOCK_FCY      100000000UL // CPU speed of 100 MIPS
+    #define MAIN_CLOCK_VCODIV   4
+    #define AUX_CLOCK_AFPLLO    500000000UL // AFPLLO of 500 MHz (required for high resolution PWM)
+    #define AUX_CLOCK_AVCODIV   4
 
 #elif defined (__P33SMPS_CH_MSTR__)
 
-    #define MAIN_CLOCK_SPEED    CPU_SPEED_90_MIPS
-    #define AUX_CLOCK_SPEED     AFPLLO_500_MHZ
+    #define MAIN_CLOCK_FCY      90000000UL  // CPU speed of 90 MIPS
+    #define MAIN_CLOCK_VCODIV   4
+    #define AUX_CLOCK_AFPLLO    500000000UL // AFPLLO of 500 MHz (required for high resolution PWM)
+    #define AUX_CLOCK_AVCODIV   4
 
 #else
     #pragma message "=== selected device is not defined and may not be supported ==="
@@ -0,0 +1,225 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!drv_hsadc.h
+ * *************************************************************************** 
+ * File:   drv_hsadc.h
+ * Author: M91406
+ *
+ * Description:
+ * Extensions of the high speed ADC driver. In streaming mode, the conversion
+ * results of a selected ADC input are moved by a DMA channel into a ping-pong 
+ * buffer without CPU involvement. The DMA channel raises an interrupt when the
+ * first half (ping) and the second half (pong) of the buffer have been filled.
+ * The completed half is published to tasks through a zero-copy reader API 
+ * while the DMA keeps filling the other half. Logging, RMS calculations or 
+ * fault monitors can then process blocks of samples in the task scheduler 
+ * without per-sample interrupt overhead.
+ * 
+ * The decimation pipeline averages slowly changing signals (e.g. telemetry of
+ * temperatures or supply voltages) by a power-of-2 ratio. Each channel is 
+ * assigned to one of the ADC digital filters (ADFL) in averaging mode while 
+ * available. Remaining channels fall back to a first order software CIC stage
+ * (integrate and dump), which consumes the blocks of an ADC stream in the task
+ * scheduler. Both types publish their results the same way.
+ * ***************************************************************************/
+
+#ifndef MCAL_DRIVER_HSADC_H
+#define	MCAL_DRIVER_HSADC_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#define HSADC_DMA_COUNT             6       // Number of DMA channels available
+#define HSADC_DMACON_DMAEN          0x8000  // DMACON: DMA module enable bit
+#define HSADC_DMACH_CHEN            0x0001  // DMACHn: DMA channel enable bit
+#define HSADC_DMACH_TRMODE_RPT_CONT 0x000C  // DMACHn: TRMODE<1:0> = repeated continuous transfer mode
+#define HSADC_DMACH_DAMODE_INC      0x0010  // DMACHn: DAMODE<1:0> = destination address incremented
+#define HSADC_DMACH_RELOAD          0x0200  // DMACHn: reload source, destination and count at the end of a block
+#define HSADC_DMAINT_CHSEL_MASK     0x7F00  // DMAINTn: DMA channel trigger selection bits CHSEL<6:0>
+#define HSADC_DMAINT_DONEIF         0x0020  // DMAINTn: DMA transfer complete interrupt flag bit
+#define HSADC_DMAINT_HALFIF         0x0010  // DMAINTn: DMA 50% watermark interrupt flag bit
+#define HSADC_DMAINT_OVRUNIF        0x0008  // DMAINTn: DMA channel overrun interrupt flag bit
+#define HSADC_DMAINT_HALFEN         0x0001  // DMAINTn: 50% watermark interrupt enable bit
+#define HSADC_ADFL_COUNT            4       // Number of ADC digital filters available
+#define HSADC_ADFLCON_FLEN          0x8000  // ADFLxCON: digital filter enable bit
+#define HSADC_ADFLCON_MODE_AVERAGE  0x6000  // ADFLxCON: MODE<1:0> = averaging mode
+#define HSADC_ADFLCON_OVRSAM_POS    10      // ADFLxCON: bit position of OVRSAM<2:0> (averaging 2x = 0b000 ... 256x = 0b111)
+#define HSADC_ADFLCON_RDY           0x0100  // ADFLxCON: digital filter result ready bit
+#define HSADC_ADFLCON_FLCHSEL_MASK  0x001F  // ADFLxCON: digital filter analog input selection bits FLCHSEL<4:0>
+#define HSADC_DECIMATION_MAX        256     // Maximum decimation ratio
+
+/*!HSADC_STREAM_ENABLE
+ * ***********************************************************************************************
+ * Description:
+ * When enabled, the DMA interrupt service routines of the first HSADC_STREAM_DMA_COUNT DMA 
+ * channels are compiled and used by ADC streams. DMA channels above this range remain 
+ * available to other drivers.
+ * ***********************************************************************************************/
+
+#define HSADC_STREAM_ENABLE         0   // Enable/Disable DMA based ADC streaming
+#define HSADC_STREAM_DMA_COUNT      2   // Number of DMA channels reserved for ADC streams (DMA0, DMA1, ...)
+#define HSADC_STREAM_ISR_PRIORITY   1   // DMA interrupt priority of ADC streams
+
+/*!HSADC_STREAM_t
+ * ***********************************************************************************************
+ * Description:
+ * ADC stream moving the results of one ADC input into a ping-pong buffer of 2 x block_size 
+ * samples. Every completed half of the buffer increments the block sequence counter. Odd 
+ * sequence numbers refer to the first half (ping), even numbers to the second half (pong).
+ * A completed block remains valid until the DMA has filled the other half, i.e. for the 
+ * duration of one block. 
+ * 
+ * The optional callback is called from the DMA interrupt service routine for each completed
+ * block and should only signal the event to a task (e.g. set a flag or queue a task).
+ * ***********************************************************************************************/
+
+struct HSADC_STREAM_s;
+typedef void (*HSADC_STREAM_CALLBACK_t)(struct HSADC_STREAM_s* stream, const uint16_t* block);
+
+typedef struct HSADC_STREAM_s {
+    volatile uint16_t* dmachn; // DMACHn: DMA channel control register
+    volatile uint16_t* dmaintn; // DMAINTn: DMA channel interrupt control register
+    uint16_t channel; // Index of the DMA channel (0 = DMA0, 1 = DMA1, etc.)
+    uint16_t* buffer; // Ping-pong buffer of 2 x block_size samples
+    uint16_t block_size; // Number of samples per block
+    volatile uint16_t sequence; // Number of completed blocks
+    volatile uint16_t overruns; // Number of blocks overwritten before they have been released or skipped by a reader
+    volatile uint16_t dma_overruns; // Number of ADC results lost by the DMA channel
+    HSADC_STREAM_CALLBACK_t block_ready; // Block completion callback (NULL = none)
+} HSADC_STREAM_t;
+
+/*!HSADC_DECIMATOR_t
+ * ***********************************************************************************************
+ * Description:
+ * Decimation channel averaging 'ratio' samples of one ADC input into one result. The result 
+ * is published together with an incremented sequence number, allowing consumers to detect 
+ * new results at the declared rate (ADC sample rate / ratio) by comparing sequence numbers.
+ * 
+ *     - HSADC_DECIMATOR_HARDWARE: averaged by an ADC digital filter, polled by 
+ *                                 HSADC_DecimatorExecute()
+ *     - HSADC_DECIMATOR_SOFTWARE: averaged by a first order CIC stage fed with the blocks of 
+ *                                 an ADC stream by HSADC_DecimatorExecute() or with single 
+ *                                 samples by HSADC_DecimatorPush()
+ * ***********************************************************************************************/
+
+typedef enum {
+    HSADC_DECIMATOR_NONE     = 0, // Decimation channel is not initialized
+    HSADC_DECIMATOR_HARDWARE = 1, // Decimation by an ADC digital filter
+    HSADC_DECIMATOR_SOFTWARE = 2  // Decimation by software CIC stage
+} HSADC_DECIMATOR_TYPE_e;
+
+typedef struct {
+    HSADC_DECIMATOR_TYPE_e type; // Decimator type allocated by HSADC_DecimatorInitialize()
+    volatile uint16_t* adflxcon; // ADFLxCON: digital filter control register (hardware only)
+    volatile uint16_t* adflxdat; // ADFLxDAT: digital filter result register (hardware only)
+    uint16_t filter; // Index of the digital filter (hardware only)
+    HSADC_STREAM_t* stream; // ADC stream of the input (software only, NULL = HSADC_DecimatorPush())
+    uint16_t stream_sequence; // Sequence number of the stream block processed last (software only)
+    uint32_t integrator; // CIC integrator (software only)
+    uint16_t count; // Number of integrated samples (software only)
+    uint16_t ratio; // Decimation ratio (2, 4, 8, ... HSADC_DECIMATION_MAX)
+    uint16_t shift; // log2(ratio)
+    volatile uint16_t result; // Most recent decimated result
+    volatile uint16_t sequence; // Number of decimated results
+} HSADC_DECIMATOR_t;
+
+/* ***********************************************************************************************
+ * PROTOTYPES
+ * ***********************************************************************************************/
+
+extern volatile uint16_t HSADC_DecimatorInitialize(HSADC_DECIMATOR_t* dec, uint16_t input, 
+            uint16_t ratio, HSADC_STREAM_t* stream);
+extern volatile uint16_t HSADC_DecimatorExecute(HSADC_DECIMATOR_t* dec);
+extern volatile uint16_t HSADC_DecimatorRelease(HSADC_DECIMATOR_t* dec);
+
+// Integrates one sample into a software decimation channel (e.g. from an existing ADC ISR)
+static inline void HSADC_DecimatorPush(HSADC_DECIMATOR_t* dec, uint16_t sample)
+{
+    dec->integrator += sample;
+    if (++dec->count < dec->ratio) return;
+    
+    dec->result = (uint16_t)(dec->integrator >> dec->shift);
+    dec->sequence++;
+    dec->integrator = 0;
+    dec->count = 0;
+}
+
+#if (HSADC_STREAM_ENABLE == 1)
+
+extern volatile uint16_t HSADC_StreamInitialize(HSADC_STREAM_t* stream, uint16_t channel, 
+            volatile uint16_t* adcbuf, uint16_t trigger, uint16_t* buffer, uint16_t block_size);
+extern volatile uint16_t HSADC_StreamStart(HSADC_STREAM_t* stream);
+extern volatile uint16_t HSADC_StreamStop(HSADC_STREAM_t* stream);
+
+/* ***********************************************************************************************
+ * ZERO-COPY READER FUNCTIONS
+ * ***********************************************************************************************/
+
+/*!HSADC_StreamGetBlock()
+ * ************************************************************************************************
+ * Summary:
+ * Returns the most recently completed block of samples
+ *
+ * Parameters:
+ * HSADC_STREAM_t* stream: Pointer to the ADC stream
+ * uint16_t* sequence:     Sequence number of the block read last by this reader (updated)
+ *
+ * Returns:
+ * Pointer to block_size samples in the stream buffer, NULL when no new block is available
+ *
+ * Description:
+ * The block is not copied. The reader processes the samples in place and calls 
+ * HSADC_StreamRelease() with the returned sequence number to verify that the block has not 
+ * been overwritten in the meantime. Multiple readers can read the same stream, each using its
+ * own sequence number, which has to be initialized with the recent sequence number of the 
+ * stream. 
+ * 
+ * Only the most recent block is returned. If the reader has fallen behind by more than one 
+ * block, the blocks in between have been overwritten and are counted as overruns.
+ *
+ * ***********************************************************************************************/
+
+static inline const uint16_t* HSADC_StreamGetBlock(HSADC_STREAM_t* stream, uint16_t* sequence)
+{
+    uint16_t seq = stream->sequence; // single read, sequence and block are derived from one value
+
+    if (seq == *sequence) return(NULL);
+    if ((uint16_t)(seq - *sequence) > 1)
+        stream->overruns += (uint16_t)(seq - *sequence - 1); // blocks skipped by this reader
+    *sequence = seq;
+
+    return((seq & 0x0001) ? stream->buffer : (stream->buffer + stream->block_size));
+}
+
+// Returns TRUE if the block read by HSADC_StreamGetBlock() has remained valid during processing
+static inline bool HSADC_StreamRelease(HSADC_STREAM_t* stream, uint16_t sequence)
+{
+    if (stream->sequence == sequence) return(true);
+    stream->overruns++;
+    return(false);
+}
+
+#endif
+
+#endif	/* MCAL_DRIVER_HSADC_H */
+
@@ -0,0 +1,237 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!drv_hspwm.h
+ * *************************************************************************** 
+ * File:   drv_hspwm.h
+ * Author: M91406
+ *
+ * Description:
+ * Fast-update API of the high speed PWM module. Register addresses of a PWM 
+ * generator are resolved once when its handle is initialized. Duty cycle, 
+ * period, phase and trigger updates are static inline functions, which compile
+ * into a pointer load and a single register write, without computing register
+ * offsets or reading back the written value as done by the peripheral library
+ * (e.g. hspwm_set_duty_cycle()). These functions are meant to be used in 
+ * control loop interrupt service routines.
+ * 
+ * Multiple PWM generators can be combined in update groups, where one master
+ * generator broadcasts its update request to all slaved generators, so that 
+ * new data of all generators of the group is applied in the same PWM cycle.
+ * ***************************************************************************/
+
+#ifndef MCAL_DRIVER_HSPWM_H
+#define	MCAL_DRIVER_HSPWM_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+#define HSPWM_PG_COUNT              8   // Number of PWM generators available
+#define HSPWM_PGSTAT_UPDREQ         0x0008  // PGxSTAT: PWM data register update request bit
+#define HSPWM_PGSTAT_UPDATE         0x0010  // PGxSTAT: PWM data register update pending status bit
+#define HSPWM_PGCONL_ON             0x8000  // PGxCONL: PWM generator enable bit
+#define HSPWM_PGCONH_MSTEN          0x0800  // PGxCONH: master update enable bit (PGCON_MSTEN_BROADCAST)
+#define HSPWM_PGCONH_UPDMOD_MASK    0x0700  // PGxCONH: PWM buffer update mode selection bits UPDMOD<2:0>
+#define HSPWM_PGCONH_UPDMOD_SLAVED  0x0200  // PGxCONH: UPDMOD<1> selecting slaved update modes
+#define HSPWM_GROUP_SIZE_MAX        HSPWM_PG_COUNT  // Maximum number of PWM generators per update group
+
+/*!HSPWM_BENCHMARK_ENABLE
+ * ***********************************************************************************************
+ * Description:
+ * When enabled, the function HSPWM_Benchmark() is compiled, comparing the instruction cycles 
+ * of one duty cycle update using the peripheral library function hspwm_set_duty_cycle() with 
+ * one update using the PWM generator handle. Results are stored in hspwm_benchmark.
+ * ***********************************************************************************************/
+
+#define HSPWM_BENCHMARK_ENABLE      0   // Enable/Disable PWM update benchmark
+#define HSPWM_BENCHMARK_REPEAT      16  // Number of updates averaged per benchmark
+
+/*!HSPWM_HANDLE_t
+ * ***********************************************************************************************
+ * Description:
+ * Handle of a PWM generator holding the addresses of its time base and data registers. The 
+ * handle is populated once by HSPWM_HandleInitialize() and is declared without the volatile 
+ * qualifier, allowing the compiler to keep register addresses in working registers across 
+ * multiple updates within the same function. The registers themselves remain volatile.
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint16_t* pgxconl; // PGxCONL: PWM generator control register (ON bit)
+    volatile uint16_t* pgxconh; // PGxCONH: PWM generator control register (MSTEN and UPDMOD bits)
+    volatile uint16_t* pgxstat; // PGxSTAT: PWM generator status register (UPDREQ bit)
+    volatile uint16_t* pgxphase; // PGxPHASE: PWM phase register
+    volatile uint16_t* pgxdc; // PGxDC: PWM duty cycle register
+    volatile uint16_t* pgxdca; // PGxDCA: PWM duty cycle adjustment register
+    volatile uint16_t* pgxper; // PGxPER: PWM period register
+    volatile uint16_t* pgxtriga; // PGxTRIGA: PWM trigger A register
+    volatile uint16_t* pgxtrigb; // PGxTRIGB: PWM trigger B register
+    volatile uint16_t* pgxtrigc; // PGxTRIGC: PWM trigger C register
+    uint16_t instance; // Index of the PWM generator (1 = PG1, 2 = PG2, etc.)
+} HSPWM_HANDLE_t;
+
+/*!HSPWM_UPDATE_MODE_e
+ * ***********************************************************************************************
+ * Description:
+ * Update mode of a PWM update group selecting when new data is transferred from the data 
+ * registers into the PWM generators:
+ * 
+ *     - HSPWM_UPDATE_SOC: at the start of the next PWM cycle of the master generator
+ *     - HSPWM_UPDATE_IMMEDIATE: immediately when the update is requested
+ * 
+ * Slaved generators are configured for the slaved version of the selected mode.
+ * ***********************************************************************************************/
+
+typedef enum {
+    HSPWM_UPDATE_SOC        = 0b000, // SOC update (slaved SOC update for slave generators)
+    HSPWM_UPDATE_IMMEDIATE  = 0b001  // Immediate update (slaved immediate update for slave generators)
+} HSPWM_UPDATE_MODE_e;
+
+/*!HSPWM_GROUP_t
+ * ***********************************************************************************************
+ * Description:
+ * PWM update group of up to HSPWM_GROUP_SIZE_MAX generators. pg[0] is the master generator 
+ * broadcasting its update request (MSTEN = 1), pg[1]...pg[size-1] are slaved generators 
+ * (UPDMOD = slaved SOC/immediate update). Data of all generators is written by 
+ * HSPWM_GroupWrite() and committed by a single UPDREQ write to the master generator. 
+ * 
+ * Please Note:
+ * The update request of a master generator (MSTEN = 1) is broadcast to every PWM generator of 
+ * the device configured for a slaved update mode, not only to the generators added to its group. 
+ * Hence only one independent update group can exist per device. Generators outside of the group 
+ * need to use a non-slaved update mode and request their updates individually.
+ * ***********************************************************************************************/
+
+typedef struct {
+    const HSPWM_HANDLE_t* pg[HSPWM_GROUP_SIZE_MAX]; // Handles of the master (pg[0]) and slaved generators
+    uint16_t size; // Number of generators in the group
+    HSPWM_UPDATE_MODE_e mode; // Update mode of the group
+} HSPWM_GROUP_t;
+
+/*!HSPWM_GROUP_DATA_t
+ * ***********************************************************************************************
+ * Description:
+ * Set of data registers of one PWM generator updated every cycle. Arrays of this type hold one
+ * entry per generator in the order of the update group.
+ * ***********************************************************************************************/
+
+typedef struct {
+    uint16_t duty_cycle; // PGxDC: duty cycle
+    uint16_t phase; // PGxPHASE: phase
+    uint16_t trigger_a; // PGxTRIGA: trigger A (e.g. ADC trigger)
+    uint16_t trigger_b; // PGxTRIGB: trigger B (e.g. ADC trigger)
+} HSPWM_GROUP_DATA_t;
+
+/*!HSPWM_BENCHMARK_t
+ * ***********************************************************************************************
+ * Description:
+ * Results of HSPWM_Benchmark() in instruction cycles per update, excluding timer readout overhead.
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint16_t plib_cycles; // Cycles of one hspwm_set_duty_cycle() call (PGxDC and PGxDCA)
+    volatile uint16_t handle_cycles; // Cycles of one handle based update (PGxDC and PGxDCA)
+    volatile uint16_t handle_dc_cycles; // Cycles of one handle based duty cycle update (PGxDC only)
+} HSPWM_BENCHMARK_t;
+
+/* ***********************************************************************************************
+ * PROTOTYPES
+ * ***********************************************************************************************/
+extern volatile uint16_t HSPWM_HandleInitialize(HSPWM_HANDLE_t* pwm, uint16_t instance);
+extern volatile uint16_t HSPWM_GroupInitialize(HSPWM_GROUP_t* group, const HSPWM_HANDLE_t* master, HSPWM_UPDATE_MODE_e mode);
+extern volatile uint16_t HSPWM_GroupAddSlave(HSPWM_GROUP_t* group, const HSPWM_HANDLE_t* slave);
+
+#if (HSPWM_BENCHMARK_ENABLE == 1)
+extern volatile HSPWM_BENCHMARK_t hspwm_benchmark;
+extern volatile uint16_t HSPWM_Benchmark(HSPWM_HANDLE_t* pwm);
+#endif
+
+/* ***********************************************************************************************
+ * FAST UPDATE FUNCTIONS
+ * ***********************************************************************************************/
+
+static inline void HSPWM_SetDutyCycle(const HSPWM_HANDLE_t* pwm, uint16_t duty_cycle)
+{ *pwm->pgxdc = duty_cycle; }
+
+static inline void HSPWM_SetDutyCycleAdjustment(const HSPWM_HANDLE_t* pwm, uint16_t adjustment)
+{ *pwm->pgxdca = adjustment; }
+
+static inline void HSPWM_SetPeriod(const HSPWM_HANDLE_t* pwm, uint16_t period)
+{ *pwm->pgxper = period; }
+
+static inline void HSPWM_SetPhase(const HSPWM_HANDLE_t* pwm, uint16_t phase)
+{ *pwm->pgxphase = phase; }
+
+static inline void HSPWM_SetTriggerA(const HSPWM_HANDLE_t* pwm, uint16_t trigger)
+{ *pwm->pgxtriga = trigger; }
+
+static inline void HSPWM_SetTriggerB(const HSPWM_HANDLE_t* pwm, uint16_t trigger)
+{ *pwm->pgxtrigb = trigger; }
+
+static inline void HSPWM_SetTriggerC(const HSPWM_HANDLE_t* pwm, uint16_t trigger)
+{ *pwm->pgxtrigc = trigger; }
+
+static inline uint16_t HSPWM_GetDutyCycle(const HSPWM_HANDLE_t* pwm)
+{ return(*pwm->pgxdc); }
+
+static inline uint16_t HSPWM_GetPeriod(const HSPWM_HANDLE_t* pwm)
+{ return(*pwm->pgxper); }
+
+// Requests the transfer of all PWM data registers at the next update event (sets UPDREQ)
+static inline void HSPWM_RequestUpdate(const HSPWM_HANDLE_t* pwm)
+{ *pwm->pgxstat |= HSPWM_PGSTAT_UPDREQ; }
+
+// Returns TRUE while a requested data register update has not been applied yet
+static inline bool HSPWM_IsUpdatePending(const HSPWM_HANDLE_t* pwm)
+{ return((bool)(*pwm->pgxstat & HSPWM_PGSTAT_UPDATE)); }
+
+/* ***********************************************************************************************
+ * UPDATE GROUP FUNCTIONS
+ * ***********************************************************************************************/
+
+// Commits the data registers of all generators of the group by a single update request of the master
+static inline void HSPWM_GroupCommit(const HSPWM_GROUP_t* group)
+{ *group->pg[0]->pgxstat |= HSPWM_PGSTAT_UPDREQ; }
+
+// Returns TRUE while the most recent update of the group has not been applied yet
+static inline bool HSPWM_GroupIsUpdatePending(const HSPWM_GROUP_t* group)
+{ return((bool)(*group->pg[0]->pgxstat & HSPWM_PGSTAT_UPDATE)); }
+
+// Writes duty cycle, phase and triggers A/B of all generators of the group and commits the update
+static inline void HSPWM_GroupWrite(const HSPWM_GROUP_t* group, const HSPWM_GROUP_DATA_t* data)
+{
+    const HSPWM_HANDLE_t* const* pg = group->pg;
+    uint16_t i;
+    
+    for (i = group->size; i > 0; i--)
+    {
+        *(*pg)->pgxdc = data->duty_cycle;
+        *(*pg)->pgxphase = data->phase;
+        *(*pg)->pgxtriga = data->trigger_a;
+        *(*pg)->pgxtrigb = data->trigger_b;
+        pg++;
+        data++;
+    }
+    
+    *group->pg[0]->pgxstat |= HSPWM_PGSTAT_UPDREQ;
+}
+
+#endif	/* MCAL_DRIVER_HSPWM_H */
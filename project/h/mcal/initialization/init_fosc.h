@@ -38,6 +38,7 @@
  * ***********************************************************************************************/
 extern volatile uint16_t MainOscillator_Initialize(void);
 extern volatile uint16_t AuxOscillator_Initialize(void);
+extern volatile uint16_t SystemFrequencies_Initialize(void);
 
 #endif	/* MCAL_OSCILLATOR_INITIALIZATION_H */
 
@@ -0,0 +1,93 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!init_regimage.h
+ * *************************************************************************** 
+ * File:   init_regimage.h
+ * Author: M91406
+ *
+ * Description:
+ * Single-pass peripheral configuration from constant register images. A 
+ * register image is a list of blocks of consecutive special function registers
+ * and the values they need to be loaded with. Images are generated on the host
+ * by tools/register_image_generator.py, applied by a tight copy loop and 
+ * verified by one checksum over the register readback.
+ * ***************************************************************************/
+
+#ifndef MCAL_INITIALIZATION_REGISTER_IMAGE_H
+#define	MCAL_INITIALIZATION_REGISTER_IMAGE_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+/*!REGISTER_IMAGE_BLOCK_t
+ * ***********************************************************************************************
+ * Description:
+ * A block of consecutive 16-bit special function registers starting at address <sfr>. Register
+ * n of the block is loaded with value[n]. Only bits set in mask[n] are covered by the readback 
+ * verification, excluding status flags, write-only bits and bits changed by hardware or by the 
+ * application during operation.
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile uint16_t* sfr; // Address of the first register of the block
+    uint16_t count; // Number of consecutive registers
+    const uint16_t* value; // Register values
+    const uint16_t* mask; // Readback verification masks
+} REGISTER_IMAGE_BLOCK_t;
+
+/*!REGISTER_IMAGE_t
+ * ***********************************************************************************************
+ * Description:
+ * Register image of one peripheral. Blocks are written in the given order, hence enable bits 
+ * (e.g. ON, ADON) have to be placed in a separate, final block. The checksum <crc> is calculated 
+ * by the image generator over all register values masked by their verification masks, using the 
+ * same CRC-16-CCITT algorithm as RegisterImage_Verify().
+ * ***********************************************************************************************/
+
+typedef struct {
+    const REGISTER_IMAGE_BLOCK_t* block; // List of register blocks
+    uint16_t size; // Number of register blocks
+    uint16_t crc; // Expected checksum of the masked register readback
+} REGISTER_IMAGE_t;
+
+/*!register_image_list[]
+ * ***********************************************************************************************
+ * Description:
+ * The register_image_list[] array is a list of all register images applied during device 
+ * initialization. It is generated from src/apl/config/UserRegisterImages.txt into 
+ * UserRegisterImages.c.
+ * ***********************************************************************************************/
+
+extern const REGISTER_IMAGE_t *register_image_list[];
+extern const uint16_t register_image_list_size;
+
+/* ***********************************************************************************************
+ * PROTOTYPES
+ * ***********************************************************************************************/
+extern volatile uint16_t RegisterImage_Apply(const REGISTER_IMAGE_t* image);
+extern volatile uint16_t RegisterImage_Verify(const REGISTER_IMAGE_t* image);
+extern volatile uint16_t RegisterImage_ApplyAll(void);
+extern volatile uint16_t RegisterImage_VerifyAll(void);
+extern volatile uint16_t RegisterImage_RestoreAll(void);
+
+#endif	/* MCAL_INITIALIZATION_REGISTER_IMAGE_H */
@@ -0,0 +1,93 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!init_sequence.h
+ * *************************************************************************** 
+ * File:   init_sequence.h
+ * Author: M91406
+ *
+ * Description:
+ * Non-blocking, resumable initialization sequences of peripherals which need
+ * to wait for hardware ready bits (auxiliary PLL lock, ADC core power-up,
+ * high-resolution PWM ready). 
+ * ***************************************************************************/
+
+#ifndef MCAL_INITIALIZATION_SEQUENCE_H
+#define	MCAL_INITIALIZATION_SEQUENCE_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+/*!INIT_SEQUENCE_STATE_e
+ * ***********************************************************************************************
+ * Description:
+ * States of a peripheral initialization sequence:
+ * 
+ *     - INIT_SEQ_STATE_OFF: sequence has not been started (peripheral not used)
+ *     - INIT_SEQ_STATE_BUSY: sequence has been started and waits for hardware ready bits
+ *     - INIT_SEQ_STATE_READY: peripheral is ready to be used
+ *     - INIT_SEQ_STATE_TIMEOUT: hardware ready bits have not been set in time
+ *     - INIT_SEQ_STATE_ERROR: peripheral has reported an error
+ * 
+ * ***********************************************************************************************/
+
+typedef enum {
+    INIT_SEQ_STATE_OFF      = 0, // Sequence has not been started
+    INIT_SEQ_STATE_BUSY     = 1, // Sequence is waiting for hardware ready bits
+    INIT_SEQ_STATE_READY    = 2, // Peripheral is ready
+    INIT_SEQ_STATE_TIMEOUT  = 3, // Hardware ready bits have not been set within timeout period
+    INIT_SEQ_STATE_ERROR    = 4  // Peripheral has reported an error
+}INIT_SEQUENCE_STATE_e;
+
+/*!INIT_SEQUENCE_t
+ * ***********************************************************************************************
+ * Description:
+ * Each initialization sequence is started by its start function (called by CLOCK_Initialize() 
+ * and exec_InitSequences()) and advanced by exec_InitSequences() once per scheduler tick without 
+ * waiting. All sequences run in parallel, hence the startup time is bounded by the slowest 
+ * peripheral instead of the sum of all ready times. 
+ * 
+ * The timeout counter is loaded with INIT_SEQUENCE_TIMEOUT when the sequence is started and 
+ * decremented with every step.
+ * ***********************************************************************************************/
+
+typedef struct {
+    volatile INIT_SEQUENCE_STATE_e state; // State of the initialization sequence
+    volatile uint16_t step; // Index of the recent step of the sequence
+    volatile uint16_t mask; // Selection of ADC cores or PWM generators covered by the sequence
+    volatile uint16_t timeout; // Remaining number of steps before the sequence times out
+} INIT_SEQUENCE_t;
+
+extern volatile INIT_SEQUENCE_t init_seq_auxpll;
+extern volatile INIT_SEQUENCE_t init_seq_adc;
+extern volatile INIT_SEQUENCE_t init_seq_hrpwm;
+
+/* ***********************************************************************************************
+ * PROTOTYPES
+ * ***********************************************************************************************/
+extern volatile uint16_t AuxOscillator_InitStart(void);
+extern volatile uint16_t ADC_PowerUpStart(volatile uint16_t core_mask);
+extern volatile uint16_t HRPWM_EnableStart(volatile uint16_t pg_mask);
+extern volatile uint16_t exec_InitSequences(void);
+
+#endif	/* MCAL_INITIALIZATION_SEQUENCE_H */
+
@@ -65,6 +65,7 @@ extern "C" {
 #include "mcal/config/devcfg_dsp.h"
 #include "mcal/config/devcfg_irq.h"
 #include "mcal/config/devcfg_oscillator.h"
+#include "mcal/config/devcfg_clocktree.h"
 #include "mcal/config/devcfg_pinmap.h"
 
 // Hardware-specific peripheral initialization
@@ -73,6 +74,12 @@ extern "C" {
 #include "mcal/initialization/init_dsp.h"
 #include "mcal/initialization/init_timer.h"
 #include "mcal/initialization/init_fosc.h"
+#include "mcal/initialization/init_sequence.h"
+#include "mcal/initialization/init_regimage.h"
+
+// Peripheral drivers
+#include "mcal/drivers/drv_hspwm.h"
+#include "mcal/drivers/drv_hsadc.h"
 
 /* generic peripheral drives */    
 //#include "dsPIC33C/p33SMPS_irq.h"
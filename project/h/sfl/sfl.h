@@ -36,6 +36,8 @@
 #include <stddef.h> // include standard definition types header file
 #include <math.h> // include standard math library header file
 
+#include "sfl/sfl_compensator.h"
+
 /* ***********************************************************************************************
  * PROTOTYPES
  * ***********************************************************************************************/
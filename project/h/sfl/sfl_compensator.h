@@ -0,0 +1,218 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!sfl_compensator.h
+ * ***************************************************************************
+ * File:   sfl_compensator.h
+ * Author: M91406
+ *
+ * Description:
+ * Fixed-point compensator library for SMPS control loops. The library offers
+ * a generic n-pole/n-zero compensator (e.g. 2P2Z, 3P3Z) and a PID controller,
+ * both working on Q15 data with output clamping and anti-windup. 
+ * 
+ * The update routines SFL_CNPNZ_Update() and SFL_PID_Update() are written in
+ * assembly (sfl_compensator_asm.s) and execute all multiplications in the DSP
+ * engine (MAC with dual operand prefetch, 40-bit accumulator, rounding and 
+ * data write saturation). The DSP engine needs to be configured by 
+ * DSP_initialize() using smpsDSP_Initialize() with the settings declared in
+ * devcfg_dsp.h (DSP_CORECON_CFG), which are verified by the initialization
+ * routines of this library.
+ * 
+ * SFL_CNPNZ_UpdateRef() and SFL_PID_UpdateRef() are bit-exact C reference 
+ * models of the assembly routines. They emulate accumulator saturation, 
+ * convergent rounding and data write saturation of the DSP engine and can be 
+ * compiled for the target as well as for host simulations.
+ *
+ * Alternate working register sets:
+ * The control loop interrupt should run at the interrupt priority level assigned
+ * to an alternate working register set (FALTREG CTXT1 = IPL5, see config_bits_P33CK.c)
+ * and be declared with __attribute__((interrupt, context)). The CPU then swaps
+ * W0...W14 in hardware on interrupt entry and exit, and neither the interrupt
+ * service routine nor the update routines need to save the registers of the
+ * interrupted code. Manual swaps using ALTWREG_SWAP() (p33SMPS_cpu_macros.h)
+ * must not be placed around calls of these routines from C code, as the compiler
+ * keeps local variables in working registers across the call.
+ * 
+ * DSP accumulators:
+ * Alternate working register sets only cover W0...W14. The accumulators ACCA and
+ * ACCB are shared by all contexts. Both update routines overwrite ACCA (ACCB is 
+ * not used) without saving it. When the interrupted code or any interrupt of 
+ * lower priority uses ACCA (e.g. another control loop, filter or DSP builtins), 
+ * the control loop interrupt service routine needs to save ACCA:
+ * 
+ *     void __attribute__((interrupt, context, save(ACCAL, ACCAH, ACCAU))) _PWM1Interrupt(void)
+ * 
+ * Saving ACCA once per interrupt costs six instruction cycles, compared to the 
+ * same cost for each call when the update routines would save it themselves.
+ * ***************************************************************************/
+
+#ifndef SFL_COMPENSATOR_LIBRARY_H
+#define	SFL_COMPENSATOR_LIBRARY_H
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stdbool.h> // include standard boolean types header file
+
+/*!SFL_CMP_BENCHMARK_ENABLE
+ * ***********************************************************************************************
+ * Description:
+ * When enabled, the function SFL_CompensatorBenchmark() is compiled, measuring the instruction 
+ * cycles of the optimized update routines and of the C reference models and verifying that both
+ * produce identical results for a pseudo-random error sequence of SFL_CMP_BENCHMARK_SAMPLES 
+ * samples. At 100 MIPS and 350 kHz switching frequency, one switching period lasts 285 
+ * instruction cycles.
+ * ***********************************************************************************************/
+
+#define SFL_CMP_BENCHMARK_ENABLE    0   // Enable/Disable compensator benchmark and self-test
+#define SFL_CMP_BENCHMARK_SAMPLES   256 // Number of test samples
+
+#define SFL_CNPNZ_ORDER_MAX         4   // Maximum number of poles/zeros of a CNPNZ compensator
+#define SFL_CNPNZ_TAPS(order)       ((2 * (order)) + 1) // Number of coefficients/history values
+
+#define SFL_CMP_STATUS_UPPER_LIMIT  0x0001  // Output has been clamped to the maximum value
+#define SFL_CMP_STATUS_LOWER_LIMIT  0x0002  // Output has been clamped to the minimum value
+
+// Required DSP configuration (see devcfg_dsp.h)
+#define SFL_CMP_CORCON_CFG          (REG_CORCON_ACCSAT_931 | REG_CORCON_IF_FRACTIONAL | REG_CORCON_RND_UNBIASED | \
+                                     REG_CORCON_SATA_ON | REG_CORCON_SATDW_ON | REG_CORCON_US_SIGNED)
+#define SFL_CMP_CORCON_MSK          (REG_CORCON_ACCSAT_931 | REG_CORCON_IF_INTEGER | REG_CORCON_RND_BIASED | \
+                                     REG_CORCON_SATA_ON | REG_CORCON_SATDW_ON | REG_CORCON_US_MIXED | REG_CORCON_US_UNSIGNED)
+
+// Memory placement of coefficient and history arrays required by the dual operand prefetch
+#define SFL_CNPNZ_COEFF_SPACE       __attribute__((space(xmemory)))
+#define SFL_CNPNZ_HIST_SPACE        __attribute__((space(ymemory)))
+
+/*!SFL_CNPNZ_t
+ * ***********************************************************************************************
+ * Summary:
+ * n-pole/n-zero compensator data structure
+ *
+ * Description:
+ * The compensator calculates the control output u[n] from the error e[n] by
+ * 
+ *     y[n] = B0 e[n] + B1 e[n-1] + ... + Bn e[n-order] + A1 u[n-1] + ... + An u[n-order]
+ *     u[n] = clamp(((y[n] * post_scaler) >> 15) << post_shift, min_clamp, max_clamp)
+ * 
+ * The coefficient array (X-space) holds B0...Bn followed by A1...An. The history array 
+ * (Y-space) holds e[n]...e[n-order] followed by u[n-1]...u[n-order]. Both arrays have 
+ * SFL_CNPNZ_TAPS(order) elements. As the clamped output is fed back, the compensator does 
+ * not wind up while the output is limited (see status).
+ * 
+ * All coefficients are divided by the output normalization gain G = post_scaler/2^15 * 
+ * 2^post_shift, which allows coefficients with values > 1.0 (e.g. A1 = 1.0 of the integrator 
+ * pole is represented by 2^-post_shift). Normalization factors are given in the same Q15/bit-
+ * shift format as the factors generated by tools/fixed_point_scaling.py.
+ * 
+ * Please note:
+ * The data structure is accessed by assembly code. Do not change the order of its members.
+ * ***********************************************************************************************/
+
+typedef struct {
+    const int16_t* ptr_coeff; // Pointer to the coefficient array B0...Bn, A1...An (X-space)
+    int16_t* ptr_hist; // Pointer to the history array e[n]...e[n-order], u[n-1]...u[n-order] (Y-space)
+    uint16_t order; // Number of poles/zeros (e.g. 2 = 2P2Z, 3 = 3P3Z)
+    int16_t post_scaler; // Output normalization factor (Q15)
+    int16_t post_shift; // Output normalization bit-shift (left-shift, -16...15)
+    int16_t min_clamp; // Minimum control output
+    int16_t max_clamp; // Maximum control output
+    uint16_t status; // Clamping status of the most recent update (SFL_CMP_STATUS_xxx)
+} SFL_CNPNZ_t;
+
+/*!SFL_PID_t
+ * ***********************************************************************************************
+ * Summary:
+ * PID controller data structure
+ *
+ * Description:
+ * The controller calculates the control output u[n] from the error e[n] by
+ * 
+ *     i[n] = sat(i[n-1] + Ki e[n])
+ *     y[n] = i[n] + Kp e[n] + Kd (e[n] - e[n-1])
+ *     u[n] = clamp(((y[n] * post_scaler) >> 15) << post_shift, min_clamp, max_clamp)
+ * 
+ * The integrator i[n] is a 32-bit fractional number (1.31) saturated at +/- 1.0. Anti-windup
+ * is implemented by conditional integration: while the output is clamped, the integrator is 
+ * only updated when its new value drives the output back into the control range.
+ * 
+ * Please note:
+ * The data structure is accessed by assembly code. Do not change the order of its members.
+ * ***********************************************************************************************/
+
+typedef struct {
+    int16_t kp; // Proportional gain (Q15, divided by the normalization gain)
+    int16_t ki; // Integral gain (Q15, divided by the normalization gain)
+    int16_t kd; // Derivative gain (Q15, divided by the normalization gain)
+    int16_t post_scaler; // Output normalization factor (Q15)
+    int16_t post_shift; // Output normalization bit-shift (left-shift, -16...15)
+    int16_t min_clamp; // Minimum control output
+    int16_t max_clamp; // Maximum control output
+    uint16_t status; // Clamping status of the most recent update (SFL_CMP_STATUS_xxx)
+    int16_t error_prev; // Error of the previous update e[n-1]
+    uint16_t integrator_l; // Integrator i[n-1] (1.31), low word
+    int16_t integrator_h; // Integrator i[n-1] (1.31), high word
+} SFL_PID_t;
+
+/*!SFL_CMP_BENCHMARK_t
+ * ***********************************************************************************************
+ * Description:
+ * Results of SFL_CompensatorBenchmark(). Cycle counts are the maximum number of instruction 
+ * cycles of one update call (incl. call and return) measured across all test samples, excluding
+ * timer readout overhead.
+ * ***********************************************************************************************/
+
+typedef struct {
+    uint16_t cycles_2p2z; // 2P2Z compensator (SFL_CNPNZ_Update)
+    uint16_t cycles_3p3z; // 3P3Z compensator (SFL_CNPNZ_Update)
+    uint16_t cycles_pid; // PID controller (SFL_PID_Update)
+    uint16_t cycles_2p2z_ref; // 2P2Z compensator C reference model (SFL_CNPNZ_UpdateRef)
+    uint16_t cycles_3p3z_ref; // 3P3Z compensator C reference model (SFL_CNPNZ_UpdateRef)
+    uint16_t cycles_pid_ref; // PID controller C reference model (SFL_PID_UpdateRef)
+    uint16_t samples; // Number of test samples
+    uint16_t mismatches; // Number of samples where assembly routines and reference model differ
+} SFL_CMP_BENCHMARK_t;
+
+/* ***********************************************************************************************
+ * PROTOTYPES
+ * ***********************************************************************************************/
+
+extern volatile uint16_t SFL_CNPNZ_Initialize(volatile SFL_CNPNZ_t* cmp, uint16_t order, 
+            const int16_t* coeff, int16_t* hist, int16_t post_scaler, int16_t post_shift, 
+            int16_t min_clamp, int16_t max_clamp);
+extern volatile uint16_t SFL_CNPNZ_Reset(volatile SFL_CNPNZ_t* cmp, int16_t output);
+extern int16_t SFL_CNPNZ_UpdateRef(volatile SFL_CNPNZ_t* cmp, int16_t error);
+
+extern volatile uint16_t SFL_PID_Initialize(volatile SFL_PID_t* pid, int16_t kp, int16_t ki, 
+            int16_t kd, int16_t post_scaler, int16_t post_shift, int16_t min_clamp, int16_t max_clamp);
+extern volatile uint16_t SFL_PID_Reset(volatile SFL_PID_t* pid);
+extern int16_t SFL_PID_UpdateRef(volatile SFL_PID_t* pid, int16_t error);
+
+// Optimized update routines (sfl_compensator_asm.s)
+extern int16_t SFL_CNPNZ_Update(volatile SFL_CNPNZ_t* cmp, int16_t error);
+extern int16_t SFL_PID_Update(volatile SFL_PID_t* pid, int16_t error);
+
+#if (SFL_CMP_BENCHMARK_ENABLE == 1)
+extern volatile SFL_CMP_BENCHMARK_t sfl_cmp_benchmark;
+extern volatile uint16_t SFL_CompensatorBenchmark(void);
+#endif
+
+#endif	/* SFL_COMPENSATOR_LIBRARY_H */
+
@@ -0,0 +1,196 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ * ***************************************************************************/
+/*!fdrv_FaultFastPath.c
+ * ****************************************************************************
+ * File:   fdrv_FaultFastPath.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file provides the setup and hand-over functions of the fault
+ * fast path. Designated critical and catastrophic fault objects are checked
+ * inside the control loop interrupt service routine by
+ * exec_FaultFastPathCheck() (see fdrv_FaultFastPath.h), which overrides the
+ * PWM outputs immediately. The fault response itself is executed by the
+ * regular fault handler at the next fault check cycle.
+ *
+ ******************************************************************************/
+
+#include "xc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#include "_root/generic/os_Globals.h"
+#include "_root/generic/fdrv_FaultFastPath.h"
+
+// fast path entries checked in interrupt context
+volatile FAULT_FAST_PATH_t fault_fast_path[FAULT_FAST_PATH_SIZE];
+volatile uint16_t fault_fast_path_count = 0;
+
+/*!os_FaultFastPath_Initialize
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Removes all fast path entries. This function is called by os_FaultObjects_Initialize() before
+ * the fault object initialization functions are executed, which may designate fault objects
+ * for the fast path by calling SetFaultFastPath().
+ * ***********************************************************************************************/
+volatile uint16_t os_FaultFastPath_Initialize(void)
+{
+    fault_fast_path_count = 0;
+    return(1);
+}
+
+/*!SetFaultFastPath
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to an initialized fault object
+ *      uint16_t pwm_mask: PWM generators to be overridden when tripped (bit #0 = PG1, etc.)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure (fault object is not supported or fast path table is full)
+ *      1: Success
+ *
+ * Description:
+ * Adds the given fault object to the fast path. Only 16-bit unsigned fault objects of compare
+ * type FAULT_LEVEL_GREATER_THAN or FAULT_LEVEL_LESS_THAN without compare object are supported.
+ * The trip level is copied from the fault object, hence this function has to be called after
+ * the fault criteria have been set. The fault counter filter is bypassed by the fast path.
+ * The entry is only armed if the fault check of the fault object is enabled. Otherwise it is
+ * added in handed-over state and armed by exec_FaultFastPathHandoff() once the fault check
+ * has been enabled and no fault group of the fault object is masked.
+ *
+ * Example:
+ *      fres &= SetFaultFastPath(&fltobj_OutputOverCurrent, 0x0003); // Override PG1 and PG2
+ * ***********************************************************************************************/
+volatile uint16_t SetFaultFastPath(volatile FAULT_OBJECT_t* fltobj, volatile uint16_t pwm_mask)
+{
+    volatile FAULT_FAST_PATH_t* entry;
+
+    if(fltobj == NULL) { return(0); }
+    if(fault_fast_path_count >= FAULT_FAST_PATH_SIZE) { return(0); }
+    if((fltobj->criteria.source_object == NULL) || (fltobj->criteria.compare_object != NULL) ||
+       (fltobj->criteria.source_type != FLTOBJ_SOURCE_TYPE_UINT16))
+    { return(0); }
+
+    entry = &fault_fast_path[fault_fast_path_count];
+
+    switch(fltobj->criteria.compare_type)
+    {
+        case FAULT_LEVEL_GREATER_THAN:
+            entry->compare_invert = 0x0000;
+            entry->trip_level = fltobj->criteria.trip_level;
+            break;
+
+        case FAULT_LEVEL_LESS_THAN:
+            // (a < b) equals (~a > ~b) for unsigned numbers
+            entry->compare_invert = 0xFFFF;
+            entry->trip_level = (uint16_t)(~fltobj->criteria.trip_level);
+            break;
+
+        default:
+            return(0);
+    }
+
+    entry->fltobj = fltobj;
+    entry->source_object = fltobj->criteria.source_object;
+    entry->source_bit_mask = fltobj->criteria.source_bit_mask;
+    entry->pwm_mask = pwm_mask;
+    entry->t_violation = 0;
+
+    if(fltobj->status.bits.fltchk_enabled)
+    { entry->state = FLTFAST_STATE_ARMED; }
+    else
+    { entry->state = FLTFAST_STATE_HANDED_OVER; }
+
+    fault_fast_path_count++; // Entry becomes visible to the interrupt service routine
+
+    return(1);
+}
+
+/*!exec_FaultFastPathHandoff
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * This routine is called by exec_FaultCheckAll() before the fault objects are checked. Fault
+ * objects of tripped fast path entries are tripped by the regular fault handler, executing the
+ * fault response of their fault class. Entries which have been handed over are re-armed once
+ * the fault status of their fault object has been cleared, its fault check is enabled and none
+ * of its fault groups is masked.
+ * If the fault object has been disabled or one of its fault groups has been masked after the
+ * fast path has tripped, the fault object is not tripped. The PWM override is not released
+ * in this case and remains subject to the power converter startup sequence.
+ * With fault latency instrumentation enabled, the violation time stamp captured in interrupt
+ * context is passed on to the latency record of the fault object before it is tripped.
+ * ***********************************************************************************************/
+volatile uint16_t exec_FaultFastPathHandoff(void)
+{
+    volatile uint16_t fres=1, i=0;
+    volatile FAULT_FAST_PATH_t* entry;
+
+    for(i=0; i<fault_fast_path_count; i++)
+    {
+        entry = &fault_fast_path[i];
+
+        if(entry->state == FLTFAST_STATE_TRIPPED)
+        {
+            entry->state = FLTFAST_STATE_HANDED_OVER;
+
+            // Fault object may already have been tripped by the regular fault check or may
+            // have been disabled/masked since the fast path has tripped
+            if((!entry->fltobj->status.bits.fault_status) && (entry->fltobj->status.bits.fltchk_enabled) &&
+               (!(entry->fltobj->groups & fault_registry.groups_disabled)))
+            {
+                entry->fltobj->status.bits.fault_active = true;
+
+                #if (USE_FAULT_LATENCY_INSTRUMENTATION == 1)
+                fres &= SetFaultLatencyViolation(entry->fltobj, entry->t_violation);
+                #endif
+
+                fres &= ExecFaultTrip(entry->fltobj);
+            }
+        }
+        else if((entry->state == FLTFAST_STATE_HANDED_OVER) && (!entry->fltobj->status.bits.fault_status) &&
+                (entry->fltobj->status.bits.fltchk_enabled) && (!(entry->fltobj->groups & fault_registry.groups_disabled)))
+        {
+            entry->state = FLTFAST_STATE_ARMED;
+        }
+    }
+
+    return(fres);
+}
+
+// EOF
@@ -35,6 +35,7 @@
 #include "xc.h"
 #include <stdint.h>
 #include <stddef.h>
+#include <stdlib.h>
 #include <math.h>
 
 #include "_root/generic/os_Globals.h"
@@ -42,11 +43,19 @@
 
 /* private function prototypes */
 inline volatile uint16_t CheckFaultCondition(volatile FAULT_OBJECT_t* fltobj);
+volatile uint16_t CheckFaultConditionTyped(volatile FAULT_OBJECT_t* fltobj);
+volatile uint16_t CompareFaultLevelSigned(volatile FAULT_OBJECT_t* fltobj, 
+            volatile int32_t source_value, volatile int32_t trip_level, volatile int32_t reset_level);
+volatile uint16_t CompareFaultLevelUnsigned32(volatile FAULT_OBJECT_t* fltobj, 
+            volatile uint32_t source_value, volatile uint32_t trip_level, volatile uint32_t reset_level);
 inline volatile uint16_t SetFaultCondition(volatile FAULT_OBJECT_t* fltobj);
 inline volatile uint16_t ExecFaultHandler(volatile FAULT_OBJECT_t* fltobj);
 inline volatile uint16_t ExecGlobalFaultFlagRelease(volatile uint16_t fault_class_code);
 inline volatile uint16_t ExecFaultFlagReleaseHandler(volatile FAULT_OBJECT_t* fltobj);
 
+// tick counter of the CPU reset rate decay
+volatile uint32_t reset_rate_decay_counter = 0;
+
 /*!FaultObjects_Initialize
  * ***********************************************************************************************
  * Description:
@@ -60,6 +69,21 @@ volatile uint16_t os_FaultObjects_Initialize(void)
     volatile uint16_t fres = 1;
     volatile uint16_t i = 0;
 
+    // Check/initialize persistent fault history log
+    #if (USE_FAULT_HISTORY_LOG == 1)
+    fres &= os_FaultLog_Initialize();
+    #endif
+    
+    // Reset fault response latency instrumentation
+    #if (USE_FAULT_LATENCY_INSTRUMENTATION == 1)
+    fres &= os_FaultLatency_Initialize();
+    #endif
+    
+    // Remove all fault fast path entries (fault object initialization may add new entries)
+    #if (USE_FAULT_FAST_PATH == 1)
+    fres &= os_FaultFastPath_Initialize();
+    #endif
+    
     // Initialize all fault objects in OS Fault Object list
     for(i=0; i<os_fault_object_init_functions_size; i++) {
         if (os_fault_object_init_functions[i] != NULL) {
@@ -73,6 +97,19 @@ volatile uint16_t os_FaultObjects_Initialize(void)
             fres &= user_fault_object_init_functions[i]();
         }
     }
+    
+    // Register all fault objects by ID and fault group (requires initialized fault objects)
+    fres &= os_FaultRegistry_Initialize();
+    
+    // Validate composite fault rules (requires initialized fault objects)
+    #if (USE_FAULT_RULES == 1)
+    fres &= os_FaultRules_Initialize();
+    #endif
+    
+    // Reset staged fault recovery engine
+    #if (USE_FAULT_RECOVERY_ENGINE == 1)
+    fres &= os_FaultRecovery_Initialize();
+    #endif
 
     // ====================================================
     // InitiallysSet global fault flags (need to be cleared during operation)
@@ -122,6 +159,10 @@ volatile uint16_t CheckFaultCondition(volatile FAULT_OBJECT_t* fltobj)
     // if the fault object is not initialized, exit here
     if(fltobj == NULL) { return(1); }
     
+    // signed and 32-bit source objects are checked by specialized compare routines
+    if(fltobj->criteria.source_type != FLTOBJ_SOURCE_TYPE_UINT16) 
+    { return(CheckFaultConditionTyped(fltobj)); }
+    
     // read value to monitor (with bit-mask filtering)
     source_value = ((*fltobj->criteria.source_object) & (fltobj->criteria.source_bit_mask));
     
@@ -234,6 +275,261 @@ volatile uint16_t CheckFaultCondition(volatile FAULT_OBJECT_t* fltobj)
     return(1);
 
 }
+
+/*!CheckFaultConditionTyped
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to fault object fltobj of type FAULT_OBJECT_t, holding
+ *          all the information about fault criteria, fault class and fault response settings
+ * 
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ * 
+ * Description:
+ * This routine is called by CheckFaultCondition() for all fault objects whose source type is 
+ * not FLTOBJ_SOURCE_TYPE_UINT16. The source object (and compare object, if used) is read with 
+ * its specified data type and handed over to the compare routine matching its signedness:
+ * 
+ *      - FLTOBJ_SOURCE_TYPE_INT16, FLTOBJ_SOURCE_TYPE_Q15:
+ *          * bit-mask filtered 16-bit value is sign-extended, levels are read from 
+ *            trip_level/reset_level and interpreted as signed numbers
+ * 
+ *      - FLTOBJ_SOURCE_TYPE_INT32:
+ *          * 32-bit signed value, levels are read from trip_level_32/reset_level_32
+ * 
+ *      - FLTOBJ_SOURCE_TYPE_UINT32:
+ *          * 32-bit unsigned value, levels are read from trip_level_32/reset_level_32
+ * 
+ * When a compare object is specified, the absolute difference between source and compare value 
+ * is monitored. 32-bit differences are saturated to the positive maximum of the data type.
+ * ***********************************************************************************************/
+volatile uint16_t CheckFaultConditionTyped(volatile FAULT_OBJECT_t* fltobj)
+{
+    volatile int32_t source_value = 0;
+    volatile int32_t compare_value = 0;
+    volatile uint32_t usource_value = 0;
+    volatile uint32_t ucompare_value = 0;
+
+    switch (fltobj->criteria.source_type)
+    {
+        case FLTOBJ_SOURCE_TYPE_INT16:
+        case FLTOBJ_SOURCE_TYPE_Q15:
+        // 16-bit signed integer and Q15 numbers are sign-extended to 32-bit
+            
+            source_value = (int32_t)((int16_t)((*fltobj->criteria.source_object) & (fltobj->criteria.source_bit_mask)));
+            
+            if(fltobj->criteria.compare_object != NULL) 
+            {
+                // capture compare value and calculate absolute difference (cannot overflow in 32-bit)
+                compare_value = (int32_t)((int16_t)((*fltobj->criteria.compare_object) & (fltobj->criteria.compare_bit_mask)));
+                source_value = labs(source_value - compare_value);
+            }
+            
+            return(CompareFaultLevelSigned(fltobj, source_value, 
+                    (int32_t)((int16_t)fltobj->criteria.trip_level), 
+                    (int32_t)((int16_t)fltobj->criteria.reset_level)));
+            
+        case FLTOBJ_SOURCE_TYPE_INT32:
+        // 32-bit signed integer numbers
+            
+            source_value = *((volatile int32_t*)fltobj->criteria.source_object);
+            
+            if(fltobj->criteria.compare_object != NULL) 
+            {
+                // capture compare value and calculate absolute difference (saturated to INT32_MAX)
+                compare_value = *((volatile int32_t*)fltobj->criteria.compare_object);
+                
+                if(source_value >= compare_value)
+                { usource_value = ((uint32_t)source_value - (uint32_t)compare_value); }
+                else
+                { usource_value = ((uint32_t)compare_value - (uint32_t)source_value); }
+                
+                if(usource_value > (uint32_t)INT32_MAX) 
+                { usource_value = (uint32_t)INT32_MAX; }
+                
+                source_value = (int32_t)usource_value;
+            }
+            
+            return(CompareFaultLevelSigned(fltobj, source_value, 
+                    (int32_t)fltobj->criteria.trip_level_32, 
+                    (int32_t)fltobj->criteria.reset_level_32));
+            
+        case FLTOBJ_SOURCE_TYPE_UINT32:
+        // 32-bit unsigned integer numbers
+            
+            usource_value = *((volatile uint32_t*)fltobj->criteria.source_object);
+            
+            if(fltobj->criteria.compare_object != NULL) 
+            {
+                // capture compare value and calculate absolute difference
+                ucompare_value = *((volatile uint32_t*)fltobj->criteria.compare_object);
+                
+                if(usource_value >= ucompare_value)
+                { usource_value = (usource_value - ucompare_value); }
+                else
+                { usource_value = (ucompare_value - usource_value); }
+            }
+            
+            return(CompareFaultLevelUnsigned32(fltobj, usource_value, 
+                    fltobj->criteria.trip_level_32, fltobj->criteria.reset_level_32));
+            
+        default:
+        // unknown/unsupported source data type. => Exit with error code
+            Nop();
+            return(0);
+    }
+    
+}
+
+/*!CompareFaultLevelSigned
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to fault object fltobj of type FAULT_OBJECT_t
+ *      int32_t source_value:   Sign-extended value of the monitored object
+ *      int32_t trip_level:     Sign-extended fault trip level
+ *      int32_t reset_level:    Sign-extended fault reset level
+ * 
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ * 
+ * Description:
+ * Signed counterpart of the threshold comparison performed in CheckFaultCondition(). This 
+ * routine sets/clears the fault_active flag bit of the given fault object based on its 
+ * compare type setting. It's used for 16-bit signed, Q15 and 32-bit signed source objects.
+ * ***********************************************************************************************/
+volatile uint16_t CompareFaultLevelSigned(volatile FAULT_OBJECT_t* fltobj, 
+            volatile int32_t source_value, volatile int32_t trip_level, volatile int32_t reset_level)
+{
+    
+    switch (fltobj->criteria.compare_type) 
+    {
+        case FAULT_LEVEL_GREATER_THAN:
+        // check for upper thresholds violation (including hysteresis when defined)
+            if(source_value > trip_level)
+            { fltobj->status.bits.fault_active = true; } // set "fault present" bit
+            else if(source_value < reset_level)
+            { fltobj->status.bits.fault_active = false; } // clear "fault present" bit
+            break;
+            
+        case FAULT_LEVEL_LESS_THAN:
+        // check for lower thresholds violation (including hysteresis when defined)
+            if(source_value < trip_level)
+            { fltobj->status.bits.fault_active = true; } // set "fault present" bit
+            else if(source_value > reset_level)
+            { fltobj->status.bits.fault_active = false; } // clear "fault present" bit
+            break;
+            
+        case FAULT_LEVEL_BOOLEAN:
+        // if the fault level is defined to be a 'true' condition 
+            fltobj->status.bits.fault_active = (bool)(source_value != 0);
+            break;
+            
+        case FAULT_LEVEL_EQUAL:
+        // trigger fault when value is equal to trip level (without hysteresis)
+            fltobj->status.bits.fault_active = (bool)(source_value == trip_level);
+            break;
+            
+        case FAULT_LEVEL_NOT_EQUAL:
+        // trigger fault when value is off trip level (without hysteresis)
+            fltobj->status.bits.fault_active = (bool)(source_value != trip_level);
+            break;
+        
+        case FAULT_LEVEL_IN_RANGE:
+        // trigger fault when value is inside the window between reset (lower) and trip (upper) level
+            fltobj->status.bits.fault_active = (bool)((reset_level < source_value) && (source_value < trip_level));
+            break;
+            
+        case FAULT_LEVEL_OUT_OF_RANGE:
+        // trigger fault when value is outside the window between reset (lower) and trip (upper) level
+            fltobj->status.bits.fault_active = (bool)((source_value < reset_level) || (source_value > trip_level));
+            break;
+            
+        default:
+        // unknown/unsupported compare condition. => Exit with error code
+            Nop();
+            return(0);
+    }
+    
+    return(1);
+}
+
+/*!CompareFaultLevelUnsigned32
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to fault object fltobj of type FAULT_OBJECT_t
+ *      uint32_t source_value:  Value of the monitored object
+ *      uint32_t trip_level:    Fault trip level
+ *      uint32_t reset_level:   Fault reset level
+ * 
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ * 
+ * Description:
+ * 32-bit unsigned counterpart of the threshold comparison performed in CheckFaultCondition().
+ * This routine sets/clears the fault_active flag bit of the given fault object based on its 
+ * compare type setting.
+ * ***********************************************************************************************/
+volatile uint16_t CompareFaultLevelUnsigned32(volatile FAULT_OBJECT_t* fltobj, 
+            volatile uint32_t source_value, volatile uint32_t trip_level, volatile uint32_t reset_level)
+{
+    
+    switch (fltobj->criteria.compare_type) 
+    {
+        case FAULT_LEVEL_GREATER_THAN:
+        // check for upper thresholds violation (including hysteresis when defined)
+            if(source_value > trip_level)
+            { fltobj->status.bits.fault_active = true; } // set "fault present" bit
+            else if(source_value < reset_level)
+            { fltobj->status.bits.fault_active = false; } // clear "fault present" bit
+            break;
+            
+        case FAULT_LEVEL_LESS_THAN:
+        // check for lower thresholds violation (including hysteresis when defined)
+            if(source_value < trip_level)
+            { fltobj->status.bits.fault_active = true; } // set "fault present" bit
+            else if(source_value > reset_level)
+            { fltobj->status.bits.fault_active = false; } // clear "fault present" bit
+            break;
+            
+        case FAULT_LEVEL_BOOLEAN:
+        // if the fault level is defined to be a 'true' condition 
+            fltobj->status.bits.fault_active = (bool)(source_value != 0);
+            break;
+            
+        case FAULT_LEVEL_EQUAL:
+        // trigger fault when value is equal to trip level (without hysteresis)
+            fltobj->status.bits.fault_active = (bool)(source_value == trip_level);
+            break;
+            
+        case FAULT_LEVEL_NOT_EQUAL:
+        // trigger fault when value is off trip level (without hysteresis)
+            fltobj->status.bits.fault_active = (bool)(source_value != trip_level);
+            break;
+        
+        case FAULT_LEVEL_IN_RANGE:
+        // trigger fault when value is inside the window between reset (lower) and trip (upper) level
+            fltobj->status.bits.fault_active = (bool)((reset_level < source_value) && (source_value < trip_level));
+            break;
+            
+        case FAULT_LEVEL_OUT_OF_RANGE:
+        // trigger fault when value is outside the window between reset (lower) and trip (upper) level
+            fltobj->status.bits.fault_active = (bool)((source_value < reset_level) || (source_value > trip_level));
+            break;
+            
+        default:
+        // unknown/unsupported compare condition. => Exit with error code
+            Nop();
+            return(0);
+    }
+    
+    return(1);
+}
     
 /*!SetFaultCondition
  * ***********************************************************************************************
@@ -268,16 +564,17 @@ volatile uint16_t SetFaultCondition(volatile FAULT_OBJECT_t* fltobj)
         { 
             fltobj->criteria.counter++ ; // increment fault counter
 
+            // Capture time stamp of first threshold violation
+            #if (USE_FAULT_LATENCY_INSTRUMENTATION == 1)
+            if(fltobj->criteria.counter == 1)
+            { f_res &= CaptureFaultLatencyEvent(fltobj, FLTLAT_EVENT_VIOLATION); }
+            #endif
+
             // Check if fault counter limits have been exceeded
             if(fltobj->criteria.counter >= fltobj->criteria.trip_cnt_threshold)
             {
-                // Call fault handler passing on the recent fault object
-                fltobj->criteria.counter = fltobj->criteria.trip_cnt_threshold; // Clamp counter
-                fltobj->status.bits.fault_status = true; // set "fault status" bit
-
-                // Set global fault flags and execute appropriate response
-                f_res &= ExecFaultHandler(fltobj);   
-
+                // Set fault status and call fault handler passing on the recent fault object
+                f_res &= ExecFaultTrip(fltobj);
             }
 
         }
@@ -302,6 +599,10 @@ volatile uint16_t SetFaultCondition(volatile FAULT_OBJECT_t* fltobj)
                 fltobj->criteria.counter = fltobj->criteria.reset_cnt_threshold; // Clamp counter
                 fltobj->status.bits.fault_status = false; // clear "fault status" bit
                 
+                // Record time-in-fault in persistent fault log
+                #if (USE_FAULT_HISTORY_LOG == 1)
+                f_res &= ReleaseFaultLogEntry(fltobj);
+                #endif
             }
 
         }
@@ -315,6 +616,53 @@ volatile uint16_t SetFaultCondition(volatile FAULT_OBJECT_t* fltobj)
     return(f_res);
 }
 
+/*!ExecFaultTrip
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to fault object fltobj of type FAULT_OBJECT_t, holding
+ *          all the information about fault conditions, fault class, and further user-defined
+ *          settings.
+ * 
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ * 
+ * Description:
+ * This routine trips the given fault object. The fault counter is clamped, the fault status 
+ * bit is set and the fault response is executed by ExecFaultHandler(). It's called by 
+ * SetFaultCondition() once the fault counter threshold has been reached and by the fault fast 
+ * path hand-over of fault objects which have tripped in interrupt context.
+ * ***********************************************************************************************/
+volatile uint16_t ExecFaultTrip(volatile FAULT_OBJECT_t* fltobj)
+{
+    volatile uint16_t f_res = 1;
+    
+    // if the fault object is not initialized, exit here
+    if(fltobj == NULL) { return(1); }
+
+    fltobj->criteria.counter = fltobj->criteria.trip_cnt_threshold; // Clamp counter
+    fltobj->status.bits.fault_status = true; // set "fault status" bit
+
+    #if (USE_FAULT_LATENCY_INSTRUMENTATION == 1)
+    f_res &= CaptureFaultLatencyEvent(fltobj, FLTLAT_EVENT_TRIP);
+    #endif
+
+    // Set global fault flags and execute appropriate response
+    f_res &= ExecFaultHandler(fltobj);   
+
+    #if (USE_FAULT_LATENCY_INSTRUMENTATION == 1)
+    f_res &= CaptureFaultLatencyEvent(fltobj, FLTLAT_EVENT_RESPONSE);
+    #endif
+
+    // Record fault event in persistent fault log after fault response has been executed
+    #if (USE_FAULT_HISTORY_LOG == 1)
+    f_res &= CaptureFaultLogEntry(fltobj);
+    #endif
+
+    return(f_res);
+}
+
 /*!CaptureCPUInterruptStatus
  * ***********************************************************************************************
  * Parameters: (none)
@@ -413,70 +761,112 @@ volatile uint16_t CaptureCPUInterruptStatus(void)
  *      1: Success
  * 
  * Description:
- * This routine analyzes the traplog object and CPU RESET register RCON for the latest events.
- * The register status is triaged in critical, warning and notification flag-level reset causes.
- * This functions returns 
+ * This routine analyzes the CPU RESET register RCON and the persistent traplog object right 
+ * after a CPU reset to classify the root cause of the previous reset and select the restart 
+ * profile (see CPU_RESTART_PROFILE_e), which is stored in traplog.restart_profile:
+ * 
+ *     - Power-on, brown-out and external (MCLR) resets start the system cold. The content of
+ *       persistent data structures is undefined after power-up and therefore cleared.
  * 
- *     3 = (critical-level reset condition)
- *     2 = (warning-level reset condition)
- *     1 = (notification-level reset condition)
- *     0 = unknown condition/function failure
+ *     - All other resets are accumulated in the decaying reset rate counter traplog.reset_rate
+ *       (see ExecCPUResetRateDecay()). The system restarts warm after software resets and in 
+ *       degraded mode after uncontrolled resets or when the reset rate has reached 
+ *       TASK_MGR_CPU_RESET_DEGRADED. When the reset rate reaches TASK_MGR_CPU_RESET_LIMIT, the 
+ *       system is brought into a safe stop.
  * 
+ *     - Traps the CPU has returned from end in a software reset (e.g. by fault object 
+ *       fltobj_CPUFailure), where RCON only shows SWR. Therefore software resets are also
+ *       classified as uncontrolled, if trap flags have been captured, the trap counter has 
+ *       changed since the previous reset or a new crash record has been sealed.
+ * 
+ * The RCON reset status flags are cleared after evaluation, so the next reset root cause can 
+ * be identified unambiguously.
  * ***********************************************************************************************/
 volatile uint16_t CheckCPUResetRootCause(void)
 {
-    volatile uint16_t fres = 1;
+    volatile uint16_t i=0;
+    volatile CPU_RCON_t rcon;
+    volatile uint16_t* ptr;
+    volatile bool trap_detected=false;
 
-    // TODO: after reset, the RCON ; INTTRE AND trap flag bits need to be checked
-    // to determine the root cause of the previous CPU reset. If a software CPU reset
-    // was triggered, the number of enforced CPU RESETs need to be limited by the code
-    // and the application needs to be brought into a safe condition
+    // Capture and clear reset status flags
+    rcon.value = RCON;
+    RCON &= ~(FLT_CPU_RESET_CLASS_CRITICAL | FLT_CPU_RESET_CLASS_WARNING | FLT_CPU_RESET_CLASS_NORMAL);
 
-    // Check if CPU RESET root cause is different from logged status
-    if (traplog.rcon_reg.value != RCON) {
-        // TODO: handle condition after restart 
-        Nop();
-        Nop();
-    }
-    
-    // Check if CPU RESET was tripped by software
-    if (traplog.status.bits.sw_reset) {
-        // TODO: handle condition after restart 
-        Nop();
-        Nop();
-    }
-    
-    // Check if previous CPU RESET was cause by critical causes
-    if (traplog.rcon_reg.value & FLT_CPU_RESET_CLASS_CRITICAL) {
-        // TODO: handle exceptions after restart 
-        Nop();    
-        Nop();   
+    if ((rcon.bits.por) || (rcon.bits.bor) || (rcon.bits.extr))
+    {
+        // Cold start: clear persistent trap log and crash record
+        ptr = (volatile uint16_t*)&traplog;
+        for (i=0; i<(sizeof(TRAP_LOGGER_t)/sizeof(uint16_t)); i++) 
+        { ptr[i] = 0; }
+
+        #if (USE_TRAP_CRASH_RECORD == 1)
+        crashlog.signature = 0;
+        #endif
         
-        fres = 3;
+        traplog.restart_profile = CPU_RESTART_COLD;
     }
-    else if (traplog.rcon_reg.value & FLT_CPU_RESET_CLASS_WARNING) {
-        // TODO: handle exceptions after restart 
-        Nop();    
-        Nop();    
+    else
+    {
+        // Accumulate reset in decaying reset rate counter (saturating)
+        traplog.reset_count++;
+        if (traplog.reset_rate < (0xFFFF - 256)) 
+        { traplog.reset_rate += 256; }
+        else
+        { traplog.reset_rate = 0xFFFF; }
 
-        fres = 2;
+        // Check for traps which have occurred since the previous reset
+        trap_detected = (bool)((traplog.trap_flags.value != 0) || 
+                               (traplog.trap_count != traplog.boot_trap_count));
+        #if (USE_TRAP_CRASH_RECORD == 1)
+        if ((crashlog.signature == TRAP_CRASH_RECORD_SIGNATURE) && (traplog.status.bits.crash_record_new))
+        { trap_detected = true; }
+        #endif
+        
+        // Select restart profile
+        if (traplog.reset_rate >= (TASK_MGR_CPU_RESET_LIMIT << 8))
+        { traplog.restart_profile = CPU_RESTART_SAFE_STOP; }
+        else if ((rcon.value & FLT_CPU_RESET_CLASS_CRITICAL) || 
+                 (traplog.reset_rate >= (TASK_MGR_CPU_RESET_DEGRADED << 8)) || 
+                 (!traplog.status.bits.sw_reset) || (trap_detected))
+        { traplog.restart_profile = CPU_RESTART_DEGRADED; }
+        else
+        { traplog.restart_profile = CPU_RESTART_WARM; }
     }
-    else if (traplog.rcon_reg.value & FLT_CPU_RESET_CLASS_NORMAL) {
-        // TODO: handle exceptions after restart 
-        Nop();    
-        Nop();    
+    
+    traplog.rcon_reg.value = rcon.value;    // Log root cause of recent reset
+    traplog.status.bits.sw_reset = false;   // Clear software reset flag 
+    traplog.status.bits.cpu_reset_trigger = false; // Clear CPU reset trigger of recent trap
+    traplog.status.bits.crash_record_new = false; // Crash record has been evaluated
+    traplog.boot_trap_count = traplog.trap_count; // Reference of traps occurring until next reset
 
-        fres = 1;
-    }
-    else {
-        // TODO: handle exceptions after restart 
-        Nop();    
-        Nop();    
+    return(1);
+}
 
-        fres = 0;
+/*!ExecCPUResetRateDecay
+ * ***********************************************************************************************
+ * Parameters: (none)
+ *      
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ * 
+ * Description:
+ * This routine is called by the scheduler once per master period. The reset rate counter 
+ * traplog.reset_rate is decremented by one every TASK_MGR_CPU_RESET_DECAY_PERIOD ticks, hence 
+ * the rate of one reset decays within TASK_MGR_CPU_RESET_DECAY_TIME of uninterrupted operation.
+ * ***********************************************************************************************/
+volatile uint16_t ExecCPUResetRateDecay(void)
+{
+    if (++reset_rate_decay_counter >= TASK_MGR_CPU_RESET_DECAY_PERIOD)
+    {
+        reset_rate_decay_counter = 0;
+        if (traplog.reset_rate > 0) 
+        { traplog.reset_rate--; }
     }
 
-    return(fres);
+    return(1);
 }
 
 /*!ExecFaultHandler
@@ -671,6 +1061,44 @@ volatile uint16_t ExecFaultFlagReleaseHandler(volatile FAULT_OBJECT_t* fltobj)
     return(fres);
 }
 
+/*!ExecFaultRecoveryRestart
+ * ***********************************************************************************************
+ * Parameters: 
+ *      (none)
+ * 
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ * 
+ * Description:
+ * This routine executes the user recovery functions of all registered fault objects and switches
+ * the task manager from fault mode into the startup sequence. It is called by exec_FaultCheckAll()
+ * as soon as the global fault flag has been cleared or by the fault recovery engine after the
+ * cool-down period has expired (see fdrv_FaultRecovery.c).
+ * ***********************************************************************************************/
+volatile uint16_t ExecFaultRecoveryRestart(void)
+{
+    volatile uint16_t i=0, fres=1;
+    volatile FAULT_OBJECT_t* fltobj;
+    
+    // when recovering from active fault, check if user recovery functions of registered 
+    // fault objects have to be executed
+    for (i=0; i<fault_registry.scan_size; i++)
+    {
+        fltobj = GetFaultCheckObject(i); // skips empty registry slots and masked fault groups
+        if ((fltobj != NULL) && (fltobj->status.bits.fltchk_enabled))
+        { fres &= ExecFaultFlagReleaseHandler(fltobj); }
+    }    
+
+    task_mgr.status.bits.fault_override = false;   // Reset global fault override flag
+    task_mgr.status.bits.startup_sequence_complete = false; // Reset startup sequence complete flag
+    task_mgr.pre_op_mode.value = OP_MODE_FAULT;  // set pre_op_mode to provoke op-mode switch-over
+    task_mgr.op_mode.value = OP_MODE_STARTUP_SEQUENCE; // set op_mode to provoke op-mode switch-over
+
+    return(fres);
+}
+
 /*!exec_FaultCheckAll
  * ***********************************************************************************************
  * Parameters: 
@@ -682,47 +1110,50 @@ volatile uint16_t ExecFaultFlagReleaseHandler(volatile FAULT_OBJECT_t* fltobj)
  *      1: Success
  * 
  * Description:
- * This routine checks all fault objects listed in *fault_object_list[] in one execution cycle.
+ * This routine checks all fault objects registered in the fault registry in one execution cycle
+ * (or all listed fault objects, if the registry has fallen back to list scan mode).
  * any fault action triggered will be executed immediately after every individual fault object 
- * check.
+ * check. The fault conditions of fault objects of fault groups masked in 
+ * fault_registry.groups_disabled are not checked, but their latched fault status is still 
+ * included in the global fault status.
  * ***********************************************************************************************/
 volatile uint16_t exec_FaultCheckAll(void)
 {
     volatile uint16_t i=0, global_fault_present=0, fres=1;
+    volatile FAULT_OBJECT_t* fltobj;
     
-    // First scan through all operating system fault objects for active fault conditions
-    for (i=0; i<os_fltobj_list_size; i++)
-    {
-        // only test objects which have been enabled for fault testing
-        if (os_fault_object_list[i] != NULL) {
-        if (os_fault_object_list[i]->status.bits.fltchk_enabled)
-        {
-            fres &= CheckFaultCondition(os_fault_object_list[i]);  // Check fault condition
-            fres &= SetFaultCondition(os_fault_object_list[i]);    // Set fault flags and execute user fault function
-
-            // track global fault status across all objects
-            if(os_fault_object_list[i]->status.bits.fault_status)
-            { global_fault_present |= os_fault_object_list[i]->flt_class.value; }
-
-        }}
-    }
+    // Evaluate composite fault rules first, so fault objects monitoring rule results
+    // respond within the same fault check cycle
+    #if (USE_FAULT_RULES == 1)
+    fres &= exec_FaultRulesAll();
+    #endif
     
+    // Hand over fault objects which have tripped in interrupt context to the fault handler
+    #if (USE_FAULT_FAST_PATH == 1)
+    fres &= exec_FaultFastPathHandoff();
+    #endif
     
-    // Scan through all user-defined fault objects for active fault conditions
-    for (i=0; i<user_fltobj_list_size; i++)
+    // Scan through all registered fault objects for active fault conditions
+    for (i=0; i<fault_registry.scan_size; i++)
     {
+        // skip empty registry slots
+        fltobj = GetFaultScanObject(i);
+        
         // only test objects which have been enabled for fault testing
-        if (user_fault_object_list[i] != NULL) {
-        if (user_fault_object_list[i]->status.bits.fltchk_enabled)
+        if ((fltobj != NULL) && (fltobj->status.bits.fltchk_enabled))
         {
-            fres &= CheckFaultCondition(user_fault_object_list[i]);  // Check fault condition
-            fres &= SetFaultCondition(user_fault_object_list[i]);    // Set fault flags and execute user fault function
+            // skip fault condition checks of fault objects of masked fault groups
+            if(!(fltobj->groups & fault_registry.groups_disabled))
+            {
+                fres &= CheckFaultCondition(fltobj);  // Check fault condition
+                fres &= SetFaultCondition(fltobj);    // Set fault flags and execute user fault function
+            }
 
-            // track global fault status across all objects
-            if(user_fault_object_list[i]->status.bits.fault_status)
-            { global_fault_present |= user_fault_object_list[i]->flt_class.value; }
+            // track global fault status across all objects, incl. latched faults of masked fault groups
+            if(fltobj->status.bits.fault_status)
+            { global_fault_present |= fltobj->flt_class.value; }
 
-        }}
+        }
     }
 
     // =============================================================================
@@ -731,33 +1162,12 @@ volatile uint16_t exec_FaultCheckAll(void)
     fres &= ExecGlobalFaultFlagRelease((FAULT_OBJECT_CLASS_e)global_fault_present);
         
     // Set/reset operating mode when global fault flag has been cleared 
+    #if (USE_FAULT_RECOVERY_ENGINE == 1)
+    fres &= exec_FaultRecovery(); // staged, time-sequenced recovery
+    #else
     if((task_mgr.op_mode.value == OP_MODE_FAULT) && (!task_mgr.status.bits.global_fault))
-    { 
-        // when recovering from active fault, check if user recovery functions in OS fault 
-        // objects have to be executed
-        for (i=0; i<user_fltobj_list_size; i++)
-        {
-            if(os_fault_object_list[i] != NULL) {
-            if(os_fault_object_list[i]->status.bits.fltchk_enabled)
-            { fres &= ExecFaultFlagReleaseHandler(os_fault_object_list[i]); }
-            }
-        }    
-
-        // then check for pending recovery functions of USER fault objects
-        for (i=0; i<user_fltobj_list_size; i++)
-        {
-            if(user_fault_object_list[i] != NULL) {
-            if(user_fault_object_list[i]->status.bits.fltchk_enabled)
-            { fres &= ExecFaultFlagReleaseHandler(user_fault_object_list[i]); }
-            }
-        }    
-
-        task_mgr.status.bits.fault_override = false;   // Reset global fault override flag
-        task_mgr.status.bits.startup_sequence_complete = false; // Reset startup sequence complete flag
-        task_mgr.pre_op_mode.value = OP_MODE_FAULT;  // set pre_op_mode to provoke op-mode switch-over
-        task_mgr.op_mode.value = OP_MODE_STARTUP_SEQUENCE; // set op_mode to provoke op-mode switch-over
-
-    } 
+    { fres &= ExecFaultRecoveryRestart(); } // immediate recovery
+    #endif
         
     return(fres);
 
@@ -0,0 +1,268 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ * ***************************************************************************/
+/*!fdrv_FaultLatency.c
+ * ****************************************************************************
+ * File:   fdrv_FaultLatency.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file provides the optional latency instrumentation of the fault
+ * handler. Time stamps of the first threshold violation, trip event, fault
+ * response completion and fault task queue entry are captured per fault object
+ * and the resulting latencies are accumulated in logarithmic histograms.
+ *
+ * Time stamps are derived from the task manager timer through the register
+ * pointers in task_mgr.os_timer. Host simulations may point these at plain
+ * variables to run this module unchanged. The histograms can be decoded using
+ * tools/fault_latency_report.py.
+ *
+ ******************************************************************************/
+
+#include "xc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#include "_root/generic/os_Globals.h"
+#include "_root/generic/fdrv_FaultLatency.h"
+
+// data structure holding latency records of all instrumented fault objects
+volatile FAULT_LATENCY_t fault_latency;
+
+/* private function prototypes */
+inline volatile uint16_t AddFaultLatencySample(volatile FAULT_LATENCY_RECORD_t* rec,
+            volatile FAULT_LATENCY_STAGE_e stage, volatile uint32_t latency);
+
+/*!ClearFaultLatencyStatistics
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Clears all time stamps, pending events and histograms of all latency records.
+ * ***********************************************************************************************/
+volatile uint16_t ClearFaultLatencyStatistics(void)
+{
+    volatile uint16_t i=0, j=0, k=0;
+
+    for(i=0; i<FAULT_LATENCY_OBJECT_COUNT; i++)
+    {
+        fault_latency.record[i].t_violation = 0;
+        fault_latency.record[i].t_trip = 0;
+        fault_latency.record[i].t_response = 0;
+        fault_latency.record[i].queue_pending = false;
+
+        for(j=0; j<FAULT_LATENCY_STAGE_COUNT; j++)
+        {
+            fault_latency.record[i].sample_count[j] = 0;
+            fault_latency.record[i].latency_max[j] = 0;
+
+            for(k=0; k<FAULT_LATENCY_BINS; k++)
+            { fault_latency.record[i].histogram[j][k] = 0; }
+        }
+    }
+
+    fault_latency.object_count = FAULT_LATENCY_OBJECT_COUNT;
+
+    return(1);
+}
+
+/*!os_FaultLatency_Initialize
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Resets the latency instrumentation. This function is called by os_FaultObjects_Initialize().
+ * ***********************************************************************************************/
+volatile uint16_t os_FaultLatency_Initialize(void)
+{
+    return(ClearFaultLatencyStatistics());
+}
+
+/*!AddFaultLatencySample
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_LATENCY_RECORD_t* rec: Pointer to the latency record of a fault object
+ *      FAULT_LATENCY_STAGE_e stage: Latency stage the sample belongs to
+ *      uint32_t latency: Measured latency in timer cycles
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Sorts the given latency into the histogram of the given stage and updates sample count and
+ * maximum latency. The bin index is the base-4 logarithm of the latency, which is bounded by
+ * FAULT_LATENCY_BINS loop iterations.
+ * ***********************************************************************************************/
+volatile uint16_t AddFaultLatencySample(volatile FAULT_LATENCY_RECORD_t* rec,
+            volatile FAULT_LATENCY_STAGE_e stage, volatile uint32_t latency)
+{
+    uint32_t value = (latency >> 2);
+    uint16_t bin = 0;
+
+    while((value > 0) && (bin < (FAULT_LATENCY_BINS-1)))
+    { value >>= 2; bin++; }
+
+    if(rec->histogram[stage][bin] < 0xFFFF)
+    { rec->histogram[stage][bin]++; }
+
+    if(rec->sample_count[stage] < 0xFFFF)
+    { rec->sample_count[stage]++; }
+
+    if(latency > rec->latency_max[stage])
+    { rec->latency_max[stage] = latency; }
+
+    return(1);
+}
+
+/*!CaptureFaultLatencyEvent
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to the fault object the event belongs to
+ *      FAULT_LATENCY_EVENT_e event: Event along the fault response path
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Captures the time stamp of the given event of the given fault object and, if the event
+ * completes a latency stage, adds the measured latency to the histogram of this stage.
+ * When a fault object of class FLT_CLASS_CRITICAL trips while the fault task queue is not
+ * active, the fault queue entry is marked pending and completed by
+ * CaptureFaultLatencyQueueEntry().
+ * Fault objects with IDs beyond FAULT_LATENCY_OBJECT_COUNT are ignored.
+ * ***********************************************************************************************/
+volatile uint16_t CaptureFaultLatencyEvent(volatile FAULT_OBJECT_t* fltobj, volatile FAULT_LATENCY_EVENT_e event)
+{
+    volatile uint16_t fres=1;
+    volatile uint32_t timestamp = os_GetSystemTimestamp();
+    volatile FAULT_LATENCY_RECORD_t* rec;
+
+    // if the fault object is not initialized or not tracked, exit here
+    if(fltobj == NULL) { return(1); }
+    if(fltobj->id >= FAULT_LATENCY_OBJECT_COUNT) { return(1); }
+
+    rec = &fault_latency.record[fltobj->id];
+
+    switch(event)
+    {
+        case FLTLAT_EVENT_VIOLATION:
+            rec->t_violation = timestamp;
+            break;
+
+        case FLTLAT_EVENT_TRIP:
+            rec->t_trip = timestamp;
+            fres &= AddFaultLatencySample(rec, FLTLAT_STAGE_DETECT, (timestamp - rec->t_violation));
+
+            // fault queue entry is only expected if it has not been entered yet
+            rec->queue_pending = (bool)((fltobj->flt_class.value & FLT_CLASS_CRITICAL) &&
+                                        (task_mgr.pre_op_mode.value != OP_MODE_FAULT));
+            break;
+
+        case FLTLAT_EVENT_RESPONSE:
+            rec->t_response = timestamp;
+            fres &= AddFaultLatencySample(rec, FLTLAT_STAGE_RESPONSE, (timestamp - rec->t_trip));
+            break;
+
+        default:
+            // fault queue entries are captured by CaptureFaultLatencyQueueEntry()
+            return(0);
+    }
+
+    return(fres);
+}
+
+/*!SetFaultLatencyViolation
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to the fault object the violation belongs to
+ *      uint32_t timestamp: Time stamp of the threshold violation (see os_GetSystemTimestamp())
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Sets the violation time stamp of the given fault object to a time stamp which has been
+ * captured earlier, e.g. by the fault fast path in interrupt context. The subsequent trip
+ * event measures the detect latency from this time stamp.
+ * Fault objects with IDs beyond FAULT_LATENCY_OBJECT_COUNT are ignored.
+ * ***********************************************************************************************/
+volatile uint16_t SetFaultLatencyViolation(volatile FAULT_OBJECT_t* fltobj, volatile uint32_t timestamp)
+{
+    // if the fault object is not initialized or not tracked, exit here
+    if(fltobj == NULL) { return(1); }
+    if(fltobj->id >= FAULT_LATENCY_OBJECT_COUNT) { return(1); }
+
+    fault_latency.record[fltobj->id].t_violation = timestamp;
+
+    return(1);
+}
+
+/*!CaptureFaultLatencyQueueEntry
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * This routine is called by the task manager when switching over to the fault task queue. It
+ * completes the queue entry latency stage of all fault objects with a pending queue entry.
+ * ***********************************************************************************************/
+volatile uint16_t CaptureFaultLatencyQueueEntry(void)
+{
+    volatile uint16_t fres=1, i=0;
+    volatile uint32_t timestamp = os_GetSystemTimestamp();
+
+    for(i=0; i<FAULT_LATENCY_OBJECT_COUNT; i++)
+    {
+        if(fault_latency.record[i].queue_pending)
+        {
+            fault_latency.record[i].queue_pending = false;
+            fres &= AddFaultLatencySample(&fault_latency.record[i], FLTLAT_STAGE_QUEUE,
+                        (timestamp - fault_latency.record[i].t_trip));
+        }
+    }
+
+    return(fres);
+}
+
+// EOF
@@ -0,0 +1,259 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ * ***************************************************************************/
+/*!fdrv_FaultLog.c
+ * ****************************************************************************
+ * File:   fdrv_FaultLog.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file provides the persistent fault history log. Fault trip
+ * events are recorded in a fixed-size ring buffer located in persistent RAM,
+ * which survives warm CPU resets. The log can be decoded on the host using
+ * tools/fault_log_decoder.py.
+ *
+ ******************************************************************************/
+
+#include "xc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#include "_root/generic/os_Globals.h"
+#include "_root/generic/fdrv_FaultLog.h"
+
+// data structure used as persistent fault history buffer
+volatile __attribute__((__persistent__)) FAULT_LOG_t fault_log;
+
+/* private function prototypes */
+inline volatile uint32_t ReadFaultSourceValue(volatile FAULT_OBJECT_t* fltobj);
+
+/*!ReadFaultSourceValue
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to fault object fltobj of type FAULT_OBJECT_t
+ *
+ * Return:
+ *      type: uint32_t
+ *      Raw value of the source object (16-bit values are zero-/sign-extended)
+ *
+ * Description:
+ * Reads the monitored source object of the given fault object based on its source data type.
+ * ***********************************************************************************************/
+volatile uint32_t ReadFaultSourceValue(volatile FAULT_OBJECT_t* fltobj)
+{
+    if(fltobj->criteria.source_object == NULL) { return(0); }
+
+    switch(fltobj->criteria.source_type)
+    {
+        case FLTOBJ_SOURCE_TYPE_INT16:
+        case FLTOBJ_SOURCE_TYPE_Q15:
+            return((uint32_t)((int32_t)((int16_t)((*fltobj->criteria.source_object) & fltobj->criteria.source_bit_mask))));
+
+        case FLTOBJ_SOURCE_TYPE_UINT32:
+        case FLTOBJ_SOURCE_TYPE_INT32:
+            return(*((volatile uint32_t*)fltobj->criteria.source_object));
+
+        default:
+            return((uint32_t)((*fltobj->criteria.source_object) & fltobj->criteria.source_bit_mask));
+    }
+}
+
+/*!ClearFaultLog
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Clears all records and statistics of the persistent fault log and sets the log signature.
+ * ***********************************************************************************************/
+volatile uint16_t ClearFaultLog(void)
+{
+    volatile uint16_t i=0;
+
+    for(i=0; i<FAULT_LOG_SIZE; i++)
+    {
+        fault_log.entry[i].fault_id = 0;
+        fault_log.entry[i].op_mode = 0;
+        fault_log.entry[i].task_id = 0;
+        fault_log.entry[i].boot_count = 0;
+        fault_log.entry[i].timestamp = 0;
+        fault_log.entry[i].source_value = 0;
+        fault_log.entry[i].time_in_fault = 0;
+    }
+
+    for(i=0; i<FAULT_LOG_OBJECT_COUNT; i++)
+    {
+        fault_log.trip_count[i] = 0;
+        fault_log.fault_time[i] = 0;
+        fault_log.open_entry[i] = FAULT_LOG_INDEX_NONE;
+    }
+
+    fault_log.index = 0;
+    fault_log.event_count = 0;
+    fault_log.boot_count = 0;
+    fault_log.signature = FAULT_LOG_SIGNATURE;
+    fault_log.signature_inv = (uint16_t)(~FAULT_LOG_SIGNATURE);
+
+    return(1);
+}
+
+/*!os_FaultLog_Initialize
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Checks the persistent fault log for valid contents. After power-up or if the log has been
+ * corrupted, the log is cleared. Otherwise all records are preserved, the boot counter is
+ * incremented and open records of faults, which were active when the CPU was reset, are closed
+ * (their time-in-fault remains FAULT_LOG_TIME_OPEN).
+ * ***********************************************************************************************/
+volatile uint16_t os_FaultLog_Initialize(void)
+{
+    volatile uint16_t fres=1, i=0;
+
+    if ((fault_log.signature != FAULT_LOG_SIGNATURE) ||
+        (fault_log.signature_inv != (uint16_t)(~FAULT_LOG_SIGNATURE)) ||
+        (fault_log.index >= FAULT_LOG_SIZE))
+    {
+        fres &= ClearFaultLog();
+    }
+
+    if(fault_log.boot_count < 0xFFFF)
+    { fault_log.boot_count++; }
+
+    for(i=0; i<FAULT_LOG_OBJECT_COUNT; i++)
+    { fault_log.open_entry[i] = FAULT_LOG_INDEX_NONE; }
+
+    return(fres);
+}
+
+/*!CaptureFaultLogEntry
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to fault object fltobj of type FAULT_OBJECT_t which has
+ *          just tripped
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Writes a new record into the fault log ring buffer, overwriting the oldest record, and
+ * increments the trip counter of the fault object ID. This function has constant execution
+ * time and is called by the fault handler after the fault response has been executed.
+ * ***********************************************************************************************/
+volatile uint16_t CaptureFaultLogEntry(volatile FAULT_OBJECT_t* fltobj)
+{
+    volatile uint16_t index = fault_log.index;
+    volatile FAULT_LOG_ENTRY_t* entry = &fault_log.entry[index];
+
+    // if the fault object is not initialized, exit here
+    if(fltobj == NULL) { return(1); }
+
+    entry->fault_id = fltobj->id;
+    entry->op_mode = (uint8_t)task_mgr.op_mode.value;
+    entry->task_id = (uint8_t)task_mgr.task_queue.active_task_id;
+    entry->boot_count = fault_log.boot_count;
+    entry->timestamp = task_mgr.os_timer.tick_counter;
+    entry->source_value = ReadFaultSourceValue(fltobj);
+    entry->time_in_fault = FAULT_LOG_TIME_OPEN;
+
+    // update occurrence statistics
+    if(fltobj->id < FAULT_LOG_OBJECT_COUNT)
+    {
+        if(fault_log.trip_count[fltobj->id] < 0xFFFF)
+        { fault_log.trip_count[fltobj->id]++; }
+        fault_log.open_entry[fltobj->id] = index;
+    }
+
+    if(fault_log.event_count < 0xFFFF)
+    { fault_log.event_count++; }
+
+    // advance ring buffer index
+    if(++index >= FAULT_LOG_SIZE) { index = 0; }
+    fault_log.index = index;
+
+    return(1);
+}
+
+/*!ReleaseFaultLogEntry
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to fault object fltobj of type FAULT_OBJECT_t which has
+ *          just been released
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Closes the open record of the given fault object by setting its time-in-fault and adds this
+ * period to the accumulated time-in-fault of the fault object ID. If the open record has
+ * already been overwritten by newer events, no time-in-fault is recorded.
+ * This function has constant execution time.
+ * ***********************************************************************************************/
+volatile uint16_t ReleaseFaultLogEntry(volatile FAULT_OBJECT_t* fltobj)
+{
+    volatile uint16_t index=0;
+    volatile uint32_t time_in_fault=0;
+    volatile FAULT_LOG_ENTRY_t* entry;
+
+    // if the fault object is not initialized or not tracked, exit here
+    if(fltobj == NULL) { return(1); }
+    if(fltobj->id >= FAULT_LOG_OBJECT_COUNT) { return(1); }
+
+    index = fault_log.open_entry[fltobj->id];
+    if(index >= FAULT_LOG_SIZE) { return(1); } // no open record
+
+    fault_log.open_entry[fltobj->id] = FAULT_LOG_INDEX_NONE;
+    entry = &fault_log.entry[index];
+
+    // check if the record still belongs to this fault object
+    if((entry->fault_id != fltobj->id) || (entry->time_in_fault != FAULT_LOG_TIME_OPEN))
+    { return(1); }
+
+    time_in_fault = (task_mgr.os_timer.tick_counter - entry->timestamp);
+    if(time_in_fault == FAULT_LOG_TIME_OPEN) { time_in_fault--; }
+    entry->time_in_fault = time_in_fault;
+
+    // accumulate time-in-fault (saturating)
+    if((fault_log.fault_time[fltobj->id] + time_in_fault) < fault_log.fault_time[fltobj->id])
+    { fault_log.fault_time[fltobj->id] = 0xFFFFFFFF; }
+    else
+    { fault_log.fault_time[fltobj->id] += time_in_fault; }
+
+    return(1);
+}
+
+// EOF
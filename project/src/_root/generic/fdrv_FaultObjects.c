@@ -108,6 +108,7 @@ volatile uint16_t CPUFailureObject_Initialize(void)
     
     // configuring the trip and reset levels as well as trip and reset event filter setting
     fltobj_CPUFailure.criteria.compare_type = FAULT_LEVEL_EQUAL;
+    fltobj_CPUFailure.criteria.source_type = FLTOBJ_SOURCE_TYPE_UINT16; // Data type of source and compare object
     fltobj_CPUFailure.criteria.trip_level = 1;   // Set/reset trip level value
     fltobj_CPUFailure.criteria.trip_cnt_threshold = 1; // Set/reset number of successive trips before triggering fault event
     fltobj_CPUFailure.criteria.reset_level = 1;  // Set/reset fault release level value
@@ -120,6 +121,8 @@ volatile uint16_t CPUFailureObject_Initialize(void)
     fltobj_CPUFailure.flt_class.bits.critical = 0; // Set =1 if this fault object triggers a critical fault condition response
     fltobj_CPUFailure.flt_class.bits.catastrophic = 1; // Set =1 if this fault object triggers a catastrophic fault condition response
 
+    fltobj_CPUFailure.groups = FLTGRP_CPU; // Fault group membership (groups can be masked by the fault registry)
+
     fltobj_CPUFailure.flt_class.bits.user_class = 1; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_CPUFailure.trip_function = &APPLICATION_Reset; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_CPUFailure.reset_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
@@ -159,6 +162,7 @@ volatile uint16_t CPULoadOverrunFaultObject_Initialize(void)
     fltobj_CPULoadOverrun.criteria.compare_object = NULL;  // not used => comparison against constant value
     fltobj_CPULoadOverrun.criteria.compare_bit_mask = FLTOBJ_BIT_MASK_DEFAULT; // Compare all 16 it of 'compare'
     fltobj_CPULoadOverrun.criteria.compare_type = FAULT_LEVEL_LESS_THAN;
+    fltobj_CPULoadOverrun.criteria.source_type = FLTOBJ_SOURCE_TYPE_UINT16; // Data type of source and compare object
     fltobj_CPULoadOverrun.criteria.trip_level = CPU_LOAD_WARNING;   // Set/reset trip level value
     fltobj_CPULoadOverrun.criteria.trip_cnt_threshold = 1; // Set/reset number of successive trips before triggering fault event
     fltobj_CPULoadOverrun.criteria.reset_level = CPU_LOAD_NORMAL;  // Set/reset fault release level value
@@ -171,6 +175,8 @@ volatile uint16_t CPULoadOverrunFaultObject_Initialize(void)
     fltobj_CPULoadOverrun.flt_class.bits.critical = 0; // Set =1 if this fault object triggers a critical fault condition response
     fltobj_CPULoadOverrun.flt_class.bits.catastrophic = 0; // Set =1 if this fault object triggers a catastrophic fault condition response
 
+    fltobj_CPULoadOverrun.groups = FLTGRP_CPU; // Fault group membership (groups can be masked by the fault registry)
+
     fltobj_CPULoadOverrun.flt_class.bits.user_class = 0; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_CPULoadOverrun.trip_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_CPULoadOverrun.reset_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
@@ -209,6 +215,7 @@ volatile uint16_t TaskExecutionFaultObject_Initialize(void)
     fltobj_TaskExecutionFailure.criteria.compare_object = NULL;  // not used => comparison against constant value
     fltobj_TaskExecutionFailure.criteria.compare_bit_mask = FLTOBJ_BIT_MASK_DEFAULT;
     fltobj_TaskExecutionFailure.criteria.compare_type = FAULT_LEVEL_NOT_EQUAL;
+    fltobj_TaskExecutionFailure.criteria.source_type = FLTOBJ_SOURCE_TYPE_UINT16; // Data type of source and compare object
     fltobj_TaskExecutionFailure.criteria.trip_level = 1;   // Set/reset trip level value
     fltobj_TaskExecutionFailure.criteria.trip_cnt_threshold = 1; // Set/reset number of successive trips before triggering fault event
     fltobj_TaskExecutionFailure.criteria.reset_level = 1;  // Set/reset fault release level value
@@ -221,6 +228,8 @@ volatile uint16_t TaskExecutionFaultObject_Initialize(void)
     fltobj_TaskExecutionFailure.flt_class.bits.critical = 0; // Set =1 if this fault object triggers a critical fault condition response
     fltobj_TaskExecutionFailure.flt_class.bits.catastrophic = 0; // Set =1 if this fault object triggers a catastrophic fault condition response
 
+    fltobj_TaskExecutionFailure.groups = FLTGRP_OS; // Fault group membership (groups can be masked by the fault registry)
+
     fltobj_TaskExecutionFailure.flt_class.bits.user_class = 0; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_TaskExecutionFailure.trip_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_TaskExecutionFailure.reset_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
@@ -258,6 +267,7 @@ volatile uint16_t TaskTimeQuotaViolationFaultObject_Initialize(void)
     fltobj_TaskTimeQuotaViolation.criteria.compare_object = NULL;  // not used => comparison against constant value
     fltobj_TaskTimeQuotaViolation.criteria.compare_bit_mask = FLTOBJ_BIT_MASK_DEFAULT;
     fltobj_TaskTimeQuotaViolation.criteria.compare_type = FAULT_LEVEL_GREATER_THAN;
+    fltobj_TaskTimeQuotaViolation.criteria.source_type = FLTOBJ_SOURCE_TYPE_UINT16; // Data type of source and compare object
     fltobj_TaskTimeQuotaViolation.criteria.trip_level = task_mgr.os_timer.master_period;   // Set/reset trip level value
     fltobj_TaskTimeQuotaViolation.criteria.trip_cnt_threshold = 1; // Set/reset number of successive trips before triggering fault event
     fltobj_TaskTimeQuotaViolation.criteria.reset_level = (uint16_t)(0.9 * (float)task_mgr.os_timer.master_period);  // Set/reset fault release level value
@@ -270,6 +280,8 @@ volatile uint16_t TaskTimeQuotaViolationFaultObject_Initialize(void)
     fltobj_TaskTimeQuotaViolation.flt_class.bits.critical = 0; // Set =1 if this fault object triggers a critical fault condition response
     fltobj_TaskTimeQuotaViolation.flt_class.bits.catastrophic = 0; // Set =1 if this fault object triggers a catastrophic fault condition response
 
+    fltobj_TaskTimeQuotaViolation.groups = FLTGRP_OS; // Fault group membership (groups can be masked by the fault registry)
+
     fltobj_TaskTimeQuotaViolation.flt_class.bits.user_class = 0; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_TaskTimeQuotaViolation.trip_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_TaskTimeQuotaViolation.reset_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
@@ -306,6 +318,7 @@ volatile uint16_t OSComponentFailureFaultObject_Initialize(void)
     fltobj_OSComponentFailure.criteria.compare_object = NULL;  // not used => comparison against constant value
     fltobj_OSComponentFailure.criteria.compare_bit_mask = FLTOBJ_BIT_MASK_DEFAULT;
     fltobj_OSComponentFailure.criteria.compare_type = FAULT_LEVEL_BOOLEAN;
+    fltobj_OSComponentFailure.criteria.source_type = FLTOBJ_SOURCE_TYPE_UINT16; // Data type of source and compare object
     fltobj_OSComponentFailure.criteria.trip_level = true;   // Set/reset trip level value
     fltobj_OSComponentFailure.criteria.trip_cnt_threshold = 1; // Set/reset number of successive trips before triggering fault event
     fltobj_OSComponentFailure.criteria.reset_level = false;  // Set/reset fault release level value
@@ -318,6 +331,8 @@ volatile uint16_t OSComponentFailureFaultObject_Initialize(void)
     fltobj_OSComponentFailure.flt_class.bits.critical = 0; // Set =1 if this fault object triggers a critical fault condition response
     fltobj_OSComponentFailure.flt_class.bits.catastrophic = 0; // Set =1 if this fault object triggers a catastrophic fault condition response
 
+    fltobj_OSComponentFailure.groups = FLTGRP_OS; // Fault group membership (groups can be masked by the fault registry)
+
     fltobj_OSComponentFailure.flt_class.bits.user_class = 0; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_OSComponentFailure.trip_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_OSComponentFailure.reset_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
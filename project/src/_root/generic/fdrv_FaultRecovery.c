@@ -0,0 +1,245 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ * ***************************************************************************/
+/*!fdrv_FaultRecovery.c
+ * ****************************************************************************
+ * File:   fdrv_FaultRecovery.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file provides the staged fault recovery engine. Instead of
+ * restarting the system as soon as all fault conditions have been cleared,
+ * the recovery engine waits for a cool-down period, which grows with every
+ * restart attempt (backoff), re-enables fault groups stage by stage during
+ * the startup sequence and locks the system in fault mode after too many
+ * restart attempts within the retry window.
+ *
+ ******************************************************************************/
+
+#include "xc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#include "_root/generic/os_Globals.h"
+#include "_root/generic/fdrv_FaultRecovery.h"
+
+// status of the fault recovery engine
+volatile FAULT_RECOVERY_t fault_recovery;
+
+/* private function prototypes */
+static inline volatile uint16_t GetFaultRecoveryStageGroups(void);
+
+/*!GetFaultRecoveryStageGroups
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      Combined fault group mask of all recovery stages
+ *
+ * Description:
+ * Combines the fault group masks of all entries of user_fault_recovery_stages[].
+ * ***********************************************************************************************/
+static inline volatile uint16_t GetFaultRecoveryStageGroups(void)
+{
+    volatile uint16_t i=0, groups=0;
+
+    for(i=0; i<user_fault_recovery_stages_size; i++)
+    { groups |= user_fault_recovery_stages[i]; }
+
+    return(groups);
+}
+
+/*!os_FaultRecovery_Initialize
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Resets the fault recovery engine. This function is called by os_FaultObjects_Initialize().
+ * ***********************************************************************************************/
+volatile uint16_t os_FaultRecovery_Initialize(void)
+{
+    fault_recovery.state = FLTREC_STATE_STANDBY;
+    fault_recovery.stage = 0;
+    fault_recovery.attempts = 0;
+    fault_recovery.lockout_count = 0;
+    fault_recovery.timestamp = 0;
+    fault_recovery.window_start = 0;
+    fault_recovery.cool_down = FAULT_RECOVERY_COOL_DOWN;
+
+    return(1);
+}
+
+/*!ClearFaultRecoveryLockout
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure (recovery engine is not in lockout state)
+ *      1: Success
+ *
+ * Description:
+ * Releases the recovery engine from lockout state. The retry counter is cleared and the recovery
+ * continues with the cool-down period once all fault conditions have been cleared.
+ *
+ * Please note:
+ * The operating system never calls this function. Releasing a lockout is a decision of the user
+ * application, which calls this function from its own command path (e.g. a user task evaluating
+ * an operator reset command received via the communication interface). Without such a call,
+ * the lockout is only cleared by a CPU reset or a warm restart, which both re-initialize the 
+ * recovery engine by os_FaultRecovery_Initialize().
+ * ***********************************************************************************************/
+volatile uint16_t ClearFaultRecoveryLockout(void)
+{
+    if(fault_recovery.state != FLTREC_STATE_LOCKOUT) { return(0); }
+
+    fault_recovery.attempts = 0;
+    fault_recovery.state = FLTREC_STATE_FAULT;
+
+    return(1);
+}
+
+/*!exec_FaultRecovery
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * This routine executes one step of the fault recovery state machine (see FAULT_RECOVERY_STATE_e).
+ * It is called by exec_FaultCheckAll() after all fault objects have been checked and the global
+ * fault flags have been updated. Periods are measured using the system tick counter and are
+ * therefore independent from the number of fault check calls.
+ * ***********************************************************************************************/
+volatile uint16_t exec_FaultRecovery(void)
+{
+    volatile uint16_t fres=1;
+    volatile uint32_t now = task_mgr.os_timer.tick_counter;
+    volatile uint16_t backoff=0;
+
+    switch(fault_recovery.state)
+    {
+        case FLTREC_STATE_STANDBY:
+        // wait for the system to enter fault mode
+            if(task_mgr.op_mode.value == OP_MODE_FAULT)
+            { fault_recovery.state = FLTREC_STATE_FAULT; }
+            break;
+
+        case FLTREC_STATE_FAULT:
+        // wait for all fault conditions to be cleared
+            if((task_mgr.op_mode.value == OP_MODE_FAULT) && (!task_mgr.status.bits.global_fault))
+            {
+                // restart attempts older than the retry window are forgotten
+                if((now - fault_recovery.window_start) > FAULT_RECOVERY_WINDOW)
+                { fault_recovery.attempts = 0; }
+
+                // double the cool-down period with every recent restart attempt
+                backoff = fault_recovery.attempts;
+                if(backoff > FAULT_RECOVERY_BACKOFF_MAX) { backoff = FAULT_RECOVERY_BACKOFF_MAX; }
+                fault_recovery.cool_down = ((uint32_t)FAULT_RECOVERY_COOL_DOWN << backoff);
+
+                fault_recovery.timestamp = now;
+                fault_recovery.state = FLTREC_STATE_COOL_DOWN;
+            }
+            break;
+
+        case FLTREC_STATE_COOL_DOWN:
+        // wait for the cool-down period to expire while fault conditions remain cleared
+            if(task_mgr.status.bits.global_fault)
+            {
+                fault_recovery.state = FLTREC_STATE_FAULT; // fault condition reappeared
+            }
+            else if((now - fault_recovery.timestamp) >= fault_recovery.cool_down)
+            {
+                if(fault_recovery.attempts == 0)
+                { fault_recovery.window_start = now; }
+
+                // in degraded mode only one restart attempt is allowed within the retry window
+                if((fault_recovery.attempts >= FAULT_RECOVERY_ATTEMPTS_MAX) ||
+                   ((task_mgr.status.bits.degraded_mode) && (fault_recovery.attempts > 0)))
+                {
+                    // too many restart attempts within the retry window => lock system in fault mode
+                    if(fault_recovery.lockout_count < 0xFFFF)
+                    { fault_recovery.lockout_count++; }
+                    fault_recovery.state = FLTREC_STATE_LOCKOUT;
+                }
+                else
+                {
+                    // launch startup sequence and mask staged fault groups
+                    // (user recovery functions of staged fault groups are executed before masking)
+                    fault_recovery.attempts++;
+                    fres &= ExecFaultRecoveryRestart();
+                    fres &= DisableFaultGroups(GetFaultRecoveryStageGroups());
+
+                    fault_recovery.stage = 0;
+                    fault_recovery.timestamp = now;
+                    fault_recovery.state = FLTREC_STATE_STAGED_ENABLE;
+                }
+            }
+            break;
+
+        case FLTREC_STATE_STAGED_ENABLE:
+        // re-enable fault groups stage by stage
+            if(task_mgr.op_mode.value == OP_MODE_FAULT)
+            {
+                // fault during startup => unmask all staged groups and start over
+                fres &= EnableFaultGroups(GetFaultRecoveryStageGroups());
+                fault_recovery.state = FLTREC_STATE_FAULT;
+            }
+            else if(fault_recovery.stage >= user_fault_recovery_stages_size)
+            {
+                fault_recovery.state = FLTREC_STATE_STANDBY; // recovery complete
+            }
+            else if((now - fault_recovery.timestamp) >= FAULT_RECOVERY_STAGE_DELAY)
+            {
+                fres &= EnableFaultGroups(user_fault_recovery_stages[fault_recovery.stage]);
+                fault_recovery.stage++;
+                fault_recovery.timestamp = now;
+            }
+            break;
+
+        case FLTREC_STATE_LOCKOUT:
+        // remain in fault mode until the lockout is cleared
+            break;
+
+        default:
+            fault_recovery.state = FLTREC_STATE_FAULT;
+            fres = 0;
+            break;
+    }
+
+    return(fres);
+}
+
+// EOF
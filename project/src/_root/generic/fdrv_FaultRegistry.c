@@ -0,0 +1,231 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ * ***************************************************************************/
+/*!fdrv_FaultRegistry.c
+ * ****************************************************************************
+ * File:   fdrv_FaultRegistry.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file provides the fault object registry. All fault objects are
+ * registered by their fault object ID, allowing constant-time access by ID,
+ * and by their fault group membership, allowing entire groups of fault
+ * objects to be masked by a single word write.
+ *
+ ******************************************************************************/
+
+#include "xc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#include "_root/generic/os_Globals.h"
+#include "_root/generic/fdrv_FaultRegistry.h"
+
+// fault object registry indexed by fault object ID
+volatile FAULT_REGISTRY_t fault_registry;
+
+/*!RegisterFaultObject
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_OBJECT_t* fltobj: Pointer to an initialized fault object
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure (fault object ID is out of range or already in use by another fault object)
+ *      1: Success
+ *
+ * Description:
+ * Adds the given fault object to the registry slot of its fault object ID and copies its fault
+ * group membership into the registry.
+ * ***********************************************************************************************/
+volatile uint16_t RegisterFaultObject(volatile FAULT_OBJECT_t* fltobj)
+{
+    if(fltobj == NULL) { return(1); }
+    if(fltobj->id >= FAULT_REGISTRY_SIZE) { return(0); }
+
+    if((fault_registry.object[fltobj->id] != NULL) && (fault_registry.object[fltobj->id] != fltobj))
+    { return(0); } // fault object ID is not unique
+
+    fault_registry.object[fltobj->id] = fltobj;
+    fault_registry.groups[fltobj->id] = fltobj->groups;
+
+    if(fltobj->id >= fault_registry.size)
+    { fault_registry.size = (fltobj->id + 1); }
+
+    return(1);
+}
+
+/*!os_FaultRegistry_Initialize
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Clears the registry, unmasks all fault groups and registers all fault objects listed in
+ * os_fault_object_list[] and user_fault_object_list[]. This function must be called after
+ * all fault objects have been initialized. If any fault object cannot be registered, the
+ * fault handler falls back to scanning the fault object lists.
+ * ***********************************************************************************************/
+volatile uint16_t os_FaultRegistry_Initialize(void)
+{
+    volatile uint16_t fres=1, i=0;
+
+    for(i=0; i<FAULT_REGISTRY_SIZE; i++)
+    {
+        fault_registry.object[i] = NULL;
+        fault_registry.groups[i] = FLTGRP_NONE;
+    }
+
+    fault_registry.size = 0;
+    fault_registry.groups_disabled = FLTGRP_NONE;
+
+    for(i=0; i<os_fltobj_list_size; i++)
+    { fres &= RegisterFaultObject(os_fault_object_list[i]); }
+
+    for(i=0; i<user_fltobj_list_size; i++)
+    { fres &= RegisterFaultObject(user_fault_object_list[i]); }
+
+    // fall back to list scan if any fault object could not be registered
+    fault_registry.list_scan = (bool)(!fres);
+    if(fault_registry.list_scan)
+    { fault_registry.scan_size = (os_fltobj_list_size + user_fltobj_list_size); }
+    else
+    { fault_registry.scan_size = fault_registry.size; }
+
+    return(fres);
+}
+
+/*!GetFaultObject
+ * ***********************************************************************************************
+ * Parameters:
+ *      uint16_t id: Fault object ID
+ *
+ * Return:
+ *      type: FAULT_OBJECT_t*
+ *      NULL: no fault object has been registered with this ID
+ *      else: pointer to the fault object
+ *
+ * Description:
+ * Returns the fault object registered with the given fault object ID in constant time.
+ * ***********************************************************************************************/
+volatile FAULT_OBJECT_t* GetFaultObject(volatile uint16_t id)
+{
+    if(id >= FAULT_REGISTRY_SIZE) { return(NULL); }
+    return(fault_registry.object[id]);
+}
+
+/*!SetFaultObjectEnable
+ * ***********************************************************************************************
+ * Parameters:
+ *      uint16_t id: Fault object ID
+ *      bool enable: true = enable fault check, false = disable fault check
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure (no fault object has been registered with this ID)
+ *      1: Success
+ *
+ * Description:
+ * Enables or disables the fault check of the fault object with the given ID.
+ * ***********************************************************************************************/
+volatile uint16_t SetFaultObjectEnable(volatile uint16_t id, volatile bool enable)
+{
+    volatile FAULT_OBJECT_t* fltobj = GetFaultObject(id);
+
+    if(fltobj == NULL) { return(0); }
+    fltobj->status.bits.fltchk_enabled = enable;
+
+    return(1);
+}
+
+/*!SetFaultObjectGroups
+ * ***********************************************************************************************
+ * Parameters:
+ *      uint16_t id: Fault object ID
+ *      uint16_t groups: Fault group membership bit mask (FAULT_GROUP_e)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure (no fault object has been registered with this ID)
+ *      1: Success
+ *
+ * Description:
+ * Changes the fault group membership of the fault object with the given ID. Fault object and
+ * registry are updated.
+ * ***********************************************************************************************/
+volatile uint16_t SetFaultObjectGroups(volatile uint16_t id, volatile uint16_t groups)
+{
+    volatile FAULT_OBJECT_t* fltobj = GetFaultObject(id);
+
+    if(fltobj == NULL) { return(0); }
+    fltobj->groups = groups;
+    fault_registry.groups[id] = groups;
+
+    return(1);
+}
+
+/*!DisableFaultGroups
+ * ***********************************************************************************************
+ * Parameters:
+ *      uint16_t groups: Bit mask of fault groups to be masked (FAULT_GROUP_e)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Masks the given fault groups. The fault conditions of all fault objects which are member of at
+ * least one masked group are not checked from the next fault check cycle on. Latched fault
+ * states of masked fault objects remain part of the global fault status.
+ * ***********************************************************************************************/
+volatile uint16_t DisableFaultGroups(volatile uint16_t groups)
+{
+    fault_registry.groups_disabled |= groups;
+    return(1);
+}
+
+/*!EnableFaultGroups
+ * ***********************************************************************************************
+ * Parameters:
+ *      uint16_t groups: Bit mask of fault groups to be unmasked (FAULT_GROUP_e)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Unmasks the given fault groups. Fault objects resume their fault checks with the state they
+ * had when their group was masked.
+ * ***********************************************************************************************/
+volatile uint16_t EnableFaultGroups(volatile uint16_t groups)
+{
+    fault_registry.groups_disabled &= ~groups;
+    return(1);
+}
+
+// EOF
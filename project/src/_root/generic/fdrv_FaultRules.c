@@ -0,0 +1,329 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ * ***************************************************************************/
+/*!fdrv_FaultRules.c
+ * ****************************************************************************
+ * File:   fdrv_FaultRules.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file provides the interpreter of composite fault rules. Rules
+ * are compiled into a compact bytecode by the host tool
+ * tools/fault_rule_compiler.py and combine states of fault objects, operating
+ * modes and timers into one boolean result, which is monitored by a common
+ * fault object.
+ *
+ ******************************************************************************/
+
+#include "xc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#include "_root/generic/os_Globals.h"
+#include "_root/generic/fdrv_FaultRules.h"
+
+/* private function prototypes */
+volatile uint16_t ValidateFaultRule(volatile FAULT_RULE_t* rule);
+volatile FAULT_OBJECT_t* GetFaultRuleObject(volatile uint16_t operand);
+inline volatile uint16_t ExecFaultRule(volatile FAULT_RULE_t* rule);
+
+/*!GetFaultRuleObject
+ * ***********************************************************************************************
+ * Parameters:
+ *      uint16_t operand: fault object operand of a rule instruction
+ *
+ * Return:
+ *      type: FAULT_OBJECT_t*
+ *      NULL: fault object does not exist
+ *      else: pointer to the fault object addressed by the operand
+ *
+ * Description:
+ * Bit #7 of the operand selects the OS or user fault object list, bits #6-0 hold the list index.
+ * ***********************************************************************************************/
+volatile FAULT_OBJECT_t* GetFaultRuleObject(volatile uint16_t operand)
+{
+    volatile uint16_t index = (operand & FLTRULE_OPERAND_INDEX_MASK);
+
+    if(operand & FLTRULE_OPERAND_USER_LIST)
+    {
+        if(index >= user_fltobj_list_size) { return(NULL); }
+        return(user_fault_object_list[index]);
+    }
+    else
+    {
+        if(index >= os_fltobj_list_size) { return(NULL); }
+        return(os_fault_object_list[index]);
+    }
+}
+
+/*!ValidateFaultRule
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_RULE_t* rule: Pointer to a fault rule object
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure (rule is invalid and will not be evaluated)
+ *      1: Success
+ *
+ * Description:
+ * Every rule program is checked once during initialization for unknown instructions, invalid
+ * fault object references, timer indices, timer presets of zero cycles, stack under-/overflows 
+ * and program size. A timer preset of zero would make an on-delay true without input. As all these
+ * checks are done up-front, the interpreter does not need to perform any run-time checks, which
+ * keeps the execution time of each rule constant and deterministic.
+ * ***********************************************************************************************/
+volatile uint16_t ValidateFaultRule(volatile FAULT_RULE_t* rule)
+{
+    volatile uint16_t pc=0, opcode=0, operand=0;
+    volatile int16_t depth=0;
+
+    if((rule->program == NULL) || (rule->length == 0) || (rule->length > FLTRULE_PROGRAM_SIZE_MAX))
+    { return(0); }
+
+    while(pc < rule->length)
+    {
+        opcode = (rule->program[pc] >> 8);
+        operand = (rule->program[pc] & 0x00FF);
+        pc++;
+
+        switch(opcode)
+        {
+            case FLTRULE_OP_END:
+                pc = rule->length; // terminate validation
+                break;
+
+            case FLTRULE_OP_ACTIVE:
+            case FLTRULE_OP_STATUS:
+                if(GetFaultRuleObject(operand) == NULL) { return(0); }
+                depth++;
+                break;
+
+            case FLTRULE_OP_OPMODE:
+            case FLTRULE_OP_CONST:
+                depth++;
+                break;
+
+            case FLTRULE_OP_NOT:
+                if(depth < 1) { return(0); }
+                break;
+
+            case FLTRULE_OP_AND:
+            case FLTRULE_OP_OR:
+            case FLTRULE_OP_XOR:
+                if(depth < 2) { return(0); }
+                depth--;
+                break;
+
+            case FLTRULE_OP_ATLEAST:
+                if(((operand & 0x000F) == 0) || (depth < (int16_t)(operand & 0x000F))) { return(0); }
+                depth -= ((operand & 0x000F) - 1);
+                break;
+
+            case FLTRULE_OP_ON_DELAY:
+            case FLTRULE_OP_OFF_DELAY:
+                if((depth < 1) || (operand >= FLTRULE_TIMER_COUNT) || (pc >= rule->length)) { return(0); }
+                if(rule->program[pc++] == 0) { return(0); } // timer preset of zero cycles is invalid
+                break;
+
+            default:
+                return(0);
+        }
+
+        if(depth > FLTRULE_STACK_DEPTH) { return(0); }
+    }
+
+    // a valid rule leaves exactly one result on the stack
+    return((uint16_t)(depth == 1));
+}
+
+/*!os_FaultRules_Initialize
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Validates all rules listed in user_fault_rule_list[] and resets their timers and results.
+ * Rules failing validation are disabled and flagged by the status error bit.
+ * This function must be called after all fault objects have been initialized.
+ * ***********************************************************************************************/
+volatile uint16_t os_FaultRules_Initialize(void)
+{
+    volatile uint16_t fres=1, i=0, j=0;
+
+    for(i=0; i<user_fltrule_list_size; i++)
+    {
+        if(user_fault_rule_list[i] != NULL)
+        {
+            for(j=0; j<FLTRULE_TIMER_COUNT; j++)
+            { user_fault_rule_list[i]->timer[j] = 0; }
+
+            user_fault_rule_list[i]->status.bits.result = false;
+
+            if(ValidateFaultRule(user_fault_rule_list[i]))
+            {
+                user_fault_rule_list[i]->status.bits.error = false;
+            }
+            else
+            {
+                user_fault_rule_list[i]->status.bits.error = true;
+                user_fault_rule_list[i]->status.bits.enabled = false;
+                fres = 0;
+            }
+        }
+    }
+
+    return(fres);
+}
+
+/*!ExecFaultRule
+ * ***********************************************************************************************
+ * Parameters:
+ *      FAULT_RULE_t* rule: Pointer to a validated fault rule object
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: rule result is false
+ *      1: rule result is true
+ *
+ * Description:
+ * Executes the bytecode program of the given rule. Boolean operands are kept in a single 16-bit
+ * word used as bit-stack (top of stack = bit #0). Every instruction executes in constant time,
+ * except for FLTRULE_OP_ATLEAST, which is bounded by the number of operands (max. 15).
+ * ***********************************************************************************************/
+volatile uint16_t ExecFaultRule(volatile FAULT_RULE_t* rule)
+{
+    uint16_t stack=0, pc=0, instr=0, operand=0, cnt=0, i=0, preset=0;
+    const uint16_t* code = rule->program;
+    volatile uint16_t* timer;
+
+    while(pc < rule->length)
+    {
+        instr = code[pc++];
+        operand = (instr & 0x00FF);
+
+        switch(instr >> 8)
+        {
+            case FLTRULE_OP_ACTIVE:
+                stack = ((stack << 1) | (uint16_t)GetFaultRuleObject(operand)->status.bits.fault_active);
+                break;
+
+            case FLTRULE_OP_STATUS:
+                stack = ((stack << 1) | (uint16_t)GetFaultRuleObject(operand)->status.bits.fault_status);
+                break;
+
+            case FLTRULE_OP_OPMODE:
+                stack = ((stack << 1) | (uint16_t)(bool)(task_mgr.op_mode.value & operand));
+                break;
+
+            case FLTRULE_OP_CONST:
+                stack = ((stack << 1) | (operand & 0x0001));
+                break;
+
+            case FLTRULE_OP_NOT:
+                stack ^= 0x0001;
+                break;
+
+            case FLTRULE_OP_AND:
+                stack = ((stack >> 1) & (stack | 0xFFFE));
+                break;
+
+            case FLTRULE_OP_OR:
+                stack = ((stack >> 1) | (stack & 0x0001));
+                break;
+
+            case FLTRULE_OP_XOR:
+                stack = ((stack >> 1) ^ (stack & 0x0001));
+                break;
+
+            case FLTRULE_OP_ATLEAST:
+                cnt = 0;
+                for(i=0; i<(operand & 0x000F); i++)
+                { cnt += (stack & 0x0001); stack >>= 1; }
+                stack = ((stack << 1) | (uint16_t)(cnt >= (operand >> 4)));
+                break;
+
+            case FLTRULE_OP_ON_DELAY:
+                preset = code[pc++];
+                timer = &rule->timer[operand];
+                if(stack & 0x0001)
+                { if(*timer < preset) { (*timer)++; } }
+                else
+                { *timer = 0; }
+                stack = ((stack & 0xFFFE) | (uint16_t)(*timer >= preset));
+                break;
+
+            case FLTRULE_OP_OFF_DELAY:
+                preset = code[pc++];
+                timer = &rule->timer[operand];
+                if(stack & 0x0001)
+                { *timer = preset; }
+                else if(*timer > 0)
+                { (*timer)--; }
+                stack = ((stack & 0xFFFE) | (uint16_t)(*timer > 0));
+                break;
+
+            default: // FLTRULE_OP_END
+                pc = rule->length;
+                break;
+        }
+    }
+
+    return(stack & 0x0001);
+}
+
+/*!exec_FaultRulesAll
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * This routine evaluates all enabled rules listed in user_fault_rule_list[] and updates their
+ * result bits. It is called by exec_FaultCheckAll() before fault objects are checked, so fault
+ * objects monitoring rule results respond within the same fault check cycle.
+ * ***********************************************************************************************/
+volatile uint16_t exec_FaultRulesAll(void)
+{
+    volatile uint16_t i=0;
+
+    for(i=0; i<user_fltrule_list_size; i++)
+    {
+        if(user_fault_rule_list[i] != NULL) {
+        if(user_fault_rule_list[i]->status.bits.enabled)
+        {
+            user_fault_rule_list[i]->status.bits.result = (bool)ExecFaultRule(user_fault_rule_list[i]);
+        }}
+    }
+
+    return(1);
+}
+
+// EOF
@@ -56,12 +56,100 @@
 #include <xc.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "_root/generic/os_Globals.h"
 #include "_root/generic/fdrv_TrapHandler.h"
 #include "_root/generic/fdrv_FaultHandler.h"
 
 // data structure used as buffer for trap monitoring
 volatile __attribute__((__persistent__)) TRAP_LOGGER_t traplog; 
 
+#if (USE_TRAP_CRASH_RECORD == 1)
+
+// data structure holding the crash record of the most recent trap
+volatile __attribute__((__persistent__)) TRAP_CRASH_RECORD_t crashlog;
+
+// start address of the software stack (defined by the linker)
+extern uint16_t _SP_init;
+
+/*!TRAP_CRASH_CAPTURE
+ * *************************************************************************************************
+ * Summary:
+ * Assembly code saving the CPU state into the crash record at trap entry
+ * 
+ * Description:
+ * This code is emitted as pre-prologue of every trap service routine and is therefore executed 
+ * before the compiler-generated prologue modifies any working register. At this point W15 points 
+ * right above the exception frame pushed by the CPU, holding PC<15:0> at [W15-4] and 
+ * SRL<7:0>, IPL3, PC<22:16> at [W15-2]. W0 is restored before the prologue is executed.
+ * 
+ * The data field offsets used here have to match the declaration of TRAP_CRASH_RECORD_t.
+ * 
+ * ************************************************************************************************/
+#define TRAP_CRASH_CAPTURE \
+    "mov w0, _crashlog\n mov w1, _crashlog+2\n mov w2, _crashlog+4\n mov w3, _crashlog+6\n" \
+    "mov w4, _crashlog+8\n mov w5, _crashlog+10\n mov w6, _crashlog+12\n mov w7, _crashlog+14\n" \
+    "mov w8, _crashlog+16\n mov w9, _crashlog+18\n mov w10, _crashlog+20\n mov w11, _crashlog+22\n" \
+    "mov w12, _crashlog+24\n mov w13, _crashlog+26\n mov w14, _crashlog+28\n mov w15, _crashlog+30\n" \
+    "mov _SR, w0\n mov w0, _crashlog+32\n" \
+    "mov _CORCON, w0\n mov w0, _crashlog+34\n" \
+    "mov [w15-4], w0\n mov w0, _crashlog+36\n" \
+    "mov [w15-2], w0\n mov w0, _crashlog+38\n" \
+    "mov _crashlog, w0\n"
+
+// trap service routine attributes incl. crash record capture
+#define TRAP_ISR __attribute__((__interrupt__(__preprologue__(TRAP_CRASH_CAPTURE)), no_auto_psv))
+
+/*!CaptureTrapCrashRecord
+ * *************************************************************************************************
+ * Summary:
+ * Completes the crash record of the recent trap
+ * 
+ * Description:
+ * Working registers, status registers and the exception frame have already been saved by 
+ * TRAP_CRASH_CAPTURE. This routine adds trap ID, task ID and operating mode, copies the topmost 
+ * stack words below the exception frame and seals the record with signature and checksum. Stack 
+ * words are only read within the valid stack range to prevent nested address errors when the 
+ * stack pointer itself has been corrupted.
+ * 
+ * ************************************************************************************************/
+void CaptureTrapCrashRecord(TRAP_ID_e trap_id) {
+
+    volatile uint16_t i=0, sp=0, sum=0;
+    volatile uint16_t* ptr;
+    
+    crashlog.signature = TRAP_CRASH_RECORD_SIGNATURE;
+    crashlog.trap_id = (uint16_t)trap_id;
+    crashlog.task_id = task_mgr.task_queue.active_task_id;
+    crashlog.op_mode = task_mgr.op_mode.value;
+    
+    // Copy stack words below the exception frame (most recent first)
+    sp = (crashlog.w_reg[15] - 4);
+    for(i=0; i<TRAP_CRASH_STACK_DEPTH; i++) {
+        sp -= 2;
+        if((sp & 0x0001) || (sp < (uint16_t)&_SP_init) || (sp > SPLIM)) break;
+        crashlog.stack[i] = *(volatile uint16_t*)sp;
+    }
+    crashlog.stack_count = i;
+    for(; i<TRAP_CRASH_STACK_DEPTH; i++) 
+    { crashlog.stack[i] = 0; }
+    
+    // Seal crash record
+    ptr = (volatile uint16_t*)&crashlog;
+    for(i=0; i<((sizeof(TRAP_CRASH_RECORD_t)/sizeof(uint16_t))-1); i++)
+    { sum += ptr[i]; }
+    crashlog.checksum = ~sum;
+    traplog.status.bits.crash_record_new = true; // Crash record needs to be evaluated after CPU reset
+    
+    return;
+}
+
+#else
+
+// trap service routine attributes
+#define TRAP_ISR __attribute__((interrupt, no_auto_psv))
+
+#endif
+
 
 /*!init_SoftTraps
  * *************************************************************************************************
@@ -104,6 +192,11 @@ void DefaultTrapHandler(TRAP_ID_e trap_id) {
     traplog.trap_id = trap_id; // Capture Trap ID
     traplog.trap_count++; // Capture occurrence 
 
+    // Complete crash record captured at trap entry
+    #if (USE_TRAP_CRASH_RECORD == 1)
+    CaptureTrapCrashRecord(trap_id);
+    #endif
+
     // Capture recent status of interrupt, reset control and trap flag bits
     CaptureCPUInterruptStatus();
  
@@ -134,11 +227,11 @@ void DefaultTrapHandler(TRAP_ID_e trap_id) {
 //
 // =================================================================================================
 
-void __attribute__((interrupt, no_auto_psv)) _ReservedTrap5(void) {
+void TRAP_ISR _ReservedTrap5(void) {
     DefaultTrapHandler(TRAP_RESERVED_TRAP_5_ERROR); // Call default trap handler
 }
 
-void __attribute__((interrupt, no_auto_psv)) _ReservedTrap7(void) {
+void TRAP_ISR _ReservedTrap7(void) {
     DefaultTrapHandler(TRAP_RESERVED_TRAP_7_ERROR); // Call default trap handler
 }
 
@@ -146,7 +239,7 @@ void __attribute__((interrupt, no_auto_psv)) _ReservedTrap7(void) {
 // Hard Trap Error is captured
 // =================================================================================================
 
-void __attribute__((interrupt, no_auto_psv)) _HardTrapError(void) {
+void TRAP_ISR _HardTrapError(void) {
     DefaultTrapHandler(TRAP_HARD_TRAP_ERROR); // Call default trap handler
 }
 
@@ -154,7 +247,7 @@ void __attribute__((interrupt, no_auto_psv)) _HardTrapError(void) {
 // Soft Trap Error is captured
 // =================================================================================================
 
-void __attribute__((interrupt, no_auto_psv)) _SoftTrapError(void) {
+void TRAP_ISR _SoftTrapError(void) {
     DefaultTrapHandler(TRAP_SOFT_TRAP_ERROR);
 }
 
@@ -162,7 +255,7 @@ void __attribute__((interrupt, no_auto_psv)) _SoftTrapError(void) {
 // Oscillator Failure Trap is captured, when the system clock becomes unstable
 // =================================================================================================
 
-void __attribute__((interrupt, no_auto_psv)) _OscillatorFail(void) {
+void TRAP_ISR _OscillatorFail(void) {
     DefaultTrapHandler(TRAP_OSCILLATOR_FAIL);
 }
 
@@ -171,21 +264,21 @@ void __attribute__((interrupt, no_auto_psv)) _OscillatorFail(void) {
 // in RAM or Flash via PSV.
 // =================================================================================================
 
-void __attribute__((interrupt, no_auto_psv)) _AddressError(void) {
+void TRAP_ISR _AddressError(void) {
     DefaultTrapHandler(TRAP_ADDRESS_ERROR);
 }
 // =================================================================================================
 // Stack Error Trap is captured, when a stack address error occurred
 // =================================================================================================
 
-void __attribute__((interrupt, no_auto_psv)) _StackError(void) {
+void TRAP_ISR _StackError(void) {
     DefaultTrapHandler(TRAP_STACK_ERROR);
 }
 // =================================================================================================
 // Math Error Trap is captured, when a math operation cannot be solved (e.g. division by zero)
 // =================================================================================================
 
-void __attribute__((interrupt, no_auto_psv)) _MathError(void) {
+void TRAP_ISR _MathError(void) {
     DefaultTrapHandler(TRAP_MATH_ERROR);
 }
 
@@ -195,7 +288,7 @@ void __attribute__((interrupt, no_auto_psv)) _MathError(void) {
 // DMA Error Trap is captured, when an access error of the dual ported RAM occurred
 // =================================================================================================
 
-void __attribute__((interrupt, no_auto_psv)) _DMACError(void) {
+void TRAP_ISR _DMACError(void) {
     DefaultTrapHandler(TRAP_DMA_ERROR);
 }
 #endif
@@ -215,33 +308,33 @@ void __attribute__((interrupt, no_auto_psv)) _DMACError(void) {
 // =================================================================================================
 #if (__XC16_VERSION < 1030)
 
-void __attribute__((interrupt, no_auto_psv)) _AltHardTrapError(void) {
+void TRAP_ISR _AltHardTrapError(void) {
     DefaultTrapHandler(TRAP_ALT_HARD_TRAP_ERROR); // Call default trap handler
 }
 
-void __attribute__((interrupt, no_auto_psv)) _AltSoftTrapError(void) {
+void TRAP_ISR _AltSoftTrapError(void) {
     DefaultTrapHandler(TRAP_ALT_SOFT_TRAP_ERROR);
 }
 
-void __attribute__((interrupt, no_auto_psv)) _AltOscillatorFail(void) {
+void TRAP_ISR _AltOscillatorFail(void) {
     DefaultTrapHandler(TRAP_ALT_OSCILLATOR_FAIL);
 }
 
-void __attribute__((interrupt, no_auto_psv)) _AltAddressError(void) {
+void TRAP_ISR _AltAddressError(void) {
     DefaultTrapHandler(TRAP_ALT_ADDRESS_ERROR);
 }
 
-void __attribute__((interrupt, no_auto_psv)) _AltStackError(void) {
+void TRAP_ISR _AltStackError(void) {
     DefaultTrapHandler(TRAP_ALT_STACK_ERROR);
 }
 
-void __attribute__((interrupt, no_auto_psv)) _AltMathError(void) {
+void TRAP_ISR _AltMathError(void) {
     DefaultTrapHandler(TRAP_ALT_MATH_ERROR);
 }
 
 #if (TRAP_DMA_SUPPORT == 1)
 
-void __attribute__((interrupt, no_auto_psv)) _AltDMACError(void) {
+void TRAP_ISR _AltDMACError(void) {
     DefaultTrapHandler(TRAP_ALT_DMA_ERROR);
 }
 #endif
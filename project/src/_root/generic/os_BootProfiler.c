@@ -0,0 +1,250 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ * ***************************************************************************/
+/*!os_BootProfiler.c
+ * ****************************************************************************
+ * File:   os_BootProfiler.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file provides the startup-time profiler of the operating system.
+ * The end of every startup phase from the entry of OS_Execute() to the first
+ * tick of the RUN task queue is time-stamped and the phase durations are 
+ * stored in the persistent boot report (boot_report), which can be decoded 
+ * using tools/boot_report_decoder.py.
+ *
+ * Phases before the scheduler starts are measured by the Dead Man Timer (DMT)
+ * counter, which is enabled right at the entry of OS_Execute() and counts CPU
+ * instruction cycles. Once the scheduler is running, the DMT counter is 
+ * cleared periodically and the time base is handed over to the task manager
+ * timer. The time spent in the C runtime startup code before OS_Execute() is
+ * not covered.
+ *
+ ******************************************************************************/
+
+#include "xc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#include "_root/generic/os_Globals.h"
+#include "_root/generic/os_BootProfiler.h"
+
+// data structure holding the phase durations of the most recent boot
+volatile __attribute__((__persistent__)) BOOT_REPORT_t boot_report;
+
+// time stamps and oscillator source captured at the start of the recent phase
+volatile uint32_t boot_profiler_dmt_start = 0;
+volatile uint32_t boot_profiler_os_start = 0;
+volatile uint16_t boot_profiler_clock = 0;
+
+/* private function prototypes */
+inline volatile uint32_t GetBootProfilerCycleCount(void);
+
+/*!GetBootProfilerCycleCount
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint32_t
+ *      Number of CPU instruction cycles counted by the Dead Man Timer
+ *
+ * Description:
+ * Reads the 32-bit DMT counter. The high word is read twice to detect a carry from the low
+ * word in between both read operations.
+ * ***********************************************************************************************/
+inline volatile uint32_t GetBootProfilerCycleCount(void)
+{
+    volatile uint16_t cnt_h=0, cnt_l=0;
+
+    do {
+        cnt_h = DMTCNTH;
+        cnt_l = DMTCNTL;
+    } while (cnt_h != DMTCNTH);
+
+    return(((uint32_t)cnt_h << 16) | (uint32_t)cnt_l);
+}
+
+/*!ClearBootReport
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Clears all phase records and the boot counter of the persistent boot report and sets the
+ * report signature.
+ * ***********************************************************************************************/
+volatile uint16_t ClearBootReport(void)
+{
+    volatile uint16_t i=0;
+
+    for(i=0; i<BOOT_PHASE_COUNT; i++)
+    {
+        boot_report.phase[i].cycles = 0;
+        boot_report.phase[i].duration = 0;
+        boot_report.phase[i].clock = 0;
+    }
+
+    boot_report.boot_count = 0;
+    boot_report.phase_index = BOOT_PHASE_COUNT;
+    boot_report.aborted_phase = BOOT_PHASE_NONE;
+    boot_report.restart_profile = 0;
+    boot_report.total_duration = 0;
+    boot_report.signature = BOOT_REPORT_SIGNATURE;
+    boot_report.signature_inv = (uint16_t)(~BOOT_REPORT_SIGNATURE);
+
+    return(1);
+}
+
+/*!os_BootProfiler_Initialize
+ * ***********************************************************************************************
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Starts the startup-time profiler. This function is called by OS_Execute() before any other
+ * function. The DMT is enabled to serve as instruction cycle counter. After power-up or if the
+ * report has been corrupted, the boot report is cleared. Otherwise the phase in which the 
+ * previous boot has been interrupted is captured, the boot counter is incremented and all 
+ * phase records are reset.
+ * 
+ * Please note:
+ * Once enabled, the DMT cannot be disabled by software. It is cleared by the scheduler main
+ * loop and the DMT count limit needs to cover the entire startup until the scheduler starts.
+ * ***********************************************************************************************/
+volatile uint16_t os_BootProfiler_Initialize(void)
+{
+    volatile uint16_t fres=1, i=0;
+
+    DMTCONbits.ON = 1;  // Enable Dead Man Timer as instruction cycle counter
+    boot_profiler_dmt_start = GetBootProfilerCycleCount();
+    boot_profiler_clock = OSCCONbits.COSC;
+
+    if ((boot_report.signature != BOOT_REPORT_SIGNATURE) ||
+        (boot_report.signature_inv != (uint16_t)(~BOOT_REPORT_SIGNATURE)))
+    {
+        fres &= ClearBootReport();
+    }
+
+    // capture the phase in which the previous boot has been interrupted
+    if (boot_report.phase_index < BOOT_PHASE_COUNT)
+    { boot_report.aborted_phase = boot_report.phase_index; }
+    else
+    { boot_report.aborted_phase = BOOT_PHASE_NONE; }
+
+    if(boot_report.boot_count < 0xFFFF)
+    { boot_report.boot_count++; }
+
+    for(i=0; i<BOOT_PHASE_COUNT; i++)
+    {
+        boot_report.phase[i].cycles = 0;
+        boot_report.phase[i].duration = 0;
+        boot_report.phase[i].clock = 0;
+    }
+
+    boot_report.phase_index = 0;
+    boot_report.total_duration = 0;
+
+    return(fres);
+}
+
+/*!CaptureBootPhase
+ * ***********************************************************************************************
+ * Parameters:
+ *      BOOT_PHASE_e phase: Startup phase which has just been completed
+ *
+ * Return:
+ *      type: uint16_t
+ *      0: Failure
+ *      1: Success
+ *
+ * Description:
+ * Captures the duration of the given startup phase since the end of the previous phase. Phases 
+ * up to BOOT_PHASE_OS_INIT are measured by the DMT counter, all subsequent phases by the task 
+ * manager timer. The instruction cycles are converted into microseconds using the instruction 
+ * frequency of the oscillator the phase has been started on.
+ * 
+ * Phases which have been skipped are recorded with zero duration. Phases which have already been 
+ * captured (e.g. when the startup sequence is repeated after a warm restart) are ignored.
+ * ***********************************************************************************************/
+volatile uint16_t CaptureBootPhase(volatile BOOT_PHASE_e phase)
+{
+    volatile uint16_t i=0;
+    volatile uint32_t now=0, cycles=0, fcy=0;
+    volatile BOOT_PHASE_RECORD_t* rec;
+
+    if (phase >= BOOT_PHASE_COUNT) return(0);
+    if (phase < boot_report.phase_index) return(1); // phase has already been captured
+
+    // measure phase duration in instruction cycles
+    if (phase < BOOT_PHASE_BOOT_QUEUE)
+    {
+        now = GetBootProfilerCycleCount();
+        cycles = (now - boot_profiler_dmt_start);
+        boot_profiler_dmt_start = now;
+    }
+    else
+    {
+        now = os_GetSystemTimestamp();
+        cycles = (now - boot_profiler_os_start);
+        boot_profiler_os_start = now;
+    }
+
+    // record skipped phases with zero duration
+    for (i=boot_report.phase_index; i<(uint16_t)phase; i++)
+    { boot_report.phase[i].clock = boot_profiler_clock; }
+
+    // convert instruction cycles into microseconds
+    if ((boot_profiler_clock == OSCCON_xOSC_FRC) || (boot_profiler_clock == OSCCON_xOSC_BFRC))
+    { fcy = BOOT_PROFILER_FRC_FCY; }
+    else
+    { fcy = CLOCK_FCY; }
+    
+    rec = &boot_report.phase[phase];
+    rec->cycles = cycles;
+    rec->clock = boot_profiler_clock;
+    rec->duration = ((fcy >= 1000000UL) ? (cycles / (fcy / 1000000UL)) : 0);
+    boot_report.total_duration += rec->duration;
+
+    // hand over time base to the task manager timer when the scheduler is about to start
+    if (phase == BOOT_PHASE_OS_INIT)
+    { boot_profiler_os_start = os_GetSystemTimestamp(); }
+
+    if (phase == BOOT_PHASE_RESET_CAUSE)
+    { boot_report.restart_profile = traplog.restart_profile; }
+
+    boot_profiler_clock = OSCCONbits.COSC;
+    boot_report.phase_index = ((uint16_t)phase + 1);
+
+    return(1);
+}
+
+// EOF
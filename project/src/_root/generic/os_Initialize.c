@@ -78,8 +78,15 @@ volatile uint16_t CLOCK_Initialize(void){
     // Initialize main oscillator and auxiliary clock
     //Remove: fres = init_SoftwareWatchDogTimer();
     fres &= MainOscillator_Initialize(); // Initialize main oscillator
+    #if (USE_BOOT_PROFILER == 1)
+    fres &= CaptureBootPhase(BOOT_PHASE_CLOCK_SWITCH); // Capture main oscillator switch-over time incl. PLL lock
+    #endif
+    #if (USE_NONBLOCKING_PERIPHERAL_INIT == 1)
+    fres &= AuxOscillator_InitStart(); // Enable auxiliary clock for PWM and ADC, PLL lock is monitored by exec_InitSequences()
+    #else
     fres &= AuxOscillator_Initialize(); // Initialize auxiliary clock for PWM and ADC
-    fres &= smpsOSC_GetFrequencies(0);     // Update clock settings of global system_frequencies object
+    #endif
+    fres &= SystemFrequencies_Initialize(); // Update clock settings of global system_frequencies object
    
     // Setup and start Timer1 as base clock for the task scheduler
     fres &= OSTimer_Initialize(); // Initialize timer @ configured task tick frequency
@@ -125,6 +132,9 @@ volatile uint16_t DEVICE_Initialize(void) {
     fres &= DSP_initialize();   // Initializes the DSP with settings defined in mcal/config/devcfg_dsp.h
     fres &= IRQ_initialize();   // Initializes the Interrupt Controller with settings defined in mcal/config/devcfg_irq.h
     fres &= GPIO_initialize();  // Initializes the device GPIOs with settings defined in mcal/config/devcfg_gpio.h
+    #if (USE_REGISTER_IMAGES == 1)
+    fres &= RegisterImage_ApplyAll(); // Applies peripheral register images defined in apl/config/UserRegisterImages.txt
+    #endif
     
     return(fres);
     
@@ -171,3 +181,199 @@ volatile uint16_t DEVICE_Reset(void){
     
 }
 #endif
+
+#if (USE_WARM_RESTART == 1)
+
+// Reference values validating warm restarts
+volatile OS_WARM_RESTART_t os_warm_restart;
+
+/*!OS_GetConfigChecksum()
+ * ************************************************************************************************
+ * Summary:
+ * Calculates the checksum of the recent clock and OS timer configuration
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * 16-bit checksum
+ * 
+ * Description:
+ * The checksum covers the current and new oscillator selection, main and auxiliary PLL settings,
+ * clock divider and the OS timer period. Status bits changing during operation (e.g. lock and 
+ * fail flags) are excluded.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t OS_GetConfigChecksum(void) {
+
+    volatile uint16_t i=0, crc=0;
+    volatile uint16_t config[7];
+    
+    config[0] = (OSCCON & 0x7700);  // COSC<2:0> and NOSC<2:0> only
+    config[1] = CLKDIV;
+    config[2] = PLLFBD;
+    config[3] = PLLDIV;
+    config[4] = (ACLKCON1 & 0x870F); // APLLEN, FRCSEL and APLLPRE<3:0> only
+    config[5] = APLLFBD1;
+    config[6] = APLLDIV1;
+    
+    for (i=0; i<(sizeof(config)/sizeof(config[0])); i++)
+    { crc = ((crc << 1) | (crc >> 15)) ^ config[i]; } // Rotate and XOR
+    
+    crc = ((crc << 1) | (crc >> 15)) ^ TASK_MGR_TIMER_PERIOD_REGISTER;
+    
+    return(crc);
+}
+
+/*!OS_CaptureWarmRestartConfig()
+ * ************************************************************************************************
+ * Summary:
+ * Captures the reference values validating warm restarts
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * 0 = FALSE
+ * 1 = TRUE
+ * 
+ * Description:
+ * This routine is called once by OS_Execute() after the clock and OS have been initialized 
+ * during the cold start. 
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t OS_CaptureWarmRestartConfig(void) {
+
+    os_warm_restart.config_checksum = OS_GetConfigChecksum();
+    os_warm_restart.trap_count = traplog.trap_count;
+    os_warm_restart.warm_restarts = 0;
+    os_warm_restart.adc_core_enable = 0;
+    
+    return(1);
+}
+
+/*!OS_WarmRestartSafeState()
+ * ************************************************************************************************
+ * Summary:
+ * Puts power stage and ADC into a safe state before a warm restart
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * 0 = FALSE
+ * 1 = TRUE
+ * 
+ * Description:
+ * This routine is called by OS_WarmRestart() before the restart is validated. The outputs of all
+ * PWM generators are overridden, so the power stage remains switched off whether the warm 
+ * restart is granted or the CPU gets reset. All enabled ADC cores are disabled, so no conversion
+ * triggers control loop interrupts based on stale data while the task manager and the fault 
+ * objects are re-initialized. The ADC module and the cores remain powered. The disabled core 
+ * enable bits are stored in os_warm_restart.adc_core_enable and are set again by 
+ * OS_WarmRestart() once the re-initialization has been successful.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t OS_WarmRestartSafeState(void) {
+
+    volatile uint16_t fres = 1, i = 0;
+    
+    // Override outputs of all PWM generators
+    for (i=0; i<HSPWM_PG_COUNT; i++)
+    { fres &= smpsHSPWM_OVR_Hold(i+1); }
+    
+    // Disable all ADC cores (shared core enable bit SHREN and dedicated core enable bits CxEN)
+    os_warm_restart.adc_core_enable = (ADCON3H & (uint16_t)ADCORE_REGISTER_BIT_MSK);
+    ADCON3H &= ~os_warm_restart.adc_core_enable;
+    
+    return(fres);
+}
+
+/*!OS_WarmRestart()
+ * ************************************************************************************************
+ * Summary:
+ * Restarts the scheduler without CPU reset, if clock and peripheral configurations are valid
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * false = warm restart denied, CPU needs to be reset
+ * true  = scheduler has been restarted 
+ * 
+ * Description:
+ * This routine is called by OS_Execute() when the main scheduler has been terminated by clearing
+ * the flag run_scheduler. Power stage and ADC are put into a safe state first (see 
+ * OS_WarmRestartSafeState()). 
+ * 
+ * A warm restart is denied, if any CPU trap has occurred since the cold start, the oscillator or 
+ * PLLs have lost lock, the clock and OS timer configuration checksum has changed, the system runs 
+ * in degraded mode or the CPU reset rate limit would be reached. The CPU reset trigger latched by
+ * the trap handler is evaluated before the recent interrupt and reset status is captured, which
+ * would otherwise overwrite the trap flags of the trap log. When USE_REGISTER_IMAGES is enabled, 
+ * peripheral register images are verified and re-applied, if needed. The warm restart is denied, 
+ * if an image cannot be restored. 
+ * 
+ * Otherwise the task manager and all fault objects are re-initialized, the ADC cores are enabled
+ * again and the scheduler resumes operation with the STARTUP_SEQUENCE queue, skipping device 
+ * reset, clock initialization and the BOOT and FIRMWARE_INIT queues. PWM outputs remain 
+ * overridden until they are released by the startup sequence of the application. The system 
+ * tick counter keeps counting across the restart.
+ * 
+ * ***********************************************************************************************/
+volatile bool OS_WarmRestart(void) {
+
+    volatile uint16_t fres = 1;
+    volatile uint32_t tick_counter = 0;
+    
+    // Shut down power stage and stop ADC conversions before anything gets re-initialized
+    OS_WarmRestartSafeState();
+    
+    // Validate persistent trap log state latched by the trap handler
+    if (traplog.status.bits.cpu_reset_trigger) return(false);
+    if (traplog.trap_count != os_warm_restart.trap_count) return(false);
+    
+    // Capture all relevant interrupt and reset status bits and check for new trap flags
+    CaptureCPUInterruptStatus(); 
+    if (traplog.status.bits.cpu_reset_trigger) return(false);
+
+    // Validate restart profile and restart limit
+    if (task_mgr.status.bits.degraded_mode) return(false);
+    if ((traplog.reset_rate + 256) >= (TASK_MGR_CPU_RESET_LIMIT << 8)) return(false);
+    
+    // Validate clock configuration
+    if (OSCCONbits.COSC != OSCCONbits.NOSC) return(false);
+    if (((OSCCONbits.COSC == OSCCON_xOSC_FRCPLL) || (OSCCONbits.COSC == OSCCON_xOSC_PRIPLL)) && 
+        (OSCCONbits.LOCK == OSCCON_LOCK_PLL_UNLOCKED)) return(false);
+    if ((ACLKCON1bits.APLLEN) && (!ACLKCON1bits.APLLCK)) return(false);
+    if (OS_GetConfigChecksum() != os_warm_restart.config_checksum) return(false);
+    
+    // Validate peripheral configurations, restoring register images which have been changed
+    #if (USE_REGISTER_IMAGES == 1)
+    if (!RegisterImage_RestoreAll()) return(false);
+    #endif
+    
+    // Re-initialize task manager and fault objects, maintaining the system time base
+    tick_counter = task_mgr.os_timer.tick_counter;
+    fres &= OS_Initialize();
+    task_mgr.os_timer.tick_counter = tick_counter;
+    
+    // Enable ADC cores disabled by the safe state (cores have remained powered and ready)
+    ADCON3H |= os_warm_restart.adc_core_enable;
+    
+    // Resume with startup sequence
+    task_mgr.pre_op_mode.value = OP_MODE_FIRMWARE_INIT;
+    task_mgr.op_mode.value = OP_MODE_STARTUP_SEQUENCE;
+    fres &= os_CheckOperationModeStatus();
+    
+    if (!fres) return(false);
+    
+    traplog.reset_count++; // Warm restarts count against the CPU reset rate limit
+    traplog.reset_rate += 256;
+    os_warm_restart.warm_restarts++;
+    run_scheduler = true;
+    
+    return(true);
+}
+
+#endif
@@ -50,8 +50,16 @@ void __attribute__((user_init)) OS_Execute(void) {
     #endif
     
 
+    // Start startup-time profiler before executing any other code
+    #if (USE_BOOT_PROFILER == 1)
+    fres &= os_BootProfiler_Initialize();
+    #endif
+
     // Right after system reset, first check for root-cause of previous device reset
     fres &= CheckCPUResetRootCause();
+    #if (USE_BOOT_PROFILER == 1)
+    fres &= CaptureBootPhase(BOOT_PHASE_RESET_CAUSE);
+    #endif
 
     // Initialize essential chip features and peripheral modules to boot up system
     #if ((EXECUTE_MCC_SYSTEM_INITIALIZE == 0) && (EXECUTE_DEVICE_RESET == 1))
@@ -62,21 +70,43 @@ void __attribute__((user_init)) OS_Execute(void) {
     #if (EXECUTE_USER_STARTUP_CODE == 1)
     fres &= ExecuteUserStartupCode();
     #endif
+    #if (USE_BOOT_PROFILER == 1)
+    fres &= CaptureBootPhase(BOOT_PHASE_DEVICE_RESET);
+    #endif
     
     // Initialize CPU Clock, CPU/DSP, Interrupt Controller and User-Defined GPIO settings
     #if (EXECUTE_MCC_SYSTEM_INITIALIZE == 0)
     fres &= CLOCK_Initialize();
+    #if (USE_BOOT_PROFILER == 1)
+    fres &= CaptureBootPhase(BOOT_PHASE_CLOCK_AUX);
+    #endif
     fres &= DEVICE_Initialize();
+    #if (USE_BOOT_PROFILER == 1)
+    fres &= CaptureBootPhase(BOOT_PHASE_DEVICE_INIT);
+    #endif
     #endif
     
     // Initialize task manager and OS and user defined fault objects
     fres &= OS_Initialize();
+    #if (USE_BOOT_PROFILER == 1)
+    fres &= CaptureBootPhase(BOOT_PHASE_OS_INIT);
+    #endif
+
+    // Capture clock configuration and trap log state validating warm restarts
+    #if (USE_WARM_RESTART == 1)
+    fres &= OS_CaptureWarmRestartConfig();
+    #endif
 
     DMTCONbits.ON = 1;  // Enable Dead Man Timer
     
     // after the basic steps, the rest of the configuration runs as part of the scheduler,
     // where execution can be monitored and faults can be properly handled.
+    // When the scheduler is terminated, a warm restart without CPU reset is attempted first.
+    #if (USE_WARM_RESTART == 1)
+    while (run_scheduler || OS_WarmRestart()) 
+    #else
     while (run_scheduler) 
+    #endif
     {
       
         // Clear Dead Man Timer counter
@@ -109,6 +139,7 @@ TS_CLOCKOUT_PIN_WR = PINSTATE_HIGH; // Drive debug pin high
 
 
         TASK_MGR_TMR_IF = 0; // Reset timer ISR flag bit
+        task_mgr.os_timer.tick_counter++; // Increment system time stamp counter
 
         
 #if ((USE_TASK_EXECUTION_CLOCKOUT_PIN == 1) && (USE_DETAILED_CLOCKOUT_PATTERN == 1))
@@ -117,6 +148,12 @@ TS_CLOCKOUT_PIN_WR = PINSTATE_LOW;                  // Drive debug pin low
 #endif
 #endif
         
+        // Capture end of startup with the first tick of the RUN task queue
+        #if (USE_BOOT_PROFILER == 1)
+        if ((task_mgr.op_mode.value == OP_MODE_RUN) && (boot_report.phase_index < BOOT_PHASE_COUNT))
+        { fres &= CaptureBootPhase(BOOT_PHASE_FIRST_RUN); }
+        #endif
+
         // Call most recent task with execution time measurement
         fres &= os_ProcessTaskQueue();     // Step through pre-defined task lists
 
@@ -143,6 +180,9 @@ TS_CLOCKOUT_PIN_WR = PINSTATE_LOW;                 // Drive debug pin high
         // call the fault handler to check all defined fault objects
         fres &= exec_FaultCheckAll();
         
+        // Decay the CPU reset rate counter during uninterrupted operation
+        fres &= ExecCPUResetRateDecay();
+        
 #if ((USE_TASK_EXECUTION_CLOCKOUT_PIN == 1) && (USE_DETAILED_CLOCKOUT_PATTERN == 1))
 #ifdef TS_CLOCKOUT_PIN_WR
 TS_CLOCKOUT_PIN_WR = PINSTATE_HIGH;                 // Drive debug pin low
@@ -211,23 +251,11 @@ else
     
     CaptureCPUInterruptStatus(); // Capture all relevant interrupt and reset status bits
     traplog.status.bits.sw_reset = true; // Set flag bit indicating CPU was restarted by software
-    traplog.reset_count++;  // Increment the persistent soft-reset counter to stop restarting after certain number of restart attempts
 
-    // To prevent that the CPU ends up restarting endlessly, the traplog object 
-    // tracks the number or CPU resets and stalls here after a user defined number
-    // of attempts defined by TASK_MGR_CPU_RESET_LIMIT
-    
-    if (traplog.reset_count < TASK_MGR_CPU_RESET_LIMIT) {
-    // Initiate CPU Reset
-        CPU_RESET;    
-    }
-    else {
-    // If CPU has been reset a user defined number of attempts 
-    // defined by TASK_MGR_CPU_RESET_LIMIT, the software is stalled 
-    // here
-        while (1)  
-        { Nop(); Nop(); Nop(); }
-    }
+    // To prevent that the CPU ends up restarting endlessly, the reset root cause and the 
+    // decaying reset rate are evaluated by CheckCPUResetRootCause() after the CPU reset, 
+    // selecting a restart profile up to a safe stop in standby mode. 
+    CPU_RESET;
     
 // if this code line is ever reached, something really bad had happened...
 #if (START_OS_BEFORE_MAIN==0)
@@ -53,6 +53,9 @@
 
 #include "_root/config/task_manager_config.h"
 #include "_root/generic/os_TaskManager.h"
+#include "_root/generic/fdrv_FaultHandler.h"
+#include "_root/generic/fdrv_TrapHandler.h"
+#include "_root/generic/os_BootProfiler.h"
 #include "apl/config/UserTasks.h"
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -201,7 +204,7 @@ volatile uint16_t os_ProcessTaskQueue(void) {
 
 volatile uint16_t os_CheckOperationModeStatus(void) {
 
-    volatile uint16_t i=0;
+    volatile uint16_t i=0, fres=1;
     
     // Specific conditions and op-mode switch-overs during system startup
     if (task_mgr.op_mode.value == OP_MODE_UNKNOWN)
@@ -219,7 +222,17 @@ volatile uint16_t os_CheckOperationModeStatus(void) {
     // only when all fault flags have been cleared the system will be able to enter startup-mode
     // to enter normal operation.
     { 
-        task_mgr.op_mode.value = OP_MODE_STARTUP_SEQUENCE; // put system into Fault mode to make sure all FAULT flags are cleared before entering normal operation
+        if (task_mgr.status.bits.init_pending)
+        // while peripheral initialization sequences are pending, only the last task of the queue is repeated
+        {
+            task_mgr.task_queue.active_queue = &task_queue_firmware_init[task_queue_firmware_init_size-1];
+            task_mgr.task_queue.size = 1;
+            task_mgr.task_queue.ubound = 0;
+        }
+        else
+        {
+            task_mgr.op_mode.value = OP_MODE_STARTUP_SEQUENCE; // put system into Fault mode to make sure all FAULT flags are cleared before entering normal operation
+        }
     }
     else if ((task_mgr.pre_op_mode.value == OP_MODE_STARTUP_SEQUENCE) && (task_mgr.op_mode.value == OP_MODE_STARTUP_SEQUENCE)) 
     // system-level start-up task queue is only run once before ending in NORMAL mode.
@@ -228,6 +241,13 @@ volatile uint16_t os_CheckOperationModeStatus(void) {
         task_mgr.op_mode.value = OP_MODE_IDLE;
     }
     
+    // After a safe stop restart the system must not start up, but remains in standby mode
+    if ((traplog.restart_profile == CPU_RESTART_SAFE_STOP) && 
+        (task_mgr.op_mode.value & (OP_MODE_STARTUP_SEQUENCE | OP_MODE_IDLE | OP_MODE_RUN)))
+    {
+        task_mgr.op_mode.value = OP_MODE_STANDBY;
+    }
+    
     
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     // Skip execution if operation mode has not changed
@@ -260,6 +280,11 @@ volatile uint16_t os_CheckOperationModeStatus(void) {
                 // Do not perform any user function during switch-over to this mode
                 task_mgr.op_mode_switch_over_function = NULL; 
 
+                // Capture startup-time of the previous task queue
+                #if (USE_BOOT_PROFILER == 1)
+                fres &= CaptureBootPhase(BOOT_PHASE_BOOT_QUEUE);
+                #endif
+                
                 break;
 
             case OP_MODE_STARTUP_SEQUENCE:
@@ -273,6 +298,11 @@ volatile uint16_t os_CheckOperationModeStatus(void) {
                 // Do not perform any user function during switch-over to this mode
                 task_mgr.op_mode_switch_over_function = NULL; 
 
+                // Capture startup-time of the previous task queue
+                #if (USE_BOOT_PROFILER == 1)
+                fres &= CaptureBootPhase(BOOT_PHASE_FIRMWARE_INIT);
+                #endif
+                
                 break;
 
             case OP_MODE_IDLE:
@@ -286,6 +316,11 @@ volatile uint16_t os_CheckOperationModeStatus(void) {
                 // Execute user function before switching to this operating mode
                 task_mgr.op_mode_switch_over_function = &task_queue_idle_init; 
 
+                // Capture startup-time of the previous task queue
+                #if (USE_BOOT_PROFILER == 1)
+                fres &= CaptureBootPhase(BOOT_PHASE_STARTUP_SEQUENCE);
+                #endif
+                
                 break;
 
             case OP_MODE_RUN:
@@ -312,6 +347,11 @@ volatile uint16_t os_CheckOperationModeStatus(void) {
                 // set global fault override flag bit
                 task_mgr.status.bits.fault_override = true; 
                 
+                // Capture fault queue entry latency of all recently tripped fault objects
+                #if (USE_FAULT_LATENCY_INSTRUMENTATION == 1)
+                CaptureFaultLatencyQueueEntry();
+                #endif
+                
                 // Execute user function before switching to this operating mode
                 task_mgr.op_mode_switch_over_function = &task_queue_fault_init; 
                 
@@ -359,7 +399,7 @@ volatile uint16_t os_CheckOperationModeStatus(void) {
         task_mgr.status.bits.queue_switch = false; // reset queue switch flag for one queue execution loop
     }
 
-    return (1);
+    return (fres);
 }
 
 
@@ -384,15 +424,20 @@ volatile uint16_t os_TaskManager_Initialize(void) {
     task_mgr.task_queue.active_task_id = task_mgr.task_queue.active_queue[0]; // Set task ID to DEFAULT (IDle Task))
     task_mgr.task_queue.active_index = 0; // Reset task queue pointer
     task_mgr.os_timer.task_period_max = 0; // Reset maximum task time meter result
+    task_mgr.os_timer.tick_counter = 0; // Reset system time stamp counter
 
     task_mgr.status.bits.queue_switch = false;
     task_mgr.status.bits.startup_sequence_complete = false;
     task_mgr.status.bits.fault_override = false;
+    task_mgr.status.bits.degraded_mode = (bool)(traplog.restart_profile == CPU_RESTART_DEGRADED);
+    task_mgr.status.bits.init_pending = false;
     
     // Scheduler Timer Configuration
     task_mgr.os_timer.index = TASK_MGR_TIMER_INDEX; // Index of the timer peripheral used
     task_mgr.os_timer.reg_counter = &TASK_MGR_TIMER_COUNTER_REGISTER;
     task_mgr.os_timer.reg_period = &TASK_MGR_TIMER_PERIOD_REGISTER;
+    task_mgr.os_timer.reg_isr_flag = &TASK_MGR_TIMER_ISR_FLAG_REGISTER;
+    task_mgr.os_timer.isr_flag_mask = TASK_MGR_TIMER_ISR_FLAG_BIT_MASK;
     task_mgr.os_timer.master_period = TASK_MGR_MASTER_PERIOD; // Global task execution period 
     task_mgr.os_timer.rescue_period = TASK_MGR_RESCUE_PERIOD; // Global task rescue period 
 
@@ -423,6 +468,38 @@ volatile uint16_t os_TaskManager_Initialize(void) {
 }
 
 
+/*!os_GetSystemTimestamp
+ * ***********************************************************************************************
+ * Summary:
+ * Returns the recent system time stamp in task manager timer cycles
+ * 
+ * Parameters:
+ *      (none)
+ *
+ * Return:
+ *      type: uint32_t
+ *      System time stamp in task manager timer cycles
+ *
+ * Description:
+ * Combines the system tick counter and the recent timer counter value into one 32-bit time stamp.
+ * If the timer has already overrun but the tick counter has not been incremented yet (timer
+ * interrupt flag bit still set), the pending tick is added. The time stamp rolls over after
+ * 2^32 timer cycles (approx. 42 sec at 100 MHz). This function is the common time base of the
+ * boot profiler and the fault latency instrumentation.
+ * ***********************************************************************************************/
+
+volatile uint32_t os_GetSystemTimestamp(void) {
+
+    volatile uint32_t ticks = task_mgr.os_timer.tick_counter;
+    volatile uint16_t count = *task_mgr.os_timer.reg_counter;
+
+    // account for timer overrun not yet processed by the scheduler
+    if((*task_mgr.os_timer.reg_isr_flag & task_mgr.os_timer.isr_flag_mask) && (count < (task_mgr.os_timer.master_period >> 1)))
+    { ticks++; }
+
+    return((ticks * (uint32_t)task_mgr.os_timer.master_period) + (uint32_t)count);
+}
+
 /*!task_Idle
  * ***********************************************************************************************
  * Summary:
@@ -99,6 +99,25 @@ volatile uint16_t user_fault_object_init_functions_size =
     (sizeof(user_fault_object_init_functions)/sizeof(user_fault_object_init_functions[0]));
 
 
+/*!user_fault_recovery_stages[]
+ * ***********************************************************************************************
+ * Description:
+ * The user_fault_recovery_stages[] array lists the fault groups, which are masked when the system
+ * restarts from fault mode and re-enabled one stage after the other by the fault recovery engine
+ * (see USE_FAULT_RECOVERY_ENGINE). Control loop faults are re-enabled first, output faults after
+ * the next stage delay, giving the power stage time to ramp up before being monitored again.
+ * ***********************************************************************************************/
+
+volatile uint16_t user_fault_recovery_stages[] = {
+
+    FLTGRP_CONTROL,     // Stage 1: control loop faults
+    FLTGRP_OUTPUT       // Stage 2: output faults
+
+};
+volatile uint16_t user_fault_recovery_stages_size =
+    (sizeof(user_fault_recovery_stages)/sizeof(user_fault_recovery_stages[0]));
+
+
 /*!User Defined Fault Object Configuration
  * ***********************************************************************************************
  * Description:
@@ -116,8 +135,8 @@ volatile uint16_t MyFaultObject_Initialize(void)
     // Configuring MyFaultObject
 
     // specify the target value/register to be monitored
-    fltobj_MyFaultObject.id = (uint16_t)FLTOBJ_CPU_FAILURE_ERROR;
-    fltobj_MyFaultObject.error_code = (uint32_t)FLTOBJ_CPU_FAILURE_ERROR;
+    fltobj_MyFaultObject.id = (uint16_t)FLTOBJ_MY_FAULT_OBJECT; // Fault object IDs need to be unique
+    fltobj_MyFaultObject.error_code = (uint32_t)FLTOBJ_MY_FAULT_OBJECT;
     
     // configuring the trip and reset levels as well as trip and reset event filter setting
     fltobj_MyFaultObject.criteria.source_object = &traplog.status.value; // Pointer to a global variable or SFR
@@ -125,6 +144,7 @@ volatile uint16_t MyFaultObject_Initialize(void)
     fltobj_MyFaultObject.criteria.compare_object = NULL; // not used => comparison against constant value
     fltobj_MyFaultObject.criteria.compare_bit_mask = FAULT_OBJECT_CPU_RESET_TRIGGER_BIT_MASK;
     fltobj_MyFaultObject.criteria.compare_type = FAULT_LEVEL_EQUAL;
+    fltobj_MyFaultObject.criteria.source_type = FLTOBJ_SOURCE_TYPE_UINT16; // Data type of source and compare object
     fltobj_MyFaultObject.criteria.trip_level = 1;   // Set/reset trip level value
     fltobj_MyFaultObject.criteria.trip_cnt_threshold = 1; // Set/reset number of successive trips before triggering fault event
     fltobj_MyFaultObject.criteria.reset_level = 1;  // Set/reset fault release level value
@@ -137,6 +157,8 @@ volatile uint16_t MyFaultObject_Initialize(void)
     fltobj_MyFaultObject.flt_class.bits.critical = 0; // Set =1 if this fault object triggers a critical fault condition response
     fltobj_MyFaultObject.flt_class.bits.catastrophic = 0; // Set =1 if this fault object triggers a catastrophic fault condition response
 
+    fltobj_MyFaultObject.groups = FLTGRP_USER; // Fault group membership (groups can be masked by the fault registry)
+
     fltobj_MyFaultObject.flt_class.bits.user_class = 1; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_MyFaultObject.trip_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
     fltobj_MyFaultObject.reset_function = 0; // Set =1 if this fault object triggers a user-defined fault condition response
@@ -0,0 +1,19 @@
+/*!UserFaultRules.c
+ * ****************************************************************************
+ * File:   UserFaultRules.c
+ *
+ * Description:
+ * Composite fault rules generated by tools/fault_rule_compiler.py from
+ * UserFaultRules.txt. Do not edit manually.
+ ******************************************************************************/
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stddef.h> // include standard definition types header file
+
+#include "_root/generic/fdrv_FaultRules.h"
+
+volatile FAULT_RULE_t *user_fault_rule_list[] = { NULL };
+volatile uint16_t user_fltrule_list_size = 0;
+
+// EOF
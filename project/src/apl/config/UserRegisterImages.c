@@ -0,0 +1,24 @@
+/*!UserRegisterImages.c
+ * ****************************************************************************
+ * File:   UserRegisterImages.c
+ *
+ * Description:
+ * Peripheral register images generated by tools/register_image_generator.py
+ * from UserRegisterImages.txt. Do not edit manually.
+ ******************************************************************************/
+
+#include <xc.h> // include processor files - each processor file is guarded.  
+#include <stdint.h> // include standard integer types header file
+#include <stddef.h> // include standard definition types header file
+
+#include "_root/config/task_manager_config.h"
+#include "mcal/initialization/init_regimage.h"
+
+#if (USE_REGISTER_IMAGES == 1)
+
+const REGISTER_IMAGE_t *register_image_list[] = { NULL };
+const uint16_t register_image_list_size = 0;
+
+#endif
+
+// EOF
@@ -70,6 +70,7 @@ volatile uint16_t (*Task_Table[])(void) = {
     
     // Cross-function modules
     APPLICATION_Initialize, // initialize system-wide application data structure
+    exec_InitSequences,     // advance non-blocking peripheral initialization sequences
     
     /* ==================== USER FUNCTIONS LIST ==================== */
 
@@ -148,12 +149,14 @@ volatile uint16_t task_queue_boot_size = (sizeof(task_queue_boot)/sizeof(task_qu
  *   PLEASE NOTE:
  *   The device startup task queue is only executed once calling all listed tasks in one successive 
  *   sequence.  At the end of this task queue the task manager will automatically switch over to 
- *   task_queue_startup_sequence[].
+ *   task_queue_startup_sequence[]. While non-blocking peripheral initialization sequences are
+ *   pending, the last task of this queue (TASK_INIT_SEQUENCES) is repeated until all sequences 
+ *   have been completed.
  * *********************************************************************************************** */
 
 volatile uint16_t task_queue_firmware_init[] = {
     TASK_IDLE,  // Step #0
-    TASK_IDLE   // empty task used as task list execution time buffer 
+    TASK_INIT_SEQUENCES // peripheral initialization sequences (needs to be the last task, see USE_NONBLOCKING_PERIPHERAL_INIT)
 };
 volatile uint16_t task_queue_firmware_init_size = 
         (sizeof(task_queue_firmware_init)/sizeof(task_queue_firmware_init[0]));
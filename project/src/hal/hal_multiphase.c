@@ -0,0 +1,250 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!hal_multiphase.c
+ * ****************************************************************************
+ * File:   hal_multiphase.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file configures the PWM update group of a multiphase converter,
+ * distributes the phase offsets of all active phases across the switching 
+ * period and adds or sheds phases depending on the load current.
+ * ****************************************************************************/
+
+#include "hal/hal.h"
+#include "_root/generic/os_Globals.h"
+
+#if (PWM_PHASE_COUNT > MPH_PHASE_COUNT_MAX)
+  #error === number of converter phases exceeds MPH_PHASE_COUNT_MAX ===
+#endif
+
+// Output current thresholds at which phase #1 to #4 are added/shed (phase #1 is always active)
+static const uint16_t mph_add_threshold[MPH_PHASE_COUNT_MAX] = {
+    0xFFFF, IOUT_MPH_UTH_PHASE2, IOUT_MPH_UTH_PHASE3, IOUT_MPH_UTH_PHASE4 
+};
+static const uint16_t mph_shed_threshold[MPH_PHASE_COUNT_MAX] = {
+    0x0000, IOUT_MPH_LTH_PHASE2, IOUT_MPH_LTH_PHASE3, IOUT_MPH_LTH_PHASE4 
+};
+
+/*!MPH_Initialize()
+ * ************************************************************************************************
+ * Summary:
+ * Initializes the PWM update group and phase shedding settings of a multiphase converter
+ * 
+ * Parameters:
+ * MULTIPHASE_t* mph:       Pointer to the multiphase converter data structure
+ * const uint16_t* instance: Array of PWM generator indices of phase #1 to #N (e.g. 1 for PG1)
+ * uint16_t phase_count:    Number of installed phases N
+ * uint16_t period:         Switching period in [PWM ticks] (e.g. SWITCHING_PERIOD)
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer, invalid phase count or PWM generator is enabled)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The PWM generator of phase #1 becomes the master of the update group, all other generators
+ * are slaved to its update requests. Phase shedding thresholds and dwell times are loaded from
+ * syscfg_limits.h and automatic phase shedding is enabled when USE_PHASE_SHEDDING is set.
+ * The converter starts with all phases active and the initial phase offsets are written to
+ * the PWM generators. This function has to be called before the PWM generators are enabled.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t MPH_Initialize(MULTIPHASE_t* mph, const uint16_t* instance, uint16_t phase_count, uint16_t period)
+{
+    volatile uint16_t fres=1;
+    uint16_t i=0;
+    
+    if ((mph == NULL) || (instance == NULL)) return(0);
+    if ((phase_count == 0) || (phase_count > MPH_PHASE_COUNT_MAX)) return(0);
+    
+    for (i=0; i<phase_count; i++)
+    {
+        fres &= HSPWM_HandleInitialize(&mph->pg[i], instance[i]);
+        if (fres == 0) return(0);
+        
+        if (i == 0)
+        { fres &= HSPWM_GroupInitialize(&mph->group, &mph->pg[0], HSPWM_UPDATE_SOC); }
+        else
+        { fres &= HSPWM_GroupAddSlave(&mph->group, &mph->pg[i]); }
+    }
+    
+    for (i=0; i<MPH_PHASE_COUNT_MAX; i++)
+    {
+        mph->data[i].duty_cycle = 0;
+        mph->data[i].phase = 0;
+        mph->data[i].trigger_a = 0;
+        mph->data[i].trigger_b = 0;
+        mph->duty_trim[i] = 0;
+        mph->add_threshold[i] = mph_add_threshold[i];
+        mph->shed_threshold[i] = mph_shed_threshold[i];
+    }
+    
+    mph->add_delay = IOUT_MPH_ADD_DLY;
+    mph->shed_delay = IOUT_MPH_SHED_DLY;
+    mph->counter = 0;
+    mph->period = period;
+    mph->phase_count = phase_count;
+    mph->min_phases = 1;
+    mph->active_phases = phase_count;
+    mph->ovr_hold = 0;
+    mph->shedding_enable = (bool)(USE_PHASE_SHEDDING == 1);
+    mph->balance = NULL;
+    mph->phase_config[0].active_phases = phase_count;
+    mph->phase_config[0].phase_step = 0;
+    mph->phase_config[1] = mph->phase_config[0];
+    mph->config = &mph->phase_config[0];
+    
+    fres &= MPH_SetActivePhases(mph, phase_count);
+    MPH_Update(mph, period, 0, 0, 0);
+    
+    return(fres);
+}
+
+/*!MPH_SetActivePhases()
+ * ************************************************************************************************
+ * Summary:
+ * Sets the number of active phases and recalculates their phase offsets
+ * 
+ * Parameters:
+ * MULTIPHASE_t* mph:       Pointer to the multiphase converter data structure
+ * uint16_t active_phases:  Number of active phases (min_phases to phase_count)
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer or number of phases out of range)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The outputs of shed phases are held in override state before the new configuration is 
+ * published. Phase k of the remaining phases is shifted by k * period / N, whereby the phase 
+ * distance is stored as fraction of the period (65536 / N) and scaled to the recent period by 
+ * MPH_Update(). Phase count and distance are written into the shadow configuration and activated by swapping the configuration
+ * pointer, which is a single, atomic write. The next call of MPH_Update() applies the new 
+ * offsets and clears the duty cycle of shed phases. The outputs of added phases stay in override state until
+ * the next call of MPH_Execute(), so that the control loop has written a valid duty cycle
+ * before the phase starts switching.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t MPH_SetActivePhases(MULTIPHASE_t* mph, uint16_t active_phases)
+{
+    volatile uint16_t fres=1;
+    uint16_t i=0;
+    MPH_PHASE_CONFIG_t* shadow;
+    
+    if (mph == NULL) return(0);
+    if ((active_phases < mph->min_phases) || (active_phases > mph->phase_count)) return(0);
+    
+    // Stop shed phases before the phase offsets of the remaining phases are moved
+    for (i=active_phases; i<mph->phase_count; i++)
+    {
+        if (!(mph->ovr_hold & (1 << i)))
+        {
+            fres &= smpsHSPWM_OVR_Hold(mph->pg[i].instance);
+            mph->ovr_hold |= (1 << i);
+        }
+        mph->duty_trim[i] = 0;
+    }
+
+    // Distribute active phases evenly across the switching period in the shadow configuration
+    shadow = &mph->phase_config[(mph->config == &mph->phase_config[0]) ? 1 : 0];
+    if (active_phases > 1)
+    { shadow->phase_step = (uint16_t)((0x00010000UL + (active_phases >> 1)) / (uint32_t)active_phases); }
+    else
+    { shadow->phase_step = 0; }
+    shadow->active_phases = active_phases;
+    
+    mph->config = shadow; // Publish new configuration to the control loop
+    mph->active_phases = active_phases;
+    mph->counter = 0;
+    
+    return(fres);
+}
+
+/*!MPH_Execute()
+ * ************************************************************************************************
+ * Summary:
+ * Multiphase manager task adding and shedding phases depending on the load current
+ * 
+ * Parameters:
+ * MULTIPHASE_t* mph:       Pointer to the multiphase converter data structure
+ * uint16_t load_current:   Most recent (averaged) output current in [ADC ticks]
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer or override hold/release failed)
+ * 1 = TRUE
+ * 
+ * Description:
+ * This function is called periodically by the task scheduler. It first calls the phase 
+ * current balancing hook and releases the outputs of phases added by the previous call. 
+ * A phase is added when the load current exceeds the add threshold of the next phase for 
+ * longer than add_delay calls, and shed when the load current drops below the shed threshold
+ * of the last active phase for longer than shed_delay calls. Every transition changes the 
+ * number of active phases by one. The dwell time counter is reset as soon as the load 
+ * current returns into the hysteresis band between both thresholds.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t MPH_Execute(MULTIPHASE_t* mph, uint16_t load_current)
+{
+    volatile uint16_t fres=1;
+    uint16_t i=0, n=0;
+    
+    if (mph == NULL) return(0);
+    
+    if (mph->balance != NULL)
+    { mph->balance(mph); }
+    
+    n = mph->active_phases;
+    
+    // Release outputs of phases added by the previous call
+    for (i=0; i<n; i++)
+    {
+        if (mph->ovr_hold & (1 << i))
+        {
+            fres &= smpsHSPWM_OVR_Release(mph->pg[i].instance);
+            mph->ovr_hold &= ~(1 << i);
+        }
+    }
+    
+    if (!mph->shedding_enable)
+    {
+        mph->counter = 0;
+        return(fres);
+    }
+    
+    if ((n < mph->phase_count) && (load_current > mph->add_threshold[n]))
+    {
+        if (++mph->counter > mph->add_delay)
+        { fres &= MPH_SetActivePhases(mph, (n + 1)); }
+    }
+    else if ((n > mph->min_phases) && (load_current < mph->shed_threshold[n-1]))
+    {
+        if (++mph->counter > mph->shed_delay)
+        { fres &= MPH_SetActivePhases(mph, (n - 1)); }
+    }
+    else
+    {
+        mph->counter = 0;
+    }
+    
+    return(fres);
+}
+
+// EOF
@@ -0,0 +1,150 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!hal_spread_spectrum.c
+ * ****************************************************************************
+ * File:   hal_spread_spectrum.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file precomputes the modulation profile of the switching period
+ * and rescales duty cycle limits and ADC trigger position to each period of the
+ * profile. The profile is stepped through by the inline function SSM_Execute()
+ * declared in hal_spread_spectrum.h.
+ * ****************************************************************************/
+
+#include "hal/hal.h"
+#include "_root/generic/os_Globals.h"
+
+#if (USE_SPREAD_SPECTRUM_MODULATION == 1)
+
+#if ((SSM_TABLE_SIZE & (SSM_TABLE_SIZE - 1)) != 0)
+  #error === SSM_TABLE_SIZE needs to be a power of 2 ===
+#endif
+
+#define SSM_LFSR_SEED   0xACE1  // Start value of the pseudo-random sequence
+#define SSM_LFSR_TAPS   0xB400  // Feedback taps of the 16-bit Galois LFSR (x^16 + x^14 + x^13 + x^11 + 1)
+
+/*!SSM_SetEntry()
+ * ************************************************************************************************
+ * Summary:
+ * Fills one table entry with a switching period and the settings rescaled to this period
+ * 
+ * Parameters:
+ * SSM_ENTRY_t* entry: Pointer to the table entry
+ * uint16_t period:    Switching period of this entry
+ * uint16_t nominal:   Nominal switching period the settings below are given for
+ * uint16_t duty_min:  Minimum duty cycle at nominal period
+ * uint16_t duty_max:  Maximum duty cycle at nominal period
+ * uint16_t trigger:   ADC trigger position at nominal period
+ * 
+ * Returns:
+ * (none)
+ * 
+ * ***********************************************************************************************/
+static void SSM_SetEntry(SSM_ENTRY_t* entry, uint16_t period, uint16_t nominal, 
+            uint16_t duty_min, uint16_t duty_max, uint16_t trigger)
+{
+    entry->period = period;
+    entry->duty_min = (uint16_t)(((uint32_t)duty_min * (uint32_t)period) / (uint32_t)nominal);
+    entry->duty_max = (uint16_t)(((uint32_t)duty_max * (uint32_t)period) / (uint32_t)nominal);
+    entry->trigger_a = (uint16_t)(((uint32_t)trigger * (uint32_t)period) / (uint32_t)nominal);
+    return;
+}
+
+/*!SSM_Initialize()
+ * ************************************************************************************************
+ * Summary:
+ * Precomputes the spread spectrum modulation profile
+ * 
+ * Parameters:
+ * SPREAD_SPECTRUM_t* ssm:      Pointer to the spread spectrum modulation data structure
+ * const HSPWM_GROUP_t* group:  PWM update group of all modulated generators
+ * uint16_t period:             Nominal switching period (e.g. SWITCHING_PERIOD)
+ * uint16_t deviation:          Maximum period deviation (e.g. SSM_PERIOD_DEVIATION)
+ * uint16_t duty_min:           Minimum duty cycle at nominal period (e.g. PWM_DUTY_RATIO_MIN)
+ * uint16_t duty_max:           Maximum duty cycle at nominal period (e.g. PWM_DUTY_RATIO_MAX)
+ * uint16_t trigger:            ADC trigger position at nominal period
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer or deviation exceeds nominal period)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The switching period is swept from (period - deviation) to (period + deviation) and back
+ * within SSM_TABLE_SIZE steps. When SSM_PROFILE_RANDOM is selected, the same set of periods
+ * is shuffled by a 16-bit LFSR, which results in an equal distribution of the switching 
+ * frequency across the modulation band without a periodic modulation frequency. Duty cycle
+ * limits and ADC trigger position are rescaled with the period of each entry. 
+ * 
+ * Modulation is enabled when the function returns. The nominal period is written to the 
+ * generators of the update group and is applied with the next update request.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t SSM_Initialize(SPREAD_SPECTRUM_t* ssm, const HSPWM_GROUP_t* group, 
+            uint16_t period, uint16_t deviation, uint16_t duty_min, uint16_t duty_max, uint16_t trigger)
+{
+    uint16_t i=0, pos=0;
+    int32_t delta=0;
+    
+    if ((ssm == NULL) || (group == NULL)) return(0);
+    if ((period == 0) || (deviation >= period)) return(0);
+    
+    // Triangular profile: -deviation ... +deviation ... -deviation
+    for (i=0; i<SSM_TABLE_SIZE; i++)
+    {
+        pos = (i < (SSM_TABLE_SIZE/2)) ? i : (SSM_TABLE_SIZE - i);
+        delta = (((int32_t)2 * (int32_t)deviation * (int32_t)pos) / (int32_t)(SSM_TABLE_SIZE/2)) - (int32_t)deviation;
+        SSM_SetEntry(&ssm->table[i], (uint16_t)((int32_t)period + delta), period, duty_min, duty_max, trigger);
+    }
+    
+    #if (SSM_PROFILE == SSM_PROFILE_RANDOM)
+    {
+        uint16_t lfsr = SSM_LFSR_SEED;
+        uint16_t k=0;
+        SSM_ENTRY_t buffer;
+        
+        // Fisher-Yates shuffle of the triangular profile
+        for (i=(SSM_TABLE_SIZE-1); i>0; i--)
+        {
+            lfsr = (lfsr >> 1) ^ ((lfsr & 0x0001) ? SSM_LFSR_TAPS : 0);
+            k = (lfsr % (i + 1));
+            buffer = ssm->table[i];
+            ssm->table[i] = ssm->table[k];
+            ssm->table[k] = buffer;
+        }
+    }
+    #endif
+    
+    // Nominal entry used while modulation is disabled
+    SSM_SetEntry(&ssm->table[SSM_TABLE_SIZE], period, period, duty_min, duty_max, trigger);
+    
+    ssm->group = group;
+    ssm->enable = false;
+    (void)SSM_Execute(ssm);
+    ssm->enable = true;
+    
+    return(1);
+}
+
+#endif
+
+// EOF
@@ -0,0 +1,435 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!drv_hsadc.c
+ * ****************************************************************************
+ * File:   drv_hsadc.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file configures DMA channels streaming ADC conversion results 
+ * into ping-pong buffers and provides the DMA interrupt service routines 
+ * publishing completed blocks to the zero-copy reader functions declared in
+ * drv_hsadc.h. It further allocates ADC digital filters to decimation 
+ * channels and runs the software CIC stages of the remaining channels.
+ * ****************************************************************************/
+
+#include "mcal/mcal.h"
+#include "_root/generic/os_Globals.h"
+
+static uint16_t hsadc_adfl_used = 0; // Bit mask of ADC digital filters allocated to decimation channels
+
+#if (HSADC_STREAM_ENABLE == 1)
+
+#if (HSADC_STREAM_DMA_COUNT > HSADC_DMA_COUNT)
+  #error === number of DMA channels used by ADC streams exceeds HSADC_DMA_COUNT ===
+#endif
+
+#define HSADC_STREAM_ISR __attribute__((interrupt, no_auto_psv))
+
+static HSADC_STREAM_t* hsadc_stream[HSADC_STREAM_DMA_COUNT]; // ADC streams assigned to DMA channels
+
+/*!HSADC_StreamInitialize()
+ * ************************************************************************************************
+ * Summary:
+ * Configures a DMA channel streaming the results of one ADC input into a ping-pong buffer
+ * 
+ * Parameters:
+ * HSADC_STREAM_t* stream:  Pointer to the ADC stream
+ * uint16_t channel:        Index of the DMA channel (0 to HSADC_STREAM_DMA_COUNT-1)
+ * volatile uint16_t* adcbuf: ADC result register of the input (e.g. &ADCBUF12)
+ * uint16_t trigger:        DMA channel trigger source (CHSEL) of the ADC conversion of this
+ *                          input (see DMA channel trigger sources of the device data sheet)
+ * uint16_t* buffer:        Ping-pong buffer of (2 x block_size) samples
+ * uint16_t block_size:     Number of samples per block
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer, invalid channel or block size)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The DMA channel is configured for repeated continuous word transfers from the fixed ADC 
+ * result register into the incremented buffer address. Source, destination and transfer 
+ * count are reloaded automatically after each full buffer. The 50% watermark interrupt marks
+ * the completion of the first half, the transfer complete interrupt the completion of the 
+ * second half. The DMA module is enabled with an address range covering SFRs and data RAM. 
+ * The stream is started by HSADC_StreamStart().
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSADC_StreamInitialize(HSADC_STREAM_t* stream, uint16_t channel, 
+            volatile uint16_t* adcbuf, uint16_t trigger, uint16_t* buffer, uint16_t block_size)
+{
+    uint16_t offset=0;
+    
+    if ((stream == NULL) || (adcbuf == NULL) || (buffer == NULL)) return(0);
+    if ((channel >= HSADC_STREAM_DMA_COUNT) || (block_size == 0) || (block_size > 0x7FFF)) return(0);
+    
+    offset = channel * ((uint16_t)&DMACH1 - (uint16_t)&DMACH0); // Address offset in bytes
+    
+    stream->dmachn = (volatile uint16_t*)((volatile uint8_t*)&DMACH0 + offset);
+    stream->dmaintn = (volatile uint16_t*)((volatile uint8_t*)&DMAINT0 + offset);
+    stream->channel = channel;
+    stream->buffer = buffer;
+    stream->block_size = block_size;
+    stream->sequence = 0;
+    stream->overruns = 0;
+    stream->dma_overruns = 0;
+    
+    *stream->dmachn = 0; // Disable channel before it is reconfigured
+    *(volatile uint16_t*)((volatile uint8_t*)&DMASRC0 + offset) = (uint16_t)adcbuf;
+    *(volatile uint16_t*)((volatile uint8_t*)&DMADST0 + offset) = (uint16_t)buffer;
+    *(volatile uint16_t*)((volatile uint8_t*)&DMACNT0 + offset) = (block_size << 1);
+    *stream->dmaintn = (((trigger << 8) & HSADC_DMAINT_CHSEL_MASK) | HSADC_DMAINT_HALFEN);
+    *stream->dmachn = (HSADC_DMACH_RELOAD | HSADC_DMACH_DAMODE_INC | HSADC_DMACH_TRMODE_RPT_CONT);
+    
+    DMAL = 0x0000;
+    DMAH = 0xFFFF;
+    DMACON |= HSADC_DMACON_DMAEN;
+    
+    hsadc_stream[channel] = stream;
+    
+    switch (channel)
+    {
+        case 0: _DMA0IP = HSADC_STREAM_ISR_PRIORITY; _DMA0IF = 0; _DMA0IE = 1; break;
+        #if (HSADC_STREAM_DMA_COUNT > 1)
+        case 1: _DMA1IP = HSADC_STREAM_ISR_PRIORITY; _DMA1IF = 0; _DMA1IE = 1; break;
+        #endif
+        #if (HSADC_STREAM_DMA_COUNT > 2)
+        case 2: _DMA2IP = HSADC_STREAM_ISR_PRIORITY; _DMA2IF = 0; _DMA2IE = 1; break;
+        #endif
+        #if (HSADC_STREAM_DMA_COUNT > 3)
+        case 3: _DMA3IP = HSADC_STREAM_ISR_PRIORITY; _DMA3IF = 0; _DMA3IE = 1; break;
+        #endif
+        #if (HSADC_STREAM_DMA_COUNT > 4)
+        case 4: _DMA4IP = HSADC_STREAM_ISR_PRIORITY; _DMA4IF = 0; _DMA4IE = 1; break;
+        #endif
+        #if (HSADC_STREAM_DMA_COUNT > 5)
+        case 5: _DMA5IP = HSADC_STREAM_ISR_PRIORITY; _DMA5IF = 0; _DMA5IE = 1; break;
+        #endif
+        default: return(0);
+    }
+    
+    return(1);
+}
+
+/*!HSADC_StreamStart()
+ * ************************************************************************************************
+ * Summary:
+ * Enables the DMA channel of an ADC stream
+ * 
+ * Parameters:
+ * HSADC_STREAM_t* stream: Pointer to the initialized ADC stream
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer or stream has not been initialized)
+ * 1 = TRUE
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSADC_StreamStart(HSADC_STREAM_t* stream)
+{
+    if ((stream == NULL) || (stream->dmachn == NULL)) return(0);
+    
+    *stream->dmaintn &= ~(HSADC_DMAINT_DONEIF | HSADC_DMAINT_HALFIF | HSADC_DMAINT_OVRUNIF);
+    *stream->dmachn |= HSADC_DMACH_CHEN;
+    
+    return((uint16_t)(bool)(*stream->dmachn & HSADC_DMACH_CHEN));
+}
+
+/*!HSADC_StreamStop()
+ * ************************************************************************************************
+ * Summary:
+ * Disables the DMA channel of an ADC stream
+ * 
+ * Parameters:
+ * HSADC_STREAM_t* stream: Pointer to the ADC stream
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer or stream has not been initialized)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The block currently filled by the DMA is discarded. Completed blocks remain valid.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSADC_StreamStop(HSADC_STREAM_t* stream)
+{
+    if ((stream == NULL) || (stream->dmachn == NULL)) return(0);
+    
+    *stream->dmachn &= ~HSADC_DMACH_CHEN;
+    
+    return((uint16_t)(!(*stream->dmachn & HSADC_DMACH_CHEN)));
+}
+
+/*!HSADC_StreamInterrupt()
+ * ************************************************************************************************
+ * Summary:
+ * Publishes completed blocks of an ADC stream
+ * 
+ * Parameters:
+ * HSADC_STREAM_t* stream: Pointer to the ADC stream assigned to the DMA channel
+ * 
+ * Returns:
+ * (none)
+ * 
+ * Description:
+ * Called by the DMA interrupt service routines. The 50% watermark and transfer complete flags
+ * are handled in order of occurrence, so that both blocks are published if the interrupt has 
+ * been delayed beyond the completion of the second half.
+ * 
+ * ***********************************************************************************************/
+static inline void HSADC_StreamInterrupt(HSADC_STREAM_t* stream)
+{
+    uint16_t flags=0;
+    
+    if (stream == NULL) return;
+    
+    flags = *stream->dmaintn;
+    *stream->dmaintn &= ~(flags & (HSADC_DMAINT_DONEIF | HSADC_DMAINT_HALFIF | HSADC_DMAINT_OVRUNIF));
+    
+    if (flags & HSADC_DMAINT_OVRUNIF)
+    { stream->dma_overruns++; }
+    
+    if (flags & HSADC_DMAINT_HALFIF)
+    {
+        stream->sequence++;
+        if (stream->block_ready != NULL)
+        { stream->block_ready(stream, stream->buffer); }
+    }
+    
+    if (flags & HSADC_DMAINT_DONEIF)
+    {
+        stream->sequence++;
+        if (stream->block_ready != NULL)
+        { stream->block_ready(stream, (stream->buffer + stream->block_size)); }
+    }
+    
+    return;
+}
+
+/* ***********************************************************************************************
+ * DMA INTERRUPT SERVICE ROUTINES
+ * ***********************************************************************************************/
+
+void HSADC_STREAM_ISR _DMA0Interrupt(void)
+{ HSADC_StreamInterrupt(hsadc_stream[0]); _DMA0IF = 0; }
+
+#if (HSADC_STREAM_DMA_COUNT > 1)
+void HSADC_STREAM_ISR _DMA1Interrupt(void)
+{ HSADC_StreamInterrupt(hsadc_stream[1]); _DMA1IF = 0; }
+#endif
+
+#if (HSADC_STREAM_DMA_COUNT > 2)
+void HSADC_STREAM_ISR _DMA2Interrupt(void)
+{ HSADC_StreamInterrupt(hsadc_stream[2]); _DMA2IF = 0; }
+#endif
+
+#if (HSADC_STREAM_DMA_COUNT > 3)
+void HSADC_STREAM_ISR _DMA3Interrupt(void)
+{ HSADC_StreamInterrupt(hsadc_stream[3]); _DMA3IF = 0; }
+#endif
+
+#if (HSADC_STREAM_DMA_COUNT > 4)
+void HSADC_STREAM_ISR _DMA4Interrupt(void)
+{ HSADC_StreamInterrupt(hsadc_stream[4]); _DMA4IF = 0; }
+#endif
+
+#if (HSADC_STREAM_DMA_COUNT > 5)
+void HSADC_STREAM_ISR _DMA5Interrupt(void)
+{ HSADC_StreamInterrupt(hsadc_stream[5]); _DMA5IF = 0; }
+#endif
+
+#endif
+
+/* ***********************************************************************************************
+ * DECIMATION PIPELINE
+ * ***********************************************************************************************/
+
+/*!HSADC_DecimatorInitialize()
+ * ************************************************************************************************
+ * Summary:
+ * Allocates and configures a decimation channel of one ADC input
+ * 
+ * Parameters:
+ * HSADC_DECIMATOR_t* dec:  Pointer to the decimation channel
+ * uint16_t input:          Index of the analog input (e.g. 12 for AN12)
+ * uint16_t ratio:          Decimation ratio (power of 2 from 2 to HSADC_DECIMATION_MAX)
+ * HSADC_STREAM_t* stream:  ADC stream of this input used by the software fallback
+ *                          (NULL = samples are provided by HSADC_DecimatorPush(), has to be
+ *                          NULL when HSADC_STREAM_ENABLE is disabled)
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer, invalid ratio or stream given while streaming is disabled)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The first free ADC digital filter is configured for averaging of the given input and ratio.
+ * When all digital filters are in use, the channel falls back to a software CIC stage. The 
+ * result format is identical for both types (average of 'ratio' samples, right aligned).
+ * A decimation channel which is initialized again releases its previous digital filter first. 
+ * Decimation channel objects therefore need to be zero-initialized (e.g. static or global 
+ * objects) before they are initialized the first time.
+ * 
+ * Please note:
+ * ADFLxCON is written directly, as smpsADC_ADFilter_Initialize() of the peripheral library 
+ * does not accept the last digital filter.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSADC_DecimatorInitialize(HSADC_DECIMATOR_t* dec, uint16_t input, 
+            uint16_t ratio, HSADC_STREAM_t* stream)
+{
+    uint16_t i=0, offset=0;
+    
+    if (dec == NULL) return(0);
+    if ((ratio < 2) || (ratio > HSADC_DECIMATION_MAX) || (ratio & (ratio - 1))) return(0);
+    #if (HSADC_STREAM_ENABLE == 0)
+    if (stream != NULL) return(0); // streams are not available, samples need to be pushed
+    #endif
+    
+    HSADC_DecimatorRelease(dec); // Release digital filter of a previous initialization
+    
+    dec->ratio = ratio;
+    dec->shift = 0;
+    while ((1 << dec->shift) < ratio) { dec->shift++; }
+    dec->integrator = 0;
+    dec->count = 0;
+    dec->result = 0;
+    dec->sequence = 0;
+    dec->stream = stream;
+    dec->stream_sequence = 0;
+    #if (HSADC_STREAM_ENABLE == 1)
+    if (stream != NULL) { dec->stream_sequence = stream->sequence; } // start reading at the recent block
+    #endif
+    dec->adflxcon = NULL;
+    dec->adflxdat = NULL;
+    
+    // Try to allocate an ADC digital filter
+    for (i=0; i<HSADC_ADFL_COUNT; i++)
+    {
+        if (hsadc_adfl_used & (1 << i)) continue;
+        
+        offset = i * ((uint16_t)&ADFL1CON - (uint16_t)&ADFL0CON); // Address offset in bytes
+        dec->adflxcon = (volatile uint16_t*)((volatile uint8_t*)&ADFL0CON + offset);
+        dec->adflxdat = (volatile uint16_t*)((volatile uint8_t*)&ADFL0DAT + offset);
+        dec->filter = i;
+        dec->type = HSADC_DECIMATOR_HARDWARE;
+        hsadc_adfl_used |= (1 << i);
+        
+        *dec->adflxcon = 0; // Disable filter before it is reconfigured
+        *dec->adflxcon = (HSADC_ADFLCON_FLEN | HSADC_ADFLCON_MODE_AVERAGE | 
+                          ((dec->shift - 1) << HSADC_ADFLCON_OVRSAM_POS) | 
+                          (input & HSADC_ADFLCON_FLCHSEL_MASK));
+        
+        return((uint16_t)(bool)(*dec->adflxcon & HSADC_ADFLCON_FLEN));
+    }
+    
+    // Fall back to software decimation
+    dec->type = HSADC_DECIMATOR_SOFTWARE;
+    
+    return(1);
+}
+
+/*!HSADC_DecimatorExecute()
+ * ************************************************************************************************
+ * Summary:
+ * Collects the results of a decimation channel
+ * 
+ * Parameters:
+ * HSADC_DECIMATOR_t* dec: Pointer to the decimation channel
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer, channel not initialized or stream block overwritten)
+ * 1 = TRUE
+ * 
+ * Description:
+ * This function is called by a task at a rate at least as high as the decimated rate of the
+ * channel (hardware) or the block rate of its ADC stream (software). Hardware channels 
+ * publish the digital filter result when the ready bit is set. Software channels integrate 
+ * all samples of a new stream block, publishing one result every 'ratio' samples.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSADC_DecimatorExecute(HSADC_DECIMATOR_t* dec)
+{
+    if (dec == NULL) return(0);
+    
+    if (dec->type == HSADC_DECIMATOR_HARDWARE)
+    {
+        if (*dec->adflxcon & HSADC_ADFLCON_RDY)
+        {
+            dec->result = *dec->adflxdat; // reading the result clears the ready bit
+            dec->sequence++;
+        }
+        return(1);
+    }
+    
+    if (dec->type == HSADC_DECIMATOR_SOFTWARE)
+    {
+        #if (HSADC_STREAM_ENABLE == 1)
+        const uint16_t* block;
+        uint16_t i=0;
+        
+        if (dec->stream == NULL) return(1); // fed by HSADC_DecimatorPush()
+        
+        block = HSADC_StreamGetBlock(dec->stream, &dec->stream_sequence);
+        if (block == NULL) return(1);
+        
+        for (i=dec->stream->block_size; i>0; i--)
+        { HSADC_DecimatorPush(dec, *block++); }
+        
+        return((uint16_t)HSADC_StreamRelease(dec->stream, dec->stream_sequence));
+        #else
+        return(1);
+        #endif
+    }
+    
+    return(0);
+}
+
+/*!HSADC_DecimatorRelease()
+ * ************************************************************************************************
+ * Summary:
+ * Releases the digital filter of a decimation channel
+ * 
+ * Parameters:
+ * HSADC_DECIMATOR_t* dec: Pointer to the decimation channel
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The digital filter is disabled and becomes available to other decimation channels. 
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSADC_DecimatorRelease(HSADC_DECIMATOR_t* dec)
+{
+    if (dec == NULL) return(0);
+    
+    if (dec->type == HSADC_DECIMATOR_HARDWARE)
+    {
+        *dec->adflxcon = 0;
+        hsadc_adfl_used &= ~(1 << dec->filter);
+    }
+    dec->type = HSADC_DECIMATOR_NONE;
+    
+    return(1);
+}
+
+// EOF
@@ -0,0 +1,242 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!drv_hspwm.c
+ * ****************************************************************************
+ * File:   drv_hspwm.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file resolves the register addresses of PWM generator handles
+ * used by the inline fast-update functions declared in drv_hspwm.h and 
+ * configures PWM update groups. It also provides an optional benchmark 
+ * comparing the execution time of the fast-update functions with the 
+ * peripheral library function hspwm_set_duty_cycle().
+ * ****************************************************************************/
+
+#include "mcal/mcal.h"
+#include "_root/generic/os_Globals.h"
+
+#if (HSPWM_BENCHMARK_ENABLE == 1)
+volatile HSPWM_BENCHMARK_t hspwm_benchmark;
+#endif
+
+/*!HSPWM_HandleInitialize()
+ * ************************************************************************************************
+ * Summary:
+ * Resolves the register addresses of a PWM generator
+ * 
+ * Parameters:
+ * HSPWM_HANDLE_t* pwm: Pointer to the PWM generator handle
+ * uint16_t instance:   Index of the PWM generator (e.g. 1 for PG1, 2 for PG2, etc.)
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer or invalid instance)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The register address offset between two PWM generators is calculated once and applied to 
+ * the registers of PWM generator #1. The handle can then be used by all fast-update functions 
+ * without any further address calculation.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSPWM_HandleInitialize(HSPWM_HANDLE_t* pwm, uint16_t instance)
+{
+    uint16_t offset=0;
+    
+    if ((pwm == NULL) || (instance < 1) || (instance > HSPWM_PG_COUNT))
+        return(0);
+
+    offset = (instance - 1) * ((uint16_t)&PG2CONL - (uint16_t)&PG1CONL); // Address offset in bytes
+    
+    pwm->pgxconl = (volatile uint16_t*)((volatile uint8_t*)&PG1CONL + offset);
+    pwm->pgxconh = (volatile uint16_t*)((volatile uint8_t*)&PG1CONH + offset);
+    pwm->pgxstat = (volatile uint16_t*)((volatile uint8_t*)&PG1STAT + offset);
+    pwm->pgxphase = (volatile uint16_t*)((volatile uint8_t*)&PG1PHASE + offset);
+    pwm->pgxdc = (volatile uint16_t*)((volatile uint8_t*)&PG1DC + offset);
+    pwm->pgxdca = (volatile uint16_t*)((volatile uint8_t*)&PG1DCA + offset);
+    pwm->pgxper = (volatile uint16_t*)((volatile uint8_t*)&PG1PER + offset);
+    pwm->pgxtriga = (volatile uint16_t*)((volatile uint8_t*)&PG1TRIGA + offset);
+    pwm->pgxtrigb = (volatile uint16_t*)((volatile uint8_t*)&PG1TRIGB + offset);
+    pwm->pgxtrigc = (volatile uint16_t*)((volatile uint8_t*)&PG1TRIGC + offset);
+    pwm->instance = instance;
+    
+    return(1);
+}
+
+/*!HSPWM_GroupInitialize()
+ * ************************************************************************************************
+ * Summary:
+ * Initializes a PWM update group and configures its master generator
+ * 
+ * Parameters:
+ * HSPWM_GROUP_t* group:            Pointer to the PWM update group
+ * const HSPWM_HANDLE_t* master:    Handle of the master generator
+ * HSPWM_UPDATE_MODE_e mode:        Update mode (SOC or immediate)
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer or master generator is enabled)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The master generator is configured to broadcast software update requests to other PWM 
+ * generators (MSTEN = PGCON_MSTEN_BROADCAST) using the given update mode. Slaved generators 
+ * are added by HSPWM_GroupAddSlave().
+ * 
+ * Please Note:
+ * Update groups have to be configured before the PWM generators are enabled. As the update 
+ * request of the master generator is broadcast to all generators in slaved update mode, only 
+ * one update group can be initialized per device.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSPWM_GroupInitialize(HSPWM_GROUP_t* group, const HSPWM_HANDLE_t* master, HSPWM_UPDATE_MODE_e mode)
+{
+    uint16_t i=0;
+    
+    if ((group == NULL) || (master == NULL)) return(0);
+    if (*master->pgxconl & HSPWM_PGCONL_ON) return(0);
+    
+    for (i=0; i<HSPWM_GROUP_SIZE_MAX; i++)
+    { group->pg[i] = NULL; }
+    
+    group->pg[0] = master;
+    group->size = 1;
+    group->mode = mode;
+    
+    *master->pgxconh = ((*master->pgxconh & ~HSPWM_PGCONH_UPDMOD_MASK) | 
+                        HSPWM_PGCONH_MSTEN | ((uint16_t)mode << 8));
+    
+    return((uint16_t)((*master->pgxconh & HSPWM_PGCONH_MSTEN) == HSPWM_PGCONH_MSTEN));
+}
+
+/*!HSPWM_GroupAddSlave()
+ * ************************************************************************************************
+ * Summary:
+ * Adds a slaved generator to a PWM update group
+ * 
+ * Parameters:
+ * HSPWM_GROUP_t* group:            Pointer to the initialized PWM update group
+ * const HSPWM_HANDLE_t* slave:     Handle of the slaved generator
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer, group is full or slaved generator is enabled)
+ * 1 = TRUE
+ * 
+ * Description:
+ * The slaved generator is configured for slaved SOC or slaved immediate update, according to
+ * the update mode of the group, and stops broadcasting its own update requests (MSTEN = 0). 
+ * Its data registers are applied when the master generator of the group requests an update.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSPWM_GroupAddSlave(HSPWM_GROUP_t* group, const HSPWM_HANDLE_t* slave)
+{
+    uint16_t updmod=0;
+    
+    if ((group == NULL) || (slave == NULL)) return(0);
+    if ((group->size == 0) || (group->size >= HSPWM_GROUP_SIZE_MAX)) return(0);
+    if (*slave->pgxconl & HSPWM_PGCONL_ON) return(0);
+    
+    updmod = (((uint16_t)group->mode << 8) | HSPWM_PGCONH_UPDMOD_SLAVED);
+    *slave->pgxconh = ((*slave->pgxconh & ~(HSPWM_PGCONH_UPDMOD_MASK | HSPWM_PGCONH_MSTEN)) | updmod);
+    
+    group->pg[group->size++] = slave;
+    
+    return((uint16_t)((*slave->pgxconh & HSPWM_PGCONH_UPDMOD_MASK) == updmod));
+}
+
+#if (HSPWM_BENCHMARK_ENABLE == 1)
+
+/*!HSPWM_Benchmark()
+ * ************************************************************************************************
+ * Summary:
+ * Measures the instruction cycles of PWM duty cycle updates
+ * 
+ * Parameters:
+ * HSPWM_HANDLE_t* pwm: Pointer to an initialized PWM generator handle
+ * 
+ * Returns:
+ * 0 = FALSE (invalid handle)
+ * 1 = TRUE
+ * 
+ * Description:
+ * Executes HSPWM_BENCHMARK_REPEAT duty cycle updates of the given PWM generator using the 
+ * peripheral library function hspwm_set_duty_cycle() and using the handle based inline 
+ * functions. Execution time is measured by the task manager timer, which is clocked by the 
+ * instruction clock. The duty cycle value present before the benchmark is restored.
+ * 
+ * Please Note:
+ * Interrupts are disabled while the benchmark is running. This function should only be 
+ * called for benchmarking purposes in debug builds, e.g. from a task of the IDLE task queue.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HSPWM_Benchmark(HSPWM_HANDLE_t* pwm)
+{
+    volatile uint16_t t_start=0, t_stop=0, overhead=0;
+    uint16_t dc=0, dca=0, i=0;
+    
+    if ((pwm == NULL) || (pwm->instance < 1) || (pwm->instance > HSPWM_PG_COUNT))
+        return(0);
+    
+    dc = *pwm->pgxdc;
+    dca = *pwm->pgxdca;
+    
+    __builtin_disi(0x3FFF); // Disable interrupts
+    
+    // Timer readout overhead
+    t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+    t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+    overhead = (t_stop - t_start);
+    
+    // Peripheral library function
+    t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+    for (i=0; i<HSPWM_BENCHMARK_REPEAT; i++)
+    { hspwm_set_duty_cycle(pwm->instance, dc, dca); }
+    t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+    if (t_stop < t_start) t_stop += (TASK_MGR_TIMER_PERIOD_REGISTER + 1);
+    hspwm_benchmark.plib_cycles = ((t_stop - t_start - overhead) / HSPWM_BENCHMARK_REPEAT);
+    
+    // Handle based update of duty cycle and duty cycle adjustment
+    t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+    for (i=0; i<HSPWM_BENCHMARK_REPEAT; i++)
+    { 
+        HSPWM_SetDutyCycle(pwm, dc); 
+        HSPWM_SetDutyCycleAdjustment(pwm, dca); 
+    }
+    t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+    if (t_stop < t_start) t_stop += (TASK_MGR_TIMER_PERIOD_REGISTER + 1);
+    hspwm_benchmark.handle_cycles = ((t_stop - t_start - overhead) / HSPWM_BENCHMARK_REPEAT);
+    
+    // Handle based update of duty cycle only
+    t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+    for (i=0; i<HSPWM_BENCHMARK_REPEAT; i++)
+    { HSPWM_SetDutyCycle(pwm, dc); }
+    t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+    if (t_stop < t_start) t_stop += (TASK_MGR_TIMER_PERIOD_REGISTER + 1);
+    hspwm_benchmark.handle_dc_cycles = ((t_stop - t_start - overhead) / HSPWM_BENCHMARK_REPEAT);
+    
+    __builtin_disi(0x0000); // Enable interrupts
+    
+    return(1);
+}
+
+#endif
+
+// EOF
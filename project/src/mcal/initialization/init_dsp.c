@@ -26,24 +26,16 @@ volatile uint16_t DSP_initialize(void) {
     // if conflicts between different DSP configurations cannot be 
     // resolved differently within the firmware.
     
-    CORCONbits.ACCSAT = CORCON_ACCSAT_931;  // Accumulator Saturation Mode Selection: 9.31 saturation (super saturation)
-    CORCONbits.IF = CORCON_IF_FRACTIONAL;   // Integer or Fractional Multiplier Mode Selection: Fractional mode is enabled for DSP multiply
-    CORCONbits.RND = CORCON_RND_UNBIASED;   // Rounding Mode Selection: Unbiased (convergent) rounding is enabled
-    CORCONbits.SATA = CORCON_SATA_ON;       // ACCA Saturation Enable: Accumulator A saturation is enabled
-    CORCONbits.SATB = CORCON_SATB_ON;       // ACCB Saturation Enable: Accumulator B saturation is enabled
-    CORCONbits.SATDW = CORCON_SATDW_ON;     // Data Space Write from DSP Engine Saturation Enable: Data Space write saturation is enabled
-    CORCONbits.US = CORCON_US_SIGNED;       // DSP Multiply Unsigned/Signed Control: DSP engine multiplies are signed
-    CORCONbits.VAR = CORCON_VAR_FIXED;      // Variable Exception Processing Latency Control: Fixed exception processing is enabled
-
-//    CORCONbits.DL = CORCON_DL_0;              // (read only)
-//    CORCONbits.EDT = CORCON_EDT_RUN;          // control bit => do not set during configuration
-//    CORCONbits.SFA = CORCON_SFA_ACTIVE;       // (read only)
-//    CORCONbits.IPL3 = CORCON_IPL3_STAT_LT7;   // (read only)
+    volatile uint16_t fres=0;
+    volatile CORCON_t dsp_cfg;
+    
+    dsp_cfg.value = DSP_CORECON_CFG; // Settings declared in devcfg_dsp.h
+    fres = smpsDSP_Initialize(dsp_cfg); // Write and verify CORCON
     
     Nop();
     Nop();
     Nop();
     
-    return(1);
+    return(fres);
 }
 
@@ -47,14 +47,24 @@
  * desired CPU frequency. 
  * 
  * Please Note:
+ * PLL settings are resolved at compile time by the clock tree solver (devcfg_clocktree.h) from
+ * the CPU speed MAIN_CLOCK_FCY declared in devcfg_oscillator.h.
  * 
  * ***********************************************************************************************/
 
 volatile uint16_t MainOscillator_Initialize(void) {
     
     volatile uint16_t fres = 1;
+    volatile OSC_CONFIG_t osc;
 
-    fres &= smpsOSC_FRC_DefaultInitialize(MAIN_CLOCK_SPEED);
+    osc.osc_type = OSCCON_xOSC_FRCPLL;
+    osc.N1 = (CLKDIV_PLLPRE_e)CLOCK_PLL_N1;
+    osc.M = (PLLFBD_PLLFBDIV_e)CLOCK_PLL_M;
+    osc.N2 = (PLLDIV_POSTxDIV_e)CLOCK_PLL_N2;
+    osc.N3 = (PLLDIV_POSTxDIV_e)CLOCK_PLL_N3;
+    osc.VCODIV = (PLLDIV_VCODIV_e)((CLOCK_REG_PLLDIV >> 8) & 0x0003);
+    
+    fres &= smpsOSC_Initialize(osc);
 
     return(fres);
 }
@@ -77,15 +87,67 @@ volatile uint16_t MainOscillator_Initialize(void) {
  * peripheral modules such as PWM, ADC or PDM DAC.
  * 
  * Please Note:
+ * PLL settings are resolved at compile time by the clock tree solver (devcfg_clocktree.h) from
+ * the auxiliary clock frequency AUX_CLOCK_AFPLLO declared in devcfg_oscillator.h.
  * 
  * ***********************************************************************************************/
 
 volatile uint16_t AuxOscillator_Initialize(void) {
 
     volatile uint16_t fres = 1;
+    volatile AUXOSC_CONFIG_t aux_clock_config;
+    
+    aux_clock_config.FRCSEL = PLLDIV_ACLKCON_FRCSEL_FRC;
+    aux_clock_config.N1 = (ACLKCON_APLLPRE_e)CLOCK_APLL_N1;
+    aux_clock_config.M = (APLLFBD_APLLFBDIV_e)CLOCK_APLL_M;
+    aux_clock_config.N2 = (APLLDIV_POSTxDIV_e)CLOCK_APLL_N2;
+    aux_clock_config.N3 = (APLLDIV_POSTxDIV_e)CLOCK_APLL_N3;
+    aux_clock_config.AVCODIV = (APLLDIV_AVCODIV_e)((CLOCK_REG_APLLDIV1 >> 8) & 0x0003);
+    aux_clock_config.APLLEN = ACLKCON_APLLEN_ENABLED;
     
-    fres &= smpsOSC_AUXCLK_DefaultInitialize(AUX_CLOCK_SPEED);
+    fres &= smpsOSC_AUXCLK_Initialize(aux_clock_config);
    
     return(fres);
 }
 
+/*!SystemFrequencies_Initialize()
+ * ************************************************************************************************
+ * Summary:
+ * Loads the frequencies of all clock domains into the global data structure system_frequencies
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * 0 = FALSE
+ * 1 = TRUE
+ * 
+ * Description:
+ * Replaces the runtime calculation of smpsOSC_GetFrequencies() by the constant frequencies
+ * determined by the clock tree solver at compile time. As no oscillator register is read back,
+ * no divisions and no floating point math are executed during startup.
+ * 
+ * Please Note:
+ * The contents of system_frequencies is only valid after MainOscillator_Initialize() and 
+ * AuxOscillator_Initialize() have been executed successfully.
+ * 
+ * ***********************************************************************************************/
+
+volatile uint16_t SystemFrequencies_Initialize(void) {
+
+    system_frequencies.frc = CLOCK_FRC_FREQUENCY;
+    system_frequencies.fpri = 0;
+    system_frequencies.fclk = CLOCK_FPLLI;
+    system_frequencies.fvco = CLOCK_FVCODIV;
+    system_frequencies.fpllo = CLOCK_FPLLO;
+    system_frequencies.fosc = CLOCK_FOSC;
+    system_frequencies.fp = CLOCK_FP;
+    system_frequencies.fcy = CLOCK_FCY;
+    system_frequencies.tp = (float)(1.0 / (float)CLOCK_FP);
+    system_frequencies.tcy = CLOCK_TCY;
+    system_frequencies.afpllo = CLOCK_AFPLLO;
+    system_frequencies.afvco = CLOCK_AFVCODIV;
+    
+    return(1);
+}
+
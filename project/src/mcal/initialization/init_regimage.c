@@ -0,0 +1,249 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!init_regimage.c
+ * ****************************************************************************
+ * File:   init_regimage.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file applies and verifies constant peripheral register images.
+ * While the default peripheral library functions write registers one by one,
+ * read back and mask each of them for verification and resolve every 
+ * peripheral instance through computed pointer offsets, a register image is
+ * loaded by a plain copy loop and verified by a single CRC-16 over the 
+ * masked readback of all registers (see USE_REGISTER_IMAGES).
+ * 
+ * Register images are generated by tools/register_image_generator.py from
+ * src/apl/config/UserRegisterImages.txt.
+ * ****************************************************************************/
+
+#include "mcal/mcal.h"
+#include "_root/generic/os_Globals.h"
+
+#define REGISTER_IMAGE_CRC_POLYNOM  0x1021  // CRC-16-CCITT generator polynomial x^16 + x^12 + x^5 + 1
+#define REGISTER_IMAGE_CRC_SEED     0xFFFF  // CRC-16-CCITT initial value
+
+/* private function prototypes */
+inline volatile uint16_t RegisterImage_GetChecksum(const REGISTER_IMAGE_t* image);
+
+/*!RegisterImage_Apply()
+ * ************************************************************************************************
+ * Summary:
+ * Loads all registers of a register image and verifies the result
+ * 
+ * Parameters:
+ * const REGISTER_IMAGE_t* image: Pointer to the register image
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer or readback verification failed)
+ * 1 = TRUE
+ * 
+ * Description:
+ * All blocks of the register image are copied into their registers in the given order. 
+ * No register is read back before the entire image has been written. The image is then 
+ * verified by RegisterImage_Verify().
+ * 
+ * Please Note:
+ * Peripheral modules need to be powered (PMD) before their registers can be written. 
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t RegisterImage_Apply(const REGISTER_IMAGE_t* image)
+{
+    const REGISTER_IMAGE_BLOCK_t* block;
+    const uint16_t* value;
+    volatile uint16_t* sfr;
+    uint16_t i=0, n=0;
+    
+    if (image == NULL) return(0);
+    
+    block = image->block;
+    for (i=image->size; i>0; i--)
+    {
+        sfr = block->sfr;
+        value = block->value;
+        for (n=block->count; n>0; n--)
+        { *sfr++ = *value++; }
+        block++;
+    }
+    
+    return(RegisterImage_Verify(image));
+}
+
+/*!RegisterImage_Verify()
+ * ************************************************************************************************
+ * Summary:
+ * Verifies the recent register contents against a register image
+ * 
+ * Parameters:
+ * const REGISTER_IMAGE_t* image: Pointer to the register image
+ * 
+ * Returns:
+ * 0 = FALSE (NULL pointer or checksum mismatch)
+ * 1 = TRUE
+ * 
+ * Description:
+ * Calculates the CRC-16 of the masked readback of all registers covered by the register 
+ * image and compares it with the checksum calculated by the image generator. 
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t RegisterImage_Verify(const REGISTER_IMAGE_t* image)
+{
+    if (image == NULL) return(0);
+    
+    return((uint16_t)(RegisterImage_GetChecksum(image) == image->crc));
+}
+
+/*!RegisterImage_ApplyAll()
+ * ************************************************************************************************
+ * Summary:
+ * Applies all register images listed in register_image_list[]
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * 0 = FALSE (at least one image failed)
+ * 1 = TRUE
+ * 
+ * Description:
+ * This function is called by DEVICE_Initialize() when USE_REGISTER_IMAGES is enabled. 
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t RegisterImage_ApplyAll(void)
+{
+    volatile uint16_t fres = 1;
+    uint16_t i=0;
+    
+    for (i=0; i<register_image_list_size; i++)
+    { fres &= RegisterImage_Apply(register_image_list[i]); }
+    
+    return(fres);
+}
+
+/*!RegisterImage_VerifyAll()
+ * ************************************************************************************************
+ * Summary:
+ * Verifies all register images listed in register_image_list[]
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * 0 = FALSE (at least one image does not match)
+ * 1 = TRUE
+ * 
+ * Description:
+ * This function allows the application to check all peripheral configurations at once without
+ * changing any register (see RegisterImage_RestoreAll()).
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t RegisterImage_VerifyAll(void)
+{
+    volatile uint16_t fres = 1;
+    uint16_t i=0;
+    
+    for (i=0; i<register_image_list_size; i++)
+    { fres &= RegisterImage_Verify(register_image_list[i]); }
+    
+    return(fres);
+}
+
+/*!RegisterImage_RestoreAll()
+ * ************************************************************************************************
+ * Summary:
+ * Verifies all register images listed in register_image_list[] and re-applies changed images
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * 0 = FALSE (at least one changed image could not be restored)
+ * 1 = TRUE
+ * 
+ * Description:
+ * This function is used by OS_WarmRestart() to validate peripheral configurations before
+ * the scheduler is restarted without re-initializing peripherals. Each image is verified 
+ * individually and only images which do not match are written again. Peripherals with intact 
+ * configurations are not touched, which keeps them running undisturbed across the restart.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t RegisterImage_RestoreAll(void)
+{
+    volatile uint16_t fres = 1;
+    uint16_t i=0;
+    
+    for (i=0; i<register_image_list_size; i++)
+    {
+        if (!RegisterImage_Verify(register_image_list[i]))
+        { fres &= RegisterImage_Apply(register_image_list[i]); }
+    }
+    
+    return(fres);
+}
+
+/*!RegisterImage_GetChecksum()
+ * ************************************************************************************************
+ * Summary:
+ * Calculates the checksum of the masked readback of all registers of a register image
+ * 
+ * Parameters:
+ * const REGISTER_IMAGE_t* image: Pointer to the register image
+ * 
+ * Returns:
+ * 16-bit CRC
+ * 
+ * Description:
+ * Calculates the CRC-16-CCITT (polynomial 0x1021, initial value 0xFFFF, MSB first) over all 
+ * 16-bit registers in the order they are listed in the image. Unlike a rotate-and-XOR checksum,
+ * the CRC detects all double bit errors and compensating changes of the same bit in two 
+ * registers. The image generator calculates the expected value the same way over the register 
+ * values of the image.
+ * 
+ * ***********************************************************************************************/
+inline volatile uint16_t RegisterImage_GetChecksum(const REGISTER_IMAGE_t* image)
+{
+    const REGISTER_IMAGE_BLOCK_t* block;
+    const uint16_t* mask;
+    volatile uint16_t* sfr;
+    uint16_t i=0, n=0, b=0, crc=REGISTER_IMAGE_CRC_SEED;
+    
+    block = image->block;
+    for (i=image->size; i>0; i--)
+    {
+        sfr = block->sfr;
+        mask = block->mask;
+        for (n=block->count; n>0; n--)
+        {
+            crc ^= (*sfr++ & *mask++);
+            for (b=16; b>0; b--)
+            {
+                if (crc & 0x8000) { crc = ((crc << 1) ^ REGISTER_IMAGE_CRC_POLYNOM); }
+                else { crc <<= 1; }
+            }
+        }
+        block++;
+    }
+    
+    return(crc);
+}
+
+// EOF
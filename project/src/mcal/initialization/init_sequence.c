@@ -0,0 +1,339 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!init_sequence.c
+ * ****************************************************************************
+ * File:   init_sequence.c
+ * Author: M91406
+ *
+ * Description:
+ * This source file provides non-blocking initialization sequences of 
+ * peripherals which need to wait for hardware ready bits. Instead of polling
+ * ready bits in blocking while loops, as done by the default peripheral 
+ * library functions, each sequence is started once and then advanced by one 
+ * step per scheduler tick by exec_InitSequences(), which is executed as last 
+ * task of the FIRMWARE_INIT task queue. The task manager repeats this task 
+ * until all sequences have been completed before entering the startup 
+ * sequence (see USE_NONBLOCKING_PERIPHERAL_INIT).
+ * 
+ * The auxiliary PLL sequence is started by CLOCK_Initialize(). ADC and PWM 
+ * sequences are started by exec_InitSequences() on its first execution, after 
+ * all preceding tasks of the FIRMWARE_INIT task queue have configured these 
+ * peripherals. The ADC cores and PWM generators covered by the sequences are 
+ * selected by INIT_SEQUENCE_ADC_CORES and INIT_SEQUENCE_PWM_GENERATORS.
+ * 
+ * Supported sequences:
+ *   - Auxiliary PLL lock (APLLCK)
+ *   - ADC band gap reference ready, core power-up and warm-up (CxRDY/SHRRDY)
+ *   - High resolution PWM ready (HRRDY) and PWM generator enable
+ * 
+ * ADC and PWM sequences wait for the auxiliary PLL to be locked, if its 
+ * sequence has been started. 
+ * 
+ * All sequences run after a CPU reset (cold start) only. Warm restarts (see 
+ * OS_WarmRestart()) skip CLOCK_Initialize() and the FIRMWARE_INIT task queue, 
+ * keeping the peripherals configured and running.
+ * ****************************************************************************/
+
+#include "mcal/mcal.h"
+#include "_root/generic/os_Globals.h"
+
+// Initialization sequence state objects
+volatile INIT_SEQUENCE_t init_seq_auxpll;
+volatile INIT_SEQUENCE_t init_seq_adc;
+volatile INIT_SEQUENCE_t init_seq_hrpwm;
+
+/* private function prototypes */
+inline volatile uint16_t InitSequenceStart(volatile INIT_SEQUENCE_t* seq, volatile uint16_t mask);
+inline volatile uint16_t InitSequenceExecute(volatile INIT_SEQUENCE_t* seq, volatile uint16_t (*step_function)(void));
+inline volatile uint16_t InitSequenceCheckAuxClock(volatile INIT_SEQUENCE_t* seq);
+volatile uint16_t AuxOscillator_InitStep(void);
+volatile uint16_t ADC_PowerUpStep(void);
+volatile uint16_t HRPWM_EnableStep(void);
+
+/*!InitSequenceStart()
+ * ************************************************************************************************
+ * Summary:
+ * Resets an initialization sequence and sets it active
+ * ***********************************************************************************************/
+inline volatile uint16_t InitSequenceStart(volatile INIT_SEQUENCE_t* seq, volatile uint16_t mask)
+{
+    seq->step = 0;
+    seq->mask = mask;
+    seq->timeout = INIT_SEQUENCE_TIMEOUT;
+    seq->state = INIT_SEQ_STATE_BUSY;
+    
+    return(1);
+}
+
+/*!InitSequenceExecute()
+ * ************************************************************************************************
+ * Summary:
+ * Executes one step of an active initialization sequence and monitors its timeout
+ * 
+ * Returns:
+ * 0 = sequence has timed out or reported an error
+ * 1 = sequence is inactive, busy or completed
+ * ***********************************************************************************************/
+inline volatile uint16_t InitSequenceExecute(volatile INIT_SEQUENCE_t* seq, volatile uint16_t (*step_function)(void))
+{
+    if (seq->state == INIT_SEQ_STATE_BUSY)
+    {
+        step_function();
+        
+        if (seq->state == INIT_SEQ_STATE_BUSY)
+        {
+            if (seq->timeout > 0) { seq->timeout--; }
+            else { seq->state = INIT_SEQ_STATE_TIMEOUT; }
+        }
+    }
+    
+    return((uint16_t)(seq->state <= INIT_SEQ_STATE_READY));
+}
+
+/*!InitSequenceCheckAuxClock()
+ * ************************************************************************************************
+ * Summary:
+ * Checks if the auxiliary clock required by ADC and PWM is available
+ * 
+ * Returns:
+ * 0 = auxiliary PLL is not locked yet or has failed (failure is passed on to the given sequence)
+ * 1 = auxiliary PLL is locked or not controlled by an initialization sequence
+ * ***********************************************************************************************/
+inline volatile uint16_t InitSequenceCheckAuxClock(volatile INIT_SEQUENCE_t* seq)
+{
+    if (init_seq_auxpll.state == INIT_SEQ_STATE_BUSY) 
+    { return(0); }
+    
+    if (init_seq_auxpll.state > INIT_SEQ_STATE_READY) 
+    { 
+        seq->state = INIT_SEQ_STATE_ERROR; 
+        return(0); 
+    }
+    
+    return(1);
+}
+
+/*!AuxOscillator_InitStart()
+ * ************************************************************************************************
+ * Summary:
+ * Configures and enables the auxiliary PLL without waiting for lock
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * 0 = FALSE
+ * 1 = TRUE
+ * 
+ * Description:
+ * Applies the auxiliary PLL configuration and starts the sequence monitoring the PLL lock bit.
+ * This function replaces AuxOscillator_Initialize() when non-blocking peripheral initialization
+ * is enabled. It is called by CLOCK_Initialize() after a CPU reset (cold start) only. Warm 
+ * restarts skip CLOCK_Initialize() and the FIRMWARE_INIT task queue and therefore do not run 
+ * any initialization sequence. The ADC and PWM sequences are reset here to be started by 
+ * exec_InitSequences() in the FIRMWARE_INIT task queue of the same cold start.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t AuxOscillator_InitStart(void)
+{
+    volatile uint16_t fres = 1;
+    
+    fres &= AuxOscillator_Initialize();
+    
+    // Cold start: ADC and PWM sequences are started by exec_InitSequences() in the FIRMWARE_INIT queue
+    init_seq_adc.state = INIT_SEQ_STATE_OFF;
+    init_seq_hrpwm.state = INIT_SEQ_STATE_OFF;
+    
+    if (fres) { fres &= InitSequenceStart(&init_seq_auxpll, 0); }
+    else { init_seq_auxpll.state = INIT_SEQ_STATE_ERROR; }
+    
+    return(fres);
+}
+
+volatile uint16_t AuxOscillator_InitStep(void)
+{
+    if (ACLKCON1bits.APLLCK) 
+    { init_seq_auxpll.state = INIT_SEQ_STATE_READY; }
+    
+    return(1);
+}
+
+/*!ADC_PowerUpStart()
+ * ************************************************************************************************
+ * Summary:
+ * Starts the non-blocking power-up sequence of the given ADC cores
+ * 
+ * Parameters:
+ * uint16_t core_mask: Bit mask of ADC core indices to be powered up (bit #n = ADC core #n, 
+ *                     index ADC_SHARED_CORE_INDEX = shared ADC core)
+ * 
+ * Returns:
+ * 0 = FALSE
+ * 1 = TRUE
+ * 
+ * Description:
+ * Unlike smpsADC_Core_PowerUp(), which powers up ADC cores one after the other waiting for each 
+ * core to be ready, this sequence powers up all selected cores at the same time and enables
+ * them once all ready bits have been set. The ADC module needs to be configured and enabled 
+ * (ADON = 1) before the sequence is started.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t ADC_PowerUpStart(volatile uint16_t core_mask)
+{
+    volatile uint16_t i=0, reg_mask=0;
+    
+    // Translate ADC core indices into ADCON5L power and ADCON3H enable bit positions
+    for (i=0; i<ADC_CORE_COUNT; i++)
+    {
+        if (core_mask & (0x0001 << i))
+        {
+            if (i == ADC_SHARED_CORE_INDEX) { reg_mask |= REG_ADCON5L_SHRPWR_ON; }
+            else { reg_mask |= (0x0001 << i); }
+        }
+    }
+    
+    return(InitSequenceStart(&init_seq_adc, (reg_mask & REG_ADCON5L_VALID_DATA_WRITE_MSK)));
+}
+
+volatile uint16_t ADC_PowerUpStep(void)
+{
+    switch (init_seq_adc.step)
+    {
+        case 0: // Wait for auxiliary clock and band gap reference, then power up all cores at once
+            if (!InitSequenceCheckAuxClock(&init_seq_adc)) break;
+            if (_REFERR) { init_seq_adc.state = INIT_SEQ_STATE_ERROR; break; }
+            if (!_REFRDY) break;
+            
+            ADCON5L |= init_seq_adc.mask;
+            init_seq_adc.step++;
+            break;
+            
+        case 1: // Wait for ready bits of all powered cores, then enable cores
+            if (((ADCON5L >> 8) & init_seq_adc.mask) != init_seq_adc.mask) break;
+            
+            ADCON3H |= init_seq_adc.mask;
+            init_seq_adc.state = INIT_SEQ_STATE_READY;
+            break;
+            
+        default:
+            init_seq_adc.state = INIT_SEQ_STATE_ERROR;
+            break;
+    }
+    
+    return(1);
+}
+
+/*!HRPWM_EnableStart()
+ * ************************************************************************************************
+ * Summary:
+ * Starts the non-blocking enable sequence of the given PWM generators
+ * 
+ * Parameters:
+ * uint16_t pg_mask: Bit mask of PWM generators to be enabled (bit #0 = PG1, bit #1 = PG2, etc.)
+ * 
+ * Returns:
+ * 0 = FALSE
+ * 1 = TRUE
+ * 
+ * Description:
+ * Unlike smpsHSPWM_Enable(), which waits for the high resolution ready bit in a blocking loop 
+ * for every PWM generator, this sequence polls the ready bit once per step and enables all 
+ * selected PWM generators as soon as the high resolution mode is ready.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t HRPWM_EnableStart(volatile uint16_t pg_mask)
+{
+    return(InitSequenceStart(&init_seq_hrpwm, pg_mask));
+}
+
+volatile uint16_t HRPWM_EnableStep(void)
+{
+    volatile uint16_t fres=1, i=0;
+    
+    if (!InitSequenceCheckAuxClock(&init_seq_hrpwm)) return(1);
+    if (PCLKCONbits.HRERR) { init_seq_hrpwm.state = INIT_SEQ_STATE_ERROR; return(1); }
+    if (!PCLKCONbits.HRRDY) return(1);
+    
+    for (i=0; i<HSPWM_PG_COUNT; i++)
+    {
+        if (init_seq_hrpwm.mask & (0x0001 << i))
+        { fres &= smpsHSPWM_Enable((i+1), false); }
+    }
+    
+    if (fres) { init_seq_hrpwm.state = INIT_SEQ_STATE_READY; }
+    else { init_seq_hrpwm.state = INIT_SEQ_STATE_ERROR; }
+    
+    return(fres);
+}
+
+/*!exec_InitSequences()
+ * ************************************************************************************************
+ * Summary:
+ * Advances all active peripheral initialization sequences by one step
+ * 
+ * Parameters:
+ * (none)
+ * 
+ * Returns:
+ * 0 = at least one sequence has timed out or reported an error
+ * 1 = all sequences are completed or still busy
+ * 
+ * Description:
+ * This task is executed as last task of the FIRMWARE_INIT task queue. On its first execution,
+ * the ADC power-up sequence of INIT_SEQUENCE_ADC_CORES and the PWM enable sequence of 
+ * INIT_SEQUENCE_PWM_GENERATORS are started. Sequences with an empty selection are not started
+ * and remain inactive. As long as any sequence is busy, the flag bit init_pending of the task 
+ * manager status is set, which makes the task manager repeat this task instead of entering the 
+ * startup sequence. 
+ * If any sequence fails, the system is put into standby mode, preventing the startup of the 
+ * power supply with peripherals which are not ready.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t exec_InitSequences(void)
+{
+    volatile uint16_t fres = 1;
+    
+    // Start ADC and PWM sequences once all peripherals have been configured
+    if ((init_seq_adc.state == INIT_SEQ_STATE_OFF) && (INIT_SEQUENCE_ADC_CORES != 0))
+    { fres &= ADC_PowerUpStart(INIT_SEQUENCE_ADC_CORES); }
+    if ((init_seq_hrpwm.state == INIT_SEQ_STATE_OFF) && (INIT_SEQUENCE_PWM_GENERATORS != 0))
+    { fres &= HRPWM_EnableStart(INIT_SEQUENCE_PWM_GENERATORS); }
+    
+    fres &= InitSequenceExecute(&init_seq_auxpll, &AuxOscillator_InitStep);
+    fres &= InitSequenceExecute(&init_seq_adc, &ADC_PowerUpStep);
+    fres &= InitSequenceExecute(&init_seq_hrpwm, &HRPWM_EnableStep);
+    
+    task_mgr.status.bits.init_pending = (bool)(
+        (init_seq_auxpll.state == INIT_SEQ_STATE_BUSY) ||
+        (init_seq_adc.state == INIT_SEQ_STATE_BUSY) ||
+        (init_seq_hrpwm.state == INIT_SEQ_STATE_BUSY) );
+    
+    if (!fres) 
+    {
+        task_mgr.status.bits.init_pending = false;
+        task_mgr.op_mode.value = OP_MODE_STANDBY;
+    }
+    
+    return(fres);
+}
+
+// EOF
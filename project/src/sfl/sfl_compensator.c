@@ -0,0 +1,480 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ * ***************************************************************************/
+/*!sfl_compensator.c
+ * ****************************************************************************
+ * File:   sfl_compensator.c
+ * Author: M91406
+ *
+ * Description:
+ * Initialization routines and bit-exact C reference models of the fixed-point
+ * compensator library. The optimized update routines are implemented in 
+ * sfl_compensator_asm.s.
+ * ****************************************************************************/
+
+#include "sfl/sfl.h"
+#include "_root/generic/os_Globals.h"
+
+#define SFL_ACC_MAX     ((int64_t)0x7FFFFFFFFFLL)   // 40-bit accumulator maximum (9.31 super saturation)
+#define SFL_ACC_MIN     (-(int64_t)0x8000000000LL)  // 40-bit accumulator minimum (9.31 super saturation)
+#define SFL_INTEG_MAX   ((int64_t)0x7FFFFFFFL)      // PID integrator maximum (1.31)
+#define SFL_INTEG_MIN   (-(int64_t)0x80000000L)     // PID integrator minimum (1.31)
+
+/* ***********************************************************************************************
+ * DSP ENGINE EMULATION
+ * ***********************************************************************************************/
+
+// Saturates a value to the 40-bit accumulator range (SATA = 1, ACCSAT = 1)
+static inline int64_t SFL_AccSaturate(int64_t acc)
+{
+    if (acc > SFL_ACC_MAX) return(SFL_ACC_MAX);
+    if (acc < SFL_ACC_MIN) return(SFL_ACC_MIN);
+    return(acc);
+}
+
+// Fractional signed multiplication (MPY/MAC with IF = 0, US = 0)
+static inline int64_t SFL_Multiply(int16_t a, int16_t b)
+{
+    return((int64_t)((int32_t)a * (int32_t)b) * 2);
+}
+
+// Accumulator shift (SFTAC, positive = right-shift, negative = left-shift)
+static inline int64_t SFL_AccShift(int64_t acc, int16_t shift)
+{
+    if (shift >= 0) return(acc >> shift);
+    return(SFL_AccSaturate(acc * ((int64_t)1 << (-shift))));
+}
+
+// Rounded and saturated accumulator store (SAC.R with RND = 0, SATDW = 1)
+static inline int16_t SFL_AccStore(int64_t acc)
+{
+    int64_t result = (acc >> 16);
+    uint16_t low = (uint16_t)(acc & 0xFFFF);
+    
+    // Convergent rounding: round half to even
+    if ((low > 0x8000) || ((low == 0x8000) && (result & 0x0001)))
+        result++;
+    
+    if (result > INT16_MAX) return(INT16_MAX);
+    if (result < INT16_MIN) return(INT16_MIN);
+    return((int16_t)result);
+}
+
+// Output normalization and clamping shared by all compensator types
+static inline int16_t SFL_Output(int64_t acc, int16_t post_scaler, int16_t post_shift, 
+            int16_t min_clamp, int16_t max_clamp, volatile uint16_t* status)
+{
+    int16_t y;
+    uint16_t flags = 0;
+    
+    acc = SFL_Multiply(SFL_AccStore(acc), post_scaler);
+    acc = SFL_AccShift(acc, -post_shift);
+    y = SFL_AccStore(acc);
+    
+    if (y > max_clamp) { y = max_clamp; flags |= SFL_CMP_STATUS_UPPER_LIMIT; }
+    if (y < min_clamp) { y = min_clamp; flags |= SFL_CMP_STATUS_LOWER_LIMIT; }
+    *status = flags;
+    
+    return(y);
+}
+
+// Verifies the DSP engine configuration required by the update routines
+static inline bool SFL_DspConfigValid(void)
+{
+    return((bool)((smpsDSP_GetConfig().value & SFL_CMP_CORCON_MSK) == SFL_CMP_CORCON_CFG));
+}
+
+/*!SFL_CNPNZ_Initialize()
+ * ************************************************************************************************
+ * Summary:
+ * Initializes an n-pole/n-zero compensator
+ * 
+ * Parameters:
+ * SFL_CNPNZ_t* cmp:        Pointer to the compensator data structure
+ * uint16_t order:          Number of poles/zeros (1...SFL_CNPNZ_ORDER_MAX)
+ * const int16_t* coeff:    Coefficient array B0...Bn, A1...An (SFL_CNPNZ_COEFF_SPACE)
+ * int16_t* hist:           History array of SFL_CNPNZ_TAPS(order) elements (SFL_CNPNZ_HIST_SPACE)
+ * int16_t post_scaler:     Output normalization factor (Q15)
+ * int16_t post_shift:      Output normalization bit-shift (-16...15)
+ * int16_t min_clamp:       Minimum control output
+ * int16_t max_clamp:       Maximum control output
+ * 
+ * Returns:
+ * 0 = FALSE (invalid parameters or DSP engine not configured by DSP_initialize())
+ * 1 = TRUE
+ * 
+ * Description:
+ * The compensator history is cleared. The coefficient array is referenced, not copied, 
+ * allowing coefficients to be changed at runtime (e.g. adaptive gain or coefficient sets per 
+ * operating mode).
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t SFL_CNPNZ_Initialize(volatile SFL_CNPNZ_t* cmp, uint16_t order, 
+            const int16_t* coeff, int16_t* hist, int16_t post_scaler, int16_t post_shift, 
+            int16_t min_clamp, int16_t max_clamp)
+{
+    if ((cmp == NULL) || (coeff == NULL) || (hist == NULL)) return(0);
+    if ((order == 0) || (order > SFL_CNPNZ_ORDER_MAX)) return(0);
+    if ((post_shift < -16) || (post_shift > 15) || (min_clamp > max_clamp)) return(0);
+    
+    cmp->ptr_coeff = coeff;
+    cmp->ptr_hist = hist;
+    cmp->order = order;
+    cmp->post_scaler = post_scaler;
+    cmp->post_shift = post_shift;
+    cmp->min_clamp = min_clamp;
+    cmp->max_clamp = max_clamp;
+    
+    SFL_CNPNZ_Reset(cmp, 0);
+    
+    return((uint16_t)SFL_DspConfigValid());
+}
+
+/*!SFL_CNPNZ_Reset()
+ * ************************************************************************************************
+ * Summary:
+ * Resets the history of an n-pole/n-zero compensator
+ * 
+ * Parameters:
+ * SFL_CNPNZ_t* cmp:    Pointer to the compensator data structure
+ * int16_t output:      Initial control output (e.g. duty cycle at the end of a soft-start ramp)
+ * 
+ * Returns:
+ * 1 = TRUE
+ * 
+ * Description:
+ * The error history is cleared and the control history is preloaded with the given output, 
+ * allowing a bumpless transfer from open loop to closed loop operation.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t SFL_CNPNZ_Reset(volatile SFL_CNPNZ_t* cmp, int16_t output)
+{
+    uint16_t i=0;
+    
+    for (i=0; i<SFL_CNPNZ_TAPS(cmp->order); i++)
+    { cmp->ptr_hist[i] = ((i > cmp->order) ? output : 0); }
+    
+    cmp->status = 0;
+    
+    return(1);
+}
+
+/*!SFL_CNPNZ_UpdateRef()
+ * ************************************************************************************************
+ * Summary:
+ * C reference model of SFL_CNPNZ_Update()
+ * 
+ * Parameters:
+ * SFL_CNPNZ_t* cmp:    Pointer to the compensator data structure
+ * int16_t error:       Control error e[n] (Q15)
+ * 
+ * Returns:
+ * Clamped control output u[n]
+ * 
+ * Description:
+ * Executes the same sequence of DSP operations as the assembly routine, emulating the 40-bit
+ * accumulator, fractional multiplication, convergent rounding and data write saturation. 
+ * Results and compensator history are bit-exact to SFL_CNPNZ_Update().
+ * 
+ * ***********************************************************************************************/
+int16_t SFL_CNPNZ_UpdateRef(volatile SFL_CNPNZ_t* cmp, int16_t error)
+{
+    const int16_t* coeff = cmp->ptr_coeff;
+    int16_t* hist = cmp->ptr_hist;
+    uint16_t taps = SFL_CNPNZ_TAPS(cmp->order);
+    uint16_t i=0;
+    int64_t acc=0;
+    int16_t y=0;
+    
+    hist[0] = error;
+    
+    for (i=0; i<taps; i++)
+    { acc = SFL_AccSaturate(acc + SFL_Multiply(coeff[i], hist[i])); }
+    
+    y = SFL_Output(acc, cmp->post_scaler, cmp->post_shift, 
+            cmp->min_clamp, cmp->max_clamp, &cmp->status);
+    
+    for (i=(taps-1); i>0; i--)
+    { hist[i] = hist[i-1]; }
+    
+    hist[cmp->order + 1] = y;
+    
+    return(y);
+}
+
+/*!SFL_PID_Initialize()
+ * ************************************************************************************************
+ * Summary:
+ * Initializes a PID controller
+ * 
+ * Parameters:
+ * SFL_PID_t* pid:          Pointer to the PID controller data structure
+ * int16_t kp:              Proportional gain (Q15)
+ * int16_t ki:              Integral gain (Q15)
+ * int16_t kd:              Derivative gain (Q15)
+ * int16_t post_scaler:     Output normalization factor (Q15)
+ * int16_t post_shift:      Output normalization bit-shift (-16...15)
+ * int16_t min_clamp:       Minimum control output
+ * int16_t max_clamp:       Maximum control output
+ * 
+ * Returns:
+ * 0 = FALSE (invalid parameters or DSP engine not configured by DSP_initialize())
+ * 1 = TRUE
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t SFL_PID_Initialize(volatile SFL_PID_t* pid, int16_t kp, int16_t ki, 
+            int16_t kd, int16_t post_scaler, int16_t post_shift, int16_t min_clamp, int16_t max_clamp)
+{
+    if (pid == NULL) return(0);
+    if ((post_shift < -16) || (post_shift > 15) || (min_clamp > max_clamp)) return(0);
+    
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+    pid->post_scaler = post_scaler;
+    pid->post_shift = post_shift;
+    pid->min_clamp = min_clamp;
+    pid->max_clamp = max_clamp;
+    
+    SFL_PID_Reset(pid);
+    
+    return((uint16_t)SFL_DspConfigValid());
+}
+
+/*!SFL_PID_Reset()
+ * ************************************************************************************************
+ * Summary:
+ * Clears integrator and error history of a PID controller
+ * 
+ * Parameters:
+ * SFL_PID_t* pid: Pointer to the PID controller data structure
+ * 
+ * Returns:
+ * 1 = TRUE
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t SFL_PID_Reset(volatile SFL_PID_t* pid)
+{
+    pid->error_prev = 0;
+    pid->integrator_l = 0;
+    pid->integrator_h = 0;
+    pid->status = 0;
+    
+    return(1);
+}
+
+/*!SFL_PID_UpdateRef()
+ * ************************************************************************************************
+ * Summary:
+ * C reference model of SFL_PID_Update()
+ * 
+ * Parameters:
+ * SFL_PID_t* pid:  Pointer to the PID controller data structure
+ * int16_t error:   Control error e[n] (Q15)
+ * 
+ * Returns:
+ * Clamped control output u[n]
+ * 
+ * Description:
+ * Executes the same sequence of DSP operations as the assembly routine. Results, integrator
+ * and error history are bit-exact to SFL_PID_Update().
+ * 
+ * ***********************************************************************************************/
+int16_t SFL_PID_UpdateRef(volatile SFL_PID_t* pid, int16_t error)
+{
+    int64_t integ_old=0, integ_new=0, acc=0;
+    int16_t y=0;
+    
+    integ_old = (int64_t)(int32_t)(((uint32_t)(uint16_t)pid->integrator_h << 16) | (uint32_t)pid->integrator_l);
+    
+    // Integrator update with 1.31 saturation
+    integ_new = integ_old + SFL_Multiply(pid->ki, error);
+    if (integ_new > SFL_INTEG_MAX) integ_new = SFL_INTEG_MAX;
+    else if (integ_new < SFL_INTEG_MIN) integ_new = SFL_INTEG_MIN;
+    
+    // Proportional and derivative terms
+    acc = SFL_AccSaturate(integ_new + SFL_Multiply(pid->kp, error));
+    acc = SFL_AccSaturate(acc + SFL_Multiply(pid->kd, error));
+    acc = SFL_AccSaturate(acc - SFL_Multiply(pid->kd, pid->error_prev));
+    pid->error_prev = error;
+    
+    y = SFL_Output(acc, pid->post_scaler, pid->post_shift, 
+            pid->min_clamp, pid->max_clamp, &pid->status);
+    
+    // Conditional integration (anti-windup)
+    if (pid->status & SFL_CMP_STATUS_UPPER_LIMIT)
+    { if (integ_new > integ_old) return(y); }
+    else if (pid->status & SFL_CMP_STATUS_LOWER_LIMIT)
+    { if (integ_new < integ_old) return(y); }
+    
+    pid->integrator_l = (uint16_t)((uint32_t)integ_new & 0xFFFF);
+    pid->integrator_h = (int16_t)((uint32_t)integ_new >> 16);
+    
+    return(y);
+}
+
+#if (SFL_CMP_BENCHMARK_ENABLE == 1)
+
+#define SFL_BENCHMARK_LFSR_SEED     0xACE1  // Start value of the pseudo-random test sequence
+#define SFL_BENCHMARK_LFSR_TAPS     0xB400  // Feedback taps of the 16-bit Galois LFSR (x^16 + x^14 + x^13 + x^11 + 1)
+
+volatile SFL_CMP_BENCHMARK_t sfl_cmp_benchmark;
+
+// Test compensators (type II 2P2Z, type III 3P3Z, normalization gain of 4)
+int16_t SFL_CNPNZ_COEFF_SPACE sfl_bm_coeff_2p2z[SFL_CNPNZ_TAPS(2)] = { 0x2C6F, (int16_t)0xD2A1, 0x0B5E, 0x3C00, 0x0400 };
+int16_t SFL_CNPNZ_COEFF_SPACE sfl_bm_coeff_3p3z[SFL_CNPNZ_TAPS(3)] = { 0x3A14, (int16_t)0xC9E2, (int16_t)0xD1B3, 0x2F0A, 0x2A3D, 0x1C8F, (int16_t)0xFA34 };
+int16_t SFL_CNPNZ_HIST_SPACE sfl_bm_hist_2p2z[2][SFL_CNPNZ_TAPS(2)];
+int16_t SFL_CNPNZ_HIST_SPACE sfl_bm_hist_3p3z[2][SFL_CNPNZ_TAPS(3)];
+
+/*!SFL_BenchmarkElapsed()
+ * ************************************************************************************************
+ * Summary:
+ * Returns the number of timer ticks between two time stamps and updates a maximum value
+ * ***********************************************************************************************/
+static inline void SFL_BenchmarkElapsed(uint16_t t_start, uint16_t t_stop, uint16_t overhead, volatile uint16_t* cycles_max)
+{
+    if (t_stop < t_start) t_stop += (TASK_MGR_TIMER_PERIOD_REGISTER + 1);
+    t_stop = (t_stop - t_start - overhead);
+    if (t_stop > *cycles_max) *cycles_max = t_stop;
+}
+
+/*!SFL_CompensatorBenchmark()
+ * ************************************************************************************************
+ * Summary:
+ * Measures the instruction cycles of the compensator update routines and verifies them against
+ * the C reference models
+ * 
+ * Returns:
+ * 0 = FALSE (DSP engine not configured or results of optimized routines and reference model differ)
+ * 1 = TRUE
+ * 
+ * Description:
+ * A 2P2Z compensator, a 3P3Z compensator and a PID controller are each instantiated twice with 
+ * identical settings. One instance is updated by the optimized routine, the other one by the 
+ * C reference model. A pseudo-random error sequence with varying amplitude drives the outputs 
+ * into both clamping limits. Each call is timed by the task manager timer, which is clocked 
+ * by the instruction clock. The results are stored in sfl_cmp_benchmark.
+ * 
+ * Please Note:
+ * Interrupts are disabled during each timed call. This function should only be called for 
+ * benchmarking purposes in debug builds, e.g. from a task of the IDLE task queue.
+ * 
+ * ***********************************************************************************************/
+volatile uint16_t SFL_CompensatorBenchmark(void)
+{
+    volatile uint16_t fres=1, t_start=0, t_stop=0, overhead=0;
+    volatile SFL_CNPNZ_t cmp[2], cmp_ref[2];
+    volatile SFL_PID_t pid, pid_ref;
+    uint16_t lfsr = SFL_BENCHMARK_LFSR_SEED, i=0;
+    int16_t error=0, y=0, y_ref=0;
+    
+    fres &= SFL_CNPNZ_Initialize(&cmp[0], 2, sfl_bm_coeff_2p2z, sfl_bm_hist_2p2z[0], 0x7FFF, 2, 0x0100, 0x7000);
+    fres &= SFL_CNPNZ_Initialize(&cmp_ref[0], 2, sfl_bm_coeff_2p2z, sfl_bm_hist_2p2z[1], 0x7FFF, 2, 0x0100, 0x7000);
+    fres &= SFL_CNPNZ_Initialize(&cmp[1], 3, sfl_bm_coeff_3p3z, sfl_bm_hist_3p3z[0], 0x6000, 3, (int16_t)0xC000, 0x4000);
+    fres &= SFL_CNPNZ_Initialize(&cmp_ref[1], 3, sfl_bm_coeff_3p3z, sfl_bm_hist_3p3z[1], 0x6000, 3, (int16_t)0xC000, 0x4000);
+    fres &= SFL_PID_Initialize(&pid, 0x2000, 0x0200, 0x1000, 0x7FFF, 2, 0x0000, 0x6000);
+    fres &= SFL_PID_Initialize(&pid_ref, 0x2000, 0x0200, 0x1000, 0x7FFF, 2, 0x0000, 0x6000);
+    if (!fres) return(0);
+    
+    sfl_cmp_benchmark.cycles_2p2z = 0;
+    sfl_cmp_benchmark.cycles_3p3z = 0;
+    sfl_cmp_benchmark.cycles_pid = 0;
+    sfl_cmp_benchmark.cycles_2p2z_ref = 0;
+    sfl_cmp_benchmark.cycles_3p3z_ref = 0;
+    sfl_cmp_benchmark.cycles_pid_ref = 0;
+    sfl_cmp_benchmark.samples = SFL_CMP_BENCHMARK_SAMPLES;
+    sfl_cmp_benchmark.mismatches = 0;
+    
+    // Timer readout overhead
+    __builtin_disi(0x3FFF); // Disable interrupts
+    t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+    t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+    __builtin_disi(0x0000); // Enable interrupts
+    overhead = (t_stop - t_start);
+    
+    for (i=0; i<SFL_CMP_BENCHMARK_SAMPLES; i++)
+    {
+        // Pseudo-random error with an amplitude decreasing from full scale to 1/8 in four steps
+        lfsr = (lfsr >> 1) ^ ((lfsr & 0x0001) ? SFL_BENCHMARK_LFSR_TAPS : 0);
+        error = ((int16_t)lfsr >> (i & 0x0003));
+        
+        // 2P2Z compensator
+        __builtin_disi(0x3FFF);
+        t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+        y = SFL_CNPNZ_Update(&cmp[0], error);
+        t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+        __builtin_disi(0x0000);
+        SFL_BenchmarkElapsed(t_start, t_stop, overhead, &sfl_cmp_benchmark.cycles_2p2z);
+        
+        __builtin_disi(0x3FFF);
+        t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+        y_ref = SFL_CNPNZ_UpdateRef(&cmp_ref[0], error);
+        t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+        __builtin_disi(0x0000);
+        SFL_BenchmarkElapsed(t_start, t_stop, overhead, &sfl_cmp_benchmark.cycles_2p2z_ref);
+        
+        if ((y != y_ref) || (cmp[0].status != cmp_ref[0].status))
+            sfl_cmp_benchmark.mismatches++;
+        
+        // 3P3Z compensator
+        __builtin_disi(0x3FFF);
+        t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+        y = SFL_CNPNZ_Update(&cmp[1], error);
+        t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+        __builtin_disi(0x0000);
+        SFL_BenchmarkElapsed(t_start, t_stop, overhead, &sfl_cmp_benchmark.cycles_3p3z);
+        
+        __builtin_disi(0x3FFF);
+        t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+        y_ref = SFL_CNPNZ_UpdateRef(&cmp_ref[1], error);
+        t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+        __builtin_disi(0x0000);
+        SFL_BenchmarkElapsed(t_start, t_stop, overhead, &sfl_cmp_benchmark.cycles_3p3z_ref);
+        
+        if ((y != y_ref) || (cmp[1].status != cmp_ref[1].status))
+            sfl_cmp_benchmark.mismatches++;
+        
+        // PID controller
+        __builtin_disi(0x3FFF);
+        t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+        y = SFL_PID_Update(&pid, error);
+        t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+        __builtin_disi(0x0000);
+        SFL_BenchmarkElapsed(t_start, t_stop, overhead, &sfl_cmp_benchmark.cycles_pid);
+        
+        __builtin_disi(0x3FFF);
+        t_start = TASK_MGR_TIMER_COUNTER_REGISTER;
+        y_ref = SFL_PID_UpdateRef(&pid_ref, error);
+        t_stop = TASK_MGR_TIMER_COUNTER_REGISTER;
+        __builtin_disi(0x0000);
+        SFL_BenchmarkElapsed(t_start, t_stop, overhead, &sfl_cmp_benchmark.cycles_pid_ref);
+        
+        if ((y != y_ref) || (pid.status != pid_ref.status) || 
+            (pid.integrator_h != pid_ref.integrator_h) || (pid.integrator_l != pid_ref.integrator_l))
+            sfl_cmp_benchmark.mismatches++;
+    }
+    
+    return((uint16_t)(sfl_cmp_benchmark.mismatches == 0));
+}
+
+#endif
+
+// EOF
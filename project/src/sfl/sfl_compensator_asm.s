@@ -0,0 +1,247 @@
+;LICENSE ********************************************************************
+; Microchip Technology Inc. and its subsidiaries.  You may use this software 
+; and any derivatives exclusively with Microchip products. 
+; 
+; THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+; EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+; WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+; PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+; WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+;
+; IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+; INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+; WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+; BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+; FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+; IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+; ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+;
+; MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+; TERMS. 
+; **************************************************************************
+;sfl_compensator_asm.s
+; ****************************************************************************
+; File:   sfl_compensator_asm.s
+; Author: M91406
+;
+; Description:
+; Optimized update routines of the fixed-point compensator library 
+; (see sfl_compensator.h). Both routines follow the XC16 calling convention
+; (W0...W7 scratch, W8...W14 preserved) and expect the DSP engine configured
+; as declared by SFL_CMP_CORCON_CFG. ACCA is overwritten and not preserved, it
+; needs to be saved by the calling interrupt service routine if used elsewhere
+; (see sfl_compensator.h). Results are bit-exact to the C reference models
+; SFL_CNPNZ_UpdateRef() and SFL_PID_UpdateRef() in sfl_compensator.c.
+; ****************************************************************************
+
+    .include "xc.inc"
+
+; SFL_CNPNZ_t data structure offsets
+    .equ    CNPNZ_PTR_COEFF,    0
+    .equ    CNPNZ_PTR_HIST,     2
+    .equ    CNPNZ_ORDER,        4
+    .equ    CNPNZ_POST_SCALER,  6
+    .equ    CNPNZ_POST_SHIFT,   8
+    .equ    CNPNZ_MIN_CLAMP,    10
+    .equ    CNPNZ_MAX_CLAMP,    12
+    .equ    CNPNZ_STATUS,       14
+
+; SFL_PID_t data structure offsets
+    .equ    PID_KP,             0
+    .equ    PID_KI,             2
+    .equ    PID_KD,             4
+    .equ    PID_POST_SCALER,    6
+    .equ    PID_POST_SHIFT,     8
+    .equ    PID_MIN_CLAMP,      10
+    .equ    PID_MAX_CLAMP,      12
+    .equ    PID_STATUS,         14
+    .equ    PID_ERROR_PREV,     16
+    .equ    PID_INTEG_L,        18
+    .equ    PID_INTEG_H,        20
+
+    .section .text
+
+;*SFL_CNPNZ_Update()
+; ************************************************************************************************
+; Summary:
+; Executes one update of an n-pole/n-zero compensator
+;
+; Parameters:
+; W0: SFL_CNPNZ_t* cmp  Pointer to the compensator data structure
+; W1: int16_t error     Control error e[n] (Q15)
+;
+; Returns:
+; W0: int16_t           Clamped control output u[n]
+;
+; Description:
+; The error is written to the head of the history array and all 2n+1 products are accumulated
+; in ACCA by a single MAC loop with dual operand prefetch (coefficients via W8 from X-space, 
+; history via W10 from Y-space). The result is normalized, clamped and fed back into the 
+; control history while the history is shifted by one sample.
+; ACCA is overwritten and not preserved. The calling interrupt service routine needs to save
+; ACCA if the interrupted code or any interrupt of lower priority uses it.
+; ************************************************************************************************
+
+    .global _SFL_CNPNZ_Update
+_SFL_CNPNZ_Update:
+    push.d  w8                          ; save prefetch registers W8/W9
+    push.d  w10                         ; save prefetch registers W10/W11
+
+    mov     [w0 + CNPNZ_PTR_COEFF], w8  ; w8 = coefficient array (X-space)
+    mov     [w0 + CNPNZ_PTR_HIST], w10  ; w10 = history array (Y-space)
+    mov     [w0 + CNPNZ_ORDER], w6      ; w6 = order n
+    mov     w10, w7                     ; w7 = history array base address
+    mov     w1, [w10]                   ; history[0] = e[n]
+    sl      w6, #1, w3                  ; w3 = 2n
+    dec     w3, w3                      ; w3 = 2n - 1 (number of taps - 2)
+
+    ; y[n] = sum(coeff[k] * history[k]), k = 0...2n
+    clr     a, [w8]+=2, w4, [w10]+=2, w5
+    repeat  w3
+    mac     w4*w5, a, [w8]+=2, w4, [w10]+=2, w5
+    mac     w4*w5, a
+
+    ; Output normalization
+    sac.r   a, #0, w4                   ; w4 = y[n] (rounded, saturated)
+    mov     [w0 + CNPNZ_POST_SCALER], w5
+    mpy     w4*w5, a                    ; ACCA = y[n] * post_scaler
+    mov     [w0 + CNPNZ_POST_SHIFT], w2
+    neg     w2, w2
+    sftac   a, w2                       ; ACCA = ACCA << post_shift
+    sac.r   a, #0, w4                   ; w4 = u[n] (rounded, saturated)
+
+    ; Output clamping
+    clr     w5                          ; w5 = status
+    mov     [w0 + CNPNZ_MAX_CLAMP], w2
+    cp      w4, w2
+    bra     le, 1f
+    mov     w2, w4                      ; u[n] = max_clamp
+    bset    w5, #0                      ; set SFL_CMP_STATUS_UPPER_LIMIT
+1:  mov     [w0 + CNPNZ_MIN_CLAMP], w2
+    cp      w4, w2
+    bra     ge, 2f
+    mov     w2, w4                      ; u[n] = min_clamp
+    bset    w5, #1                      ; set SFL_CMP_STATUS_LOWER_LIMIT
+2:  mov     w5, [w0 + CNPNZ_STATUS]
+
+    ; History shift: history[k] = history[k-1], k = 2n...1
+    sub     w10, #2, w2                 ; w2 = &history[2n]
+    sub     w10, #4, w1                 ; w1 = &history[2n-1]
+    repeat  w3
+    mov     [w1--], [w2--]
+
+    ; history[n+1] = u[n]
+    sl      w6, #1, w6                  ; w6 = 2n
+    add     w7, w6, w7                  ; w7 = &history[n]
+    mov     w4, [w7 + 2]
+
+    mov     w4, w0                      ; return u[n]
+    pop.d   w10
+    pop.d   w8
+    return
+
+;*SFL_PID_Update()
+; ************************************************************************************************
+; Summary:
+; Executes one update of a PID controller
+;
+; Parameters:
+; W0: SFL_PID_t* pid    Pointer to the PID controller data structure
+; W1: int16_t error     Control error e[n] (Q15)
+;
+; Returns:
+; W0: int16_t           Clamped control output u[n]
+;
+; Description:
+; The 32-bit integrator is loaded into ACCA, the integral term is added and the result is
+; saturated to 1.31 format. The proportional and derivative terms are accumulated on top of
+; the new integrator value before the output is normalized and clamped. The new integrator
+; value is only stored when the output is not clamped or when it drives the output back into
+; the control range (conditional integration anti-windup).
+; ACCA is overwritten and not preserved. The calling interrupt service routine needs to save
+; ACCA if the interrupted code or any interrupt of lower priority uses it.
+; ************************************************************************************************
+
+    .global _SFL_PID_Update
+_SFL_PID_Update:
+    ; ACCA = i[n-1]
+    mov     [w0 + PID_INTEG_L], w6
+    mov     [w0 + PID_INTEG_H], w7
+    mov     w6, ACCAL
+    mov     w7, ACCAH
+    asr     w7, #15, w2
+    mov     w2, ACCAU
+
+    ; i[n] = sat(i[n-1] + Ki * e[n])
+    mov     [w0 + PID_KI], w4
+    mov     w1, w5                      ; w5 = e[n]
+    mac     w4*w5, a
+    mov     ACCAL, w6                   ; w7:w6 = i[n]
+    mov     ACCAH, w7
+    asr     w7, #15, w3                 ; w3 = expected guard bits
+    mov     ACCAU, w2
+    se      w2, w2                      ; w2 = actual guard bits
+    cp      w2, w3
+    bra     z, 2f                       ; no overflow of 1.31 range
+    setm    w6                          ; saturate to maximum
+    mov     #0x7FFF, w7
+    cp0     w2
+    bra     nn, 1f
+    clr     w6                          ; saturate to minimum
+    mov     #0x8000, w7
+1:  mov     w6, ACCAL
+    mov     w7, ACCAH
+    asr     w7, #15, w2
+    mov     w2, ACCAU
+
+    ; y[n] = i[n] + Kp * e[n] + Kd * (e[n] - e[n-1])
+2:  mov     [w0 + PID_KP], w4
+    mac     w4*w5, a
+    mov     [w0 + PID_KD], w4
+    mac     w4*w5, a
+    mov     [w0 + PID_ERROR_PREV], w5
+    msc     w4*w5, a
+    mov     w1, [w0 + PID_ERROR_PREV]   ; e[n-1] = e[n]
+
+    ; Output normalization
+    sac.r   a, #0, w4                   ; w4 = y[n] (rounded, saturated)
+    mov     [w0 + PID_POST_SCALER], w5
+    mpy     w4*w5, a                    ; ACCA = y[n] * post_scaler
+    mov     [w0 + PID_POST_SHIFT], w2
+    neg     w2, w2
+    sftac   a, w2                       ; ACCA = ACCA << post_shift
+    sac.r   a, #0, w4                   ; w4 = u[n] (rounded, saturated)
+
+    ; Output clamping
+    clr     w5                          ; w5 = status
+    mov     [w0 + PID_MAX_CLAMP], w2
+    cp      w4, w2
+    bra     le, 3f
+    mov     w2, w4                      ; u[n] = max_clamp
+    bset    w5, #0                      ; set SFL_CMP_STATUS_UPPER_LIMIT
+3:  mov     [w0 + PID_MIN_CLAMP], w2
+    cp      w4, w2
+    bra     ge, 4f
+    mov     w2, w4                      ; u[n] = min_clamp
+    bset    w5, #1                      ; set SFL_CMP_STATUS_LOWER_LIMIT
+4:  mov     w5, [w0 + PID_STATUS]
+    mov     w4, w1                      ; w1 = u[n]
+
+    ; Conditional integration (anti-windup)
+    mov     [w0 + PID_INTEG_L], w2
+    mov     [w0 + PID_INTEG_H], w3
+    sub     w6, w2, w2                  ; SR = flags of i[n] - i[n-1]
+    subb    w7, w3, w3
+    btsc    w5, #0                      ; upper limit: skip update if integrator increases
+    bra     gt, 5f
+    btsc    w5, #1                      ; lower limit: skip update if integrator decreases
+    bra     lt, 5f
+    mov     w6, [w0 + PID_INTEG_L]
+    mov     w7, [w0 + PID_INTEG_H]
+
+5:  mov     w1, w0                      ; return u[n]
+    return
+
+    .end
+
+; EOF
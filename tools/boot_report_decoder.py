@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+File:   boot_report_decoder.py
+
+Summary:
+Host decoder of the persistent boot report (boot_report) recorded by
+project/src/_root/generic/os_BootProfiler.c
+
+Description:
+Reads a RAM dump of the boot_report data structure and prints the duration of
+every startup phase of the most recent boot, the cumulative startup time and
+the phase in which the previous boot has been interrupted (if any). With
+--csv the phase table is exported as comma-separated values for further
+processing (e.g. tracking startup latency across firmware builds).
+
+Supported input formats:
+    - binary file (raw little-endian memory image starting at &boot_report)
+    - text file of 16-bit hexadecimal words (e.g. copied from the MPLAB X
+      memory window), optionally preceded by an address column ending in ':'
+
+Usage:
+    boot_report_decoder.py dump.bin [--csv boot.csv]
+
+Please note:
+Phase names and restart profiles refer to BOOT_PHASE_e (os_BootProfiler.h)
+and CPU_RESTART_PROFILE_e (fdrv_FaultHandler.h).
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+from fault_log_decoder import read_dump
+
+BOOT_REPORT_SIGNATURE = 0xB007
+BOOT_PHASE_NONE = 0xFFFF
+
+HEADER_FORMAT = '<6HI'      # signature, signature_inv, boot_count, phase_index, aborted_phase, restart_profile, total_duration
+PHASE_FORMAT = '<IIH'       # cycles, duration, clock
+
+PHASES = (
+    'RESET_CAUSE', 'DEVICE_RESET', 'CLOCK_SWITCH', 'CLOCK_AUX', 'DEVICE_INIT',
+    'OS_INIT', 'BOOT_QUEUE', 'FIRMWARE_INIT', 'STARTUP_SEQUENCE', 'FIRST_RUN',
+)
+
+RESTART_PROFILES = {0: 'COLD', 1: 'WARM', 2: 'DEGRADED', 3: 'SAFE_STOP'}
+
+CLOCKS = {
+    0b000: 'FRC', 0b001: 'FRCPLL', 0b010: 'PRI', 0b011: 'PRIPLL',
+    0b101: 'LPRC', 0b110: 'BFRC', 0b111: 'FRCDIVN',
+}
+
+
+def decode(data):
+    hdr_len = struct.calcsize(HEADER_FORMAT)
+    ph_len = struct.calcsize(PHASE_FORMAT)
+    total = hdr_len + len(PHASES) * ph_len
+    if len(data) < total:
+        raise ValueError('dump holds %d bytes, %d bytes expected' % (len(data), total))
+
+    sig, sig_inv, boot_count, phase_index, aborted, profile, total_us = struct.unpack_from(HEADER_FORMAT, data, 0)
+    if sig != BOOT_REPORT_SIGNATURE or sig_inv != (~BOOT_REPORT_SIGNATURE & 0xFFFF):
+        raise ValueError('invalid boot report signature 0x%04X/0x%04X' % (sig, sig_inv))
+
+    phases = [struct.unpack_from(PHASE_FORMAT, data, hdr_len + n * ph_len) for n in range(len(PHASES))]
+    return {
+        'boot_count': boot_count, 'phase_index': min(phase_index, len(PHASES)),
+        'aborted_phase': aborted, 'restart_profile': profile, 'total_duration': total_us,
+        'phases': phases,
+    }
+
+
+def phase_name(index):
+    return PHASES[index] if index < len(PHASES) else '0x%04X' % index
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the persistent boot report')
+    parser.add_argument('dump', help='memory dump of boot_report (binary or hex words)')
+    parser.add_argument('--csv', help='export phase durations into this CSV file')
+    args = parser.parse_args()
+
+    try:
+        rep = decode(read_dump(args.dump))
+    except (ValueError, struct.error) as e:
+        sys.stderr.write('%s: %s\n' % (args.dump, e))
+        return 1
+
+    rows = []
+    elapsed = 0
+    for n in range(rep['phase_index']):
+        cycles, duration, clock = rep['phases'][n]
+        elapsed += duration
+        rows.append((phase_name(n), CLOCKS.get(clock, '0x%X' % clock), cycles, duration, elapsed))
+
+    print('boot #%d, restart profile: %s' % (
+        rep['boot_count'], RESTART_PROFILES.get(rep['restart_profile'], '0x%04X' % rep['restart_profile'])))
+    if rep['aborted_phase'] != BOOT_PHASE_NONE:
+        print('previous boot interrupted in phase %s' % phase_name(rep['aborted_phase']))
+    print('')
+    print('%-18s %-8s %12s %12s %12s' % ('phase', 'clock', 'cycles', 'duration', 'elapsed'))
+    for name, clock, cycles, duration, total in rows:
+        print('%-18s %-8s %12d %9d us %9d us' % (name, clock, cycles, duration, total))
+    if rep['phase_index'] < len(PHASES):
+        print('%-18s (not completed)' % phase_name(rep['phase_index']))
+    print('')
+    print('total startup time: %.3f ms' % (rep['total_duration'] / 1000.0))
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.writer(f)
+            writer.writerow(('phase', 'clock', 'cycles', 'duration_us', 'elapsed_us'))
+            writer.writerows(rows)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
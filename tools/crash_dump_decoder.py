@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""
+File:   crash_dump_decoder.py
+
+Summary:
+Host decoder of the trap crash record (crashlog) captured by
+project/src/_root/generic/fdrv_TrapHandler.c
+
+Description:
+Reads a RAM dump of the crashlog data structure, verifies signature and
+checksum and prints the CPU state at trap entry. When the ELF file of the
+firmware build is given, the program counter of the exception frame and all
+stack words which look like return addresses are resolved to the nearest
+function symbol. If xc16-addr2line is found on the search path (or given by
+--addr2line), source file and line number are added.
+
+Supported input formats:
+    - binary file (raw little-endian memory image starting at &crashlog)
+    - text file of 16-bit hexadecimal words (e.g. copied from the MPLAB X
+      memory window), optionally preceded by an address column ending in ':'
+
+Usage:
+    crash_dump_decoder.py dump.bin [--elf RTOS_5G2.X.production.elf] [--depth 16]
+
+Please note:
+--depth must match TRAP_CRASH_STACK_DEPTH in task_manager_config.h. The PC
+stored in the exception frame usually points to the instruction following
+the one which caused the trap. Stack words are listed most recent first; a
+CALL pushes PC<15:0> followed by PC<22:16>, hence return addresses appear as
+pairs of (PC<22:16>, PC<15:0>) in this list.
+"""
+
+import argparse
+import shutil
+import struct
+import subprocess
+import sys
+
+from fault_log_decoder import read_dump, OP_MODES
+
+TRAP_CRASH_RECORD_SIGNATURE = 0xDEAD
+
+HEADER_FORMAT = '<16H9H'    # w_reg[16], sr, corcon, pc_low, pc_high, signature, trap_id, task_id, op_mode, stack_count
+
+TRAP_IDS = {
+    0x0001: 'OSCILLATOR_FAIL', 0x0002: 'ADDRESS_ERROR', 0x0004: 'STACK_ERROR',
+    0x0008: 'MATH_ERROR', 0x0010: 'DMA_ERROR', 0x0020: 'SOFT_TRAP_ERROR',
+    0x0040: 'HARD_TRAP_ERROR', 0x0080: 'RESERVED_TRAP_ERROR',
+    0x0100: 'ALT_OSCILLATOR_FAIL', 0x0200: 'ALT_ADDRESS_ERROR', 0x0400: 'ALT_STACK_ERROR',
+    0x0800: 'ALT_MATH_ERROR', 0x1000: 'ALT_DMA_ERROR', 0x2000: 'ALT_SOFT_TRAP_ERROR',
+    0x4000: 'ALT_HARD_TRAP_ERROR',
+}
+
+SR_BITS = ('C', 'Z', 'OV', 'N', 'RA', 'IPL0', 'IPL1', 'IPL2', 'DC', 'DA', 'SAB', 'OAB', 'SB', 'SA', 'OB', 'OA')
+
+ELF_SHT_SYMTAB = 2
+ELF_STT_FUNC = 2
+ELF_SHN_UNDEF = 0
+ELF_SHN_LORESERVE = 0xFF00
+
+
+def decode(data, depth):
+    hdr_len = struct.calcsize(HEADER_FORMAT)
+    total = hdr_len + 2 * depth + 2
+    if len(data) < total:
+        raise ValueError('dump holds %d bytes, %d bytes expected' % (len(data), total))
+
+    words = struct.unpack_from('<%dH' % (total // 2), data, 0)
+    fields = words[:hdr_len // 2]
+    if fields[20] != TRAP_CRASH_RECORD_SIGNATURE:
+        raise ValueError('invalid crash record signature 0x%04X' % fields[20])
+    if (~sum(words[:-1]) & 0xFFFF) != words[-1]:
+        raise ValueError('crash record checksum mismatch')
+
+    stack_count = min(fields[24], depth)
+    return {
+        'w_reg': fields[0:16], 'sr': fields[16], 'corcon': fields[17],
+        'pc': ((fields[19] & 0x7F) << 16) | fields[18],
+        'srl': fields[19] >> 8, 'ipl3': (fields[19] >> 7) & 1,
+        'trap_id': fields[21], 'task_id': fields[22], 'op_mode': fields[23],
+        'stack': words[hdr_len // 2:hdr_len // 2 + stack_count],
+    }
+
+
+def load_symbols(filename):
+    """Returns a sorted list of (address, size, name) of all defined code symbols"""
+    with open(filename, 'rb') as f:
+        elf = f.read()
+    if elf[:4] != b'\x7fELF' or elf[4] != 1 or elf[5] != 1:
+        raise ValueError('%s is not a little-endian 32-bit ELF file' % filename)
+
+    e_shoff, = struct.unpack_from('<I', elf, 0x20)
+    e_shentsize, e_shnum = struct.unpack_from('<HH', elf, 0x2E)
+    sections = [struct.unpack_from('<10I', elf, e_shoff + i * e_shentsize) for i in range(e_shnum)]
+
+    symbols = []
+    for sh in sections:
+        if sh[1] != ELF_SHT_SYMTAB:
+            continue
+        strtab = sections[sh[6]]
+        for pos in range(sh[4], sh[4] + sh[5], sh[9]):
+            st_name, st_value, st_size, st_info, _, st_shndx = struct.unpack_from('<IIIBBH', elf, pos)
+            if (st_info & 0x0F) != ELF_STT_FUNC:
+                continue
+            if st_shndx == ELF_SHN_UNDEF or st_shndx >= ELF_SHN_LORESERVE:
+                continue
+            name_pos = strtab[4] + st_name
+            name = elf[name_pos:elf.index(b'\0', name_pos)].decode('ascii', 'replace')
+            symbols.append((st_value, st_size, name))
+    return sorted(symbols)
+
+
+def symbolize(symbols, address):
+    best = None
+    for value, size, name in symbols:
+        if value > address:
+            break
+        best = (value, size, name)
+    if best is None:
+        return None
+    value, size, name = best
+    if size and address >= value + size:
+        return None
+    return '%s+0x%X' % (name, address - value)
+
+
+def addr2line(tool, elf, address):
+    if tool is None:
+        return ''
+    try:
+        out = subprocess.run([tool, '-e', elf, '0x%X' % address], capture_output=True, text=True, timeout=10)
+    except (OSError, subprocess.SubprocessError):
+        return ''
+    line = out.stdout.strip()
+    return '' if (not line or line.startswith('??')) else '  (%s)' % line
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode and symbolize the trap crash record')
+    parser.add_argument('dump', help='memory dump of crashlog (binary or hex words)')
+    parser.add_argument('--elf', help='ELF file of the firmware build used to symbolize addresses')
+    parser.add_argument('--depth', type=int, default=16, help='TRAP_CRASH_STACK_DEPTH (default 16)')
+    parser.add_argument('--addr2line', default=shutil.which('xc16-addr2line'),
+                        help='addr2line tool adding source lines (default: xc16-addr2line if found)')
+    args = parser.parse_args()
+
+    try:
+        rec = decode(read_dump(args.dump), args.depth)
+        symbols = load_symbols(args.elf) if args.elf else []
+    except (ValueError, OSError, struct.error) as e:
+        sys.stderr.write('%s\n' % e)
+        return 1
+
+    def where(address):
+        if not symbols:
+            return ''
+        sym = symbolize(symbols, address)
+        return '' if sym is None else '  <%s>%s' % (sym, addr2line(args.addr2line, args.elf, address))
+
+    print('trap:     %s (0x%04X)' % (TRAP_IDS.get(rec['trap_id'], 'UNKNOWN'), rec['trap_id']))
+    print('task:     %d' % rec['task_id'])
+    print('op-mode:  %s' % OP_MODES.get(rec['op_mode'], '0x%02X' % rec['op_mode']))
+    print('')
+    print('PC:       0x%06X%s' % (rec['pc'], where(rec['pc'])))
+    print('SRL:      0x%02X (IPL3=%d) of interrupted code' % (rec['srl'], rec['ipl3']))
+    print('SR:       0x%04X [%s]' % (rec['sr'], ' '.join(b for n, b in enumerate(SR_BITS) if rec['sr'] & (1 << n))))
+    print('CORCON:   0x%04X' % rec['corcon'])
+    print('')
+    for n in range(0, 16, 4):
+        print('   '.join('W%-2d = 0x%04X' % (n + i, rec['w_reg'][n + i]) for i in range(4)))
+    print('')
+    print('stack (most recent first, SP before trap = 0x%04X):' % ((rec['w_reg'][15] - 4) & 0xFFFF))
+    stack = rec['stack']
+    for n, word in enumerate(stack):
+        note = ''
+        # return address candidate: PC<22:16> followed by an even PC<15:0>
+        if symbols and n + 1 < len(stack) and word <= 0x7F and not (stack[n + 1] & 1):
+            address = (word << 16) | stack[n + 1]
+            if symbolize(symbols, address) is not None:
+                note = '  return address? 0x%06X%s' % (address, where(address))
+        print('  [SP-%-3d] 0x%04X%s' % (2 * (n + 1), word, note))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
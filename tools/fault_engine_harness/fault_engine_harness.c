@@ -0,0 +1,891 @@
+/*LICENSE ********************************************************************
+ * Microchip Technology Inc. and its subsidiaries.  You may use this software
+ * and any derivatives exclusively with Microchip products.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION.
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE
+ * TERMS.
+ * ***************************************************************************/
+/*!fault_engine_harness.c
+ * ***********************************************************************************************
+ * Host test harness of the fault engine
+ *
+ * Description:
+ * The unmodified fault engine sources (fdrv_FaultHandler.c, fdrv_FaultObjects.c and the fault
+ * registry, log, rule, fast path and recovery modules) are built with the host C compiler against
+ * the device header shims in ./shim. The harness generates a configurable number of user fault
+ * objects with random compare types, source data types, levels, hystereses, counter thresholds,
+ * fault classes and optional dynamic compare objects and drives them with
+ *
+ *   - randomized waveforms (random walk with noise, steps and bursts per fault object), or
+ *   - a recorded single-channel waveform (one sample per line, normalized to -32768...32767),
+ *     applied to every fault object with its own phase, gain and offset.
+ *
+ * After every call of exec_FaultCheckAll() the results are compared against an independent
+ * reference model of the fault object state machine (fault_active, fault_status and counter
+ * of every fault object, global fault/warning/flag bits, fault mode override, main scheduler
+ * termination and user trip function calls). Fault check enable bits and fault group masks
+ * are toggled randomly during the run.
+ *
+ * The execution time of exec_FaultCheckAll() is measured separately from stimulus generation
+ * and reference model and reported as fault object evaluations per second. The trip digest
+ * is a hash across all fault trip and release events and allows comparing the behavior of
+ * different fault engine versions when replaying the same recorded waveform.
+ *
+ * Usage:
+ *   fault_engine_harness [--objects N] [--cycles N] [--seed N] [--record FILE | --replay FILE]
+ *
+ *   --objects N    number of user fault objects (1...FEH_OBJECTS_MAX, default 4096)
+ *   --cycles N     number of fault check cycles (default 10000)
+ *   --seed N       random seed of object configuration and waveforms (default 1)
+ *   --record FILE  generate a waveform, write it to FILE and replay it
+ *   --replay FILE  replay a recorded waveform from FILE ('#' starts a comment line)
+ *
+ * Up to (FAULT_REGISTRY_SIZE - FEH_USER_ID_FIRST) user fault objects are dispatched by the
+ * fault registry. Larger numbers of user fault objects exceed the registry and run the fault
+ * handler in list scan mode.
+ *
+ * Return:
+ *   0 = all fault check cycles matched the reference model, 1 = mismatch, 2 = usage error
+ * ***********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "xc.h"
+#include "_root/generic/os_Globals.h"
+
+#define FEH_OBJECTS_MAX         8192    // Maximum number of user fault objects
+#define FEH_USER_ID_FIRST       6       // First fault object ID not used by OS fault objects
+#define FEH_SCAN_MAX            (FEH_OBJECTS_MAX + 16) // Maximum number of OS and user fault objects
+#define FEH_MISMATCH_REPORT_MAX 10      // Maximum number of mismatches reported in detail
+#define FEH_WAVEFORM_MAX        1000000 // Maximum number of samples of a recorded waveform
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Firmware environment of the fault engine
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+// Special function registers referenced by the fault engine sources
+volatile uint16_t RCON, INTTREG, IFS0, TMR1, PR1, _T1IF;
+volatile uint16_t _ADDRERR, _APLL, _COVAERR, _COVBERR, _DIV0ERR, _DOOVR, _MATHERR,
+    _NAE, _OSCFAIL, _OVAERR, _OVBERR, _SGHT;
+
+// Operating system data structures monitored and modified by the fault engine
+volatile TASK_MANAGER_t task_mgr;
+volatile TRAP_LOGGER_t traplog;
+volatile TRAP_CRASH_RECORD_t crashlog;
+volatile bool run_scheduler = true;
+
+// User fault objects under test
+static volatile FAULT_OBJECT_t feh_fault_object[FEH_OBJECTS_MAX];
+volatile FAULT_OBJECT_t *user_fault_object_list[FEH_OBJECTS_MAX];
+volatile uint16_t user_fltobj_list_size = 0;
+
+static volatile uint16_t feh_FaultObjects_Initialize(void);
+volatile uint16_t (*user_fault_object_init_functions[])(void) = { &feh_FaultObjects_Initialize };
+volatile uint16_t user_fault_object_init_functions_size =
+    (sizeof(user_fault_object_init_functions)/sizeof(user_fault_object_init_functions[0]));
+
+// No composite fault rules and no staged fault recovery groups
+volatile FAULT_RULE_t *user_fault_rule_list[] = { NULL };
+volatile uint16_t user_fltrule_list_size = 0;
+volatile uint16_t user_fault_recovery_stages[] = { FLTGRP_NONE };
+volatile uint16_t user_fault_recovery_stages_size = 0;
+
+// User trip and reset function calls
+static uint32_t feh_trip_calls = 0;
+static uint32_t feh_reset_calls = 0;
+
+static volatile uint16_t feh_TripFunction(void) { feh_trip_calls++; return(1); }
+static volatile uint16_t feh_ResetFunction(void) { feh_reset_calls++; return(1); }
+
+volatile uint16_t APPLICATION_Reset(void) { feh_trip_calls++; return(1); }
+volatile uint16_t smpsHSPWM_OVR_Hold(volatile uint16_t instance) { (void)instance; return(1); }
+volatile uint32_t os_GetSystemTimestamp(void) 
+{ return(task_mgr.os_timer.tick_counter * (uint32_t)task_mgr.os_timer.master_period); }
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Stimulus
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+typedef union {
+    volatile uint16_t u16;
+    volatile uint32_t u32;
+    volatile int32_t i32;
+} FEH_SIGNAL_t; // Source/compare object storage of all source data types
+
+typedef struct {
+    int32_t level;  // recent normalized signal level (-32768 ... 32767)
+    int32_t noise;  // noise amplitude
+    int32_t burst;  // remaining cycles of a noise burst
+} FEH_WALK_t; // Random walk state of a randomized waveform
+
+typedef struct {
+    FEH_SIGNAL_t source; // monitored source object
+    FEH_SIGNAL_t compare; // dynamic compare object (if used)
+    FEH_WALK_t walk_source; // randomized waveform state of the source object
+    FEH_WALK_t walk_compare; // randomized waveform state of the compare object
+    uint32_t phase; // sample offset of the recorded waveform
+    int32_t gain; // gain applied to the recorded waveform (x/256)
+    int32_t offset; // offset added to the recorded waveform
+} FEH_STIMULUS_t;
+
+static FEH_STIMULUS_t feh_stimulus[FEH_OBJECTS_MAX];
+static int16_t* feh_waveform = NULL;
+static uint32_t feh_waveform_size = 0;
+static uint32_t feh_seed = 1;
+static uint16_t feh_objects = 4096;
+
+static uint32_t feh_Random(void)
+{
+    // xorshift32 pseudo random number generator (deterministic across hosts)
+    feh_seed ^= (feh_seed << 13);
+    feh_seed ^= (feh_seed >> 17);
+    feh_seed ^= (feh_seed << 5);
+    return(feh_seed);
+}
+
+static int32_t feh_RandomRange(int32_t min, int32_t max)
+{
+    return(min + (int32_t)(feh_Random() % (uint32_t)(max - min + 1)));
+}
+
+static int32_t feh_Saturate(int32_t value)
+{
+    if(value > INT16_MAX) { return(INT16_MAX); }
+    if(value < INT16_MIN) { return(INT16_MIN); }
+    return(value);
+}
+
+static int32_t feh_WalkStep(FEH_WALK_t* walk)
+{
+    uint32_t event = feh_Random();
+    int32_t noise = walk->noise;
+
+    if(walk->burst > 0) { walk->burst--; noise <<= 4; }
+
+    if((event & 0x3FF) == 0)
+    { walk->level = feh_RandomRange(INT16_MIN, INT16_MAX); } // step
+    else if((event & 0x3FF) == 1)
+    { walk->burst = feh_RandomRange(4, 64); } // noise burst
+
+    walk->level = feh_Saturate(walk->level + feh_RandomRange(-noise, noise));
+    return(walk->level);
+}
+
+static uint32_t feh_MapSignal(FLTOBJ_SOURCE_TYPE_e type, int32_t level)
+{
+    // map normalized signal level onto the value range of the source data type
+    switch(type)
+    {
+        case FLTOBJ_SOURCE_TYPE_UINT16: return((uint16_t)(level + 32768));
+        case FLTOBJ_SOURCE_TYPE_UINT32: return((uint32_t)(level + 32768) * 65537UL);
+        case FLTOBJ_SOURCE_TYPE_INT32:  return((uint32_t)(level * 65535L));
+        default: return((uint16_t)((int16_t)level)); // INT16 and Q15
+    }
+}
+
+static uint32_t feh_MapDifference(FLTOBJ_SOURCE_TYPE_e type, int32_t level)
+{
+    // map normalized absolute difference onto the value range of the source data type
+    switch(type)
+    {
+        case FLTOBJ_SOURCE_TYPE_UINT32: return((uint32_t)level * 65537UL);
+        case FLTOBJ_SOURCE_TYPE_INT32:  return((uint32_t)level * 65535UL);
+        default: return((uint16_t)level);
+    }
+}
+
+static void feh_WriteSignal(volatile FEH_SIGNAL_t* signal, FLTOBJ_SOURCE_TYPE_e type, int32_t level)
+{
+    if((type == FLTOBJ_SOURCE_TYPE_UINT32) || (type == FLTOBJ_SOURCE_TYPE_INT32))
+    { signal->u32 = feh_MapSignal(type, level); }
+    else
+    { signal->u16 = (uint16_t)feh_MapSignal(type, level); }
+}
+
+static void feh_UpdateStimulus(uint32_t cycle)
+{
+    uint16_t i;
+    int32_t level_source, level_compare;
+
+    for(i=0; i<feh_objects; i++)
+    {
+        FEH_STIMULUS_t* stim = &feh_stimulus[i];
+        FLTOBJ_SOURCE_TYPE_e type = feh_fault_object[i].criteria.source_type;
+
+        if(feh_waveform_size == 0)
+        {
+            level_source = feh_WalkStep(&stim->walk_source);
+            level_compare = feh_WalkStep(&stim->walk_compare);
+        }
+        else
+        {
+            level_source = feh_waveform[(cycle + stim->phase) % feh_waveform_size];
+            level_source = feh_Saturate(((level_source * stim->gain) >> 8) + stim->offset);
+            level_compare = feh_waveform[(cycle + (stim->phase >> 1)) % feh_waveform_size];
+            level_compare = feh_Saturate(((level_compare * stim->gain) >> 8) - stim->offset);
+        }
+
+        feh_WriteSignal(&stim->source, type, level_source);
+        feh_WriteSignal(&stim->compare, type, level_compare);
+    }
+}
+
+static void feh_GenerateWaveform(uint32_t size)
+{
+    FEH_WALK_t walk = { .level = 0, .noise = 256, .burst = 0 };
+    uint32_t i;
+
+    feh_waveform = malloc(size * sizeof(int16_t));
+    feh_waveform_size = size;
+    for(i=0; i<size; i++)
+    { feh_waveform[i] = (int16_t)feh_WalkStep(&walk); }
+}
+
+static int feh_WriteWaveform(const char* filename)
+{
+    FILE* file = fopen(filename, "w");
+    uint32_t i;
+
+    if(file == NULL) { perror(filename); return(0); }
+    fprintf(file, "# fault engine harness waveform, seed %u, %u samples\n",
+        (unsigned)feh_seed, (unsigned)feh_waveform_size);
+    for(i=0; i<feh_waveform_size; i++)
+    { fprintf(file, "%d\n", feh_waveform[i]); }
+    fclose(file);
+    return(1);
+}
+
+static int feh_ReadWaveform(const char* filename)
+{
+    FILE* file = fopen(filename, "r");
+    char line[64];
+
+    if(file == NULL) { perror(filename); return(0); }
+    feh_waveform = malloc(FEH_WAVEFORM_MAX * sizeof(int16_t));
+    feh_waveform_size = 0;
+
+    while((fgets(line, sizeof(line), file) != NULL) && (feh_waveform_size < FEH_WAVEFORM_MAX))
+    {
+        if((line[0] == '#') || (line[0] == '\n') || (line[0] == '\r')) { continue; }
+        feh_waveform[feh_waveform_size++] = (int16_t)feh_Saturate(strtol(line, NULL, 0));
+    }
+
+    fclose(file);
+    if(feh_waveform_size == 0) { fprintf(stderr, "%s: no samples\n", filename); return(0); }
+    return(1);
+}
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Fault object generator
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+static const FLTOBJ_COMPARE_TYPE_e feh_compare_types[] = {
+    FAULT_LEVEL_GREATER_THAN, FAULT_LEVEL_LESS_THAN, FAULT_LEVEL_EQUAL, FAULT_LEVEL_NOT_EQUAL,
+    FAULT_LEVEL_IN_RANGE, FAULT_LEVEL_OUT_OF_RANGE, FAULT_LEVEL_BOOLEAN };
+
+static const FLTOBJ_SOURCE_TYPE_e feh_source_types[] = {
+    FLTOBJ_SOURCE_TYPE_UINT16, FLTOBJ_SOURCE_TYPE_INT16, FLTOBJ_SOURCE_TYPE_Q15,
+    FLTOBJ_SOURCE_TYPE_UINT32, FLTOBJ_SOURCE_TYPE_INT32 };
+
+static const uint16_t feh_groups[] = {
+    FLTGRP_NONE, FLTGRP_INPUT, FLTGRP_OUTPUT, FLTGRP_THERMAL, FLTGRP_CONTROL, FLTGRP_COMM, FLTGRP_USER };
+
+#define FEH_ARRAY_SIZE(x) (sizeof(x)/sizeof((x)[0]))
+
+static void feh_SetLevels(volatile FAULT_OBJECT_t* fltobj, int32_t trip, int32_t reset, bool difference)
+{
+    FLTOBJ_SOURCE_TYPE_e type = fltobj->criteria.source_type;
+    uint32_t trip_value, reset_value;
+
+    if(difference)
+    {
+        trip_value = feh_MapDifference(type, (trip < 0) ? -trip : trip);
+        reset_value = feh_MapDifference(type, (reset < 0) ? -reset : reset);
+    }
+    else
+    {
+        trip_value = feh_MapSignal(type, trip);
+        reset_value = feh_MapSignal(type, reset);
+    }
+
+    if((type == FLTOBJ_SOURCE_TYPE_UINT32) || (type == FLTOBJ_SOURCE_TYPE_INT32))
+    {
+        fltobj->criteria.trip_level_32 = trip_value;
+        fltobj->criteria.reset_level_32 = reset_value;
+    }
+    else
+    {
+        fltobj->criteria.trip_level = (uint16_t)trip_value;
+        fltobj->criteria.reset_level = (uint16_t)reset_value;
+    }
+}
+
+static void feh_ConfigureFaultObject(uint16_t index)
+{
+    volatile FAULT_OBJECT_t* fltobj = &feh_fault_object[index];
+    FEH_STIMULUS_t* stim = &feh_stimulus[index];
+    int32_t trip, reset, hysteresis;
+    uint32_t dice;
+    bool difference;
+
+    memset((void*)fltobj, 0, sizeof(FAULT_OBJECT_t));
+    memset(stim, 0, sizeof(FEH_STIMULUS_t));
+
+    fltobj->id = FEH_USER_ID_FIRST + index; // IDs beyond the registry size force list scan mode
+    fltobj->error_code = fltobj->id;
+    fltobj->groups = feh_groups[feh_Random() % FEH_ARRAY_SIZE(feh_groups)];
+
+    // Stimulus
+    stim->walk_source.level = feh_RandomRange(-16384, 16383);
+    stim->walk_source.noise = feh_RandomRange(16, 2048);
+    stim->walk_compare.level = feh_RandomRange(-16384, 16383);
+    stim->walk_compare.noise = feh_RandomRange(16, 2048);
+    stim->phase = feh_Random();
+    stim->gain = feh_RandomRange(64, 512);
+    stim->offset = feh_RandomRange(-8192, 8191);
+
+    // Compare criteria
+    fltobj->criteria.source_type = feh_source_types[feh_Random() % FEH_ARRAY_SIZE(feh_source_types)];
+    fltobj->criteria.compare_type = feh_compare_types[feh_Random() % FEH_ARRAY_SIZE(feh_compare_types)];
+    fltobj->criteria.source_object = &stim->source.u16;
+    fltobj->criteria.source_bit_mask = FLTOBJ_BIT_MASK_DEFAULT;
+    fltobj->criteria.compare_bit_mask = FLTOBJ_BIT_MASK_DEFAULT;
+
+    difference = ((feh_Random() & 0x3) == 0);
+    if(difference) { fltobj->criteria.compare_object = &stim->compare.u16; }
+
+    dice = feh_Random();
+    if((dice & 0x3) == 0)
+    {
+        // bit-mask filtered 16-bit sources
+        fltobj->criteria.source_bit_mask = (uint16_t)(dice >> 16);
+        fltobj->criteria.compare_bit_mask = (uint16_t)(dice >> 8);
+    }
+
+    hysteresis = feh_RandomRange(0, 4096);
+    trip = feh_RandomRange(-24576, 24575);
+
+    switch(fltobj->criteria.compare_type)
+    {
+        case FAULT_LEVEL_GREATER_THAN: reset = trip - hysteresis; break;
+        case FAULT_LEVEL_LESS_THAN: reset = trip + hysteresis; break;
+        case FAULT_LEVEL_IN_RANGE:
+        case FAULT_LEVEL_OUT_OF_RANGE: reset = trip - feh_RandomRange(256, 16384); break;
+        default: reset = trip; break;
+    }
+
+    if(difference)
+    {
+        // levels of dynamic compare objects are absolute differences
+        trip = (trip + 32768) >> 1;
+        reset = (reset + 32768) >> 1;
+    }
+
+    feh_SetLevels(fltobj, feh_Saturate(trip), feh_Saturate(reset), difference);
+
+    if((fltobj->criteria.compare_type == FAULT_LEVEL_EQUAL) ||
+       (fltobj->criteria.compare_type == FAULT_LEVEL_NOT_EQUAL))
+    {
+        // equality checks of narrow bit fields trip more often
+        fltobj->criteria.source_bit_mask = 0x000F;
+        fltobj->criteria.compare_bit_mask = 0x000F;
+        fltobj->criteria.trip_level = (uint16_t)feh_RandomRange(0, 15);
+        fltobj->criteria.trip_level_32 = (uint32_t)feh_RandomRange(0, 15);
+    }
+
+    fltobj->criteria.trip_cnt_threshold = (uint16_t)feh_RandomRange(0, 8);
+    fltobj->criteria.reset_cnt_threshold = (uint16_t)feh_RandomRange(0, 8);
+    fltobj->criteria.counter = 0;
+
+    // Fault class
+    dice = feh_Random() % 100;
+    if(dice < 30) { fltobj->flt_class.value = FLT_CLASS_FLAG; }
+    else if(dice < 60) { fltobj->flt_class.value = FLT_CLASS_WARNING; }
+    else if(dice < 85) { fltobj->flt_class.value = FLT_CLASS_CRITICAL; }
+    else if(dice < 88) { fltobj->flt_class.value = FLT_CLASS_CATASTROPHIC; }
+    else if(dice < 95) { fltobj->flt_class.value = (FLT_CLASS_WARNING | FLT_CLASS_FLAG); }
+    else { fltobj->flt_class.value = FLT_CLASS_NONE; }
+
+    if(feh_Random() & 0x1)
+    {
+        fltobj->flt_class.value |= FLT_CLASS_USER_RESPONSE;
+        if(feh_Random() & 0x3) { fltobj->trip_function = &feh_TripFunction; }
+        if(feh_Random() & 0x1) { fltobj->reset_function = &feh_ResetFunction; }
+    }
+
+    // Status
+    fltobj->status.bits.fltlvl_sys = 1;
+    fltobj->status.bits.fltchk_enabled = ((feh_Random() % 10) != 0);
+}
+
+static volatile uint16_t feh_FaultObjects_Initialize(void)
+{
+    uint16_t i;
+
+    for(i=0; i<feh_objects; i++)
+    {
+        feh_ConfigureFaultObject(i);
+        user_fault_object_list[i] = &feh_fault_object[i];
+    }
+
+    user_fltobj_list_size = feh_objects;
+    return(1);
+}
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Reference model
+ *
+ * Plain re-implementation of the specified fault object behavior. The reference model takes a
+ * copy of the fault object settings after initialization and only shares the monitored source
+ * and compare objects with the fault engine.
+ *
+ *   - 16-bit sources are bit-mask filtered, signed types are sign-extended
+ *   - dynamic compare objects turn the source value into the absolute difference (32-bit
+ *     signed differences saturate at INT32_MAX)
+ *   - GREATER_THAN/LESS_THAN hold the recent condition inside the hysteresis band
+ *   - fault_status trips after trip_cnt_threshold successive cycles with fault_active set and
+ *     releases after reset_cnt_threshold successive cycles with fault_active cleared. The
+ *     counter is clamped to the respective threshold on every trip and release.
+ *   - CATASTROPHIC faults set the global fault bit, force fault mode and terminate the main
+ *     scheduler without executing any further response
+ *   - global fault/warning/flag bits are cleared at the end of a cycle when no tripped fault
+ *     object of fault class CRITICAL/WARNING/FLAG has been checked
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+typedef struct {
+    volatile FAULT_OBJECT_t* fltobj; // fault object under test (results only)
+    volatile uint16_t* source; // monitored source object
+    volatile uint16_t* compare; // dynamic compare object (NULL = constant levels)
+    uint16_t source_mask, compare_mask;
+    FLTOBJ_COMPARE_TYPE_e compare_type;
+    FLTOBJ_SOURCE_TYPE_e source_type;
+    int64_t trip_level, reset_level;
+    uint16_t trip_cnt, reset_cnt;
+    uint16_t fault_class;
+    uint16_t groups;
+    bool trip_function;
+    // model state
+    bool enabled, active, status;
+    uint16_t counter;
+    bool engine_status; // fault status of the fault object under test in the previous cycle
+} FEH_REFERENCE_t;
+
+typedef struct {
+    FEH_REFERENCE_t object[FEH_SCAN_MAX];
+    uint16_t size;
+    uint16_t groups_disabled;
+    bool global_fault, global_warning, global_flag;
+    // results of the most recent cycle
+    bool fault_mode, scheduler_terminated;
+    uint32_t trip_calls, evaluations, trips, releases;
+} FEH_MODEL_t;
+
+static FEH_MODEL_t feh_model;
+
+static void feh_ModelAdd(volatile FAULT_OBJECT_t* fltobj)
+{
+    FEH_REFERENCE_t* ref = &feh_model.object[feh_model.size++];
+
+    ref->fltobj = fltobj;
+    ref->source = fltobj->criteria.source_object;
+    ref->compare = fltobj->criteria.compare_object;
+    ref->source_mask = fltobj->criteria.source_bit_mask;
+    ref->compare_mask = fltobj->criteria.compare_bit_mask;
+    ref->compare_type = fltobj->criteria.compare_type;
+    ref->source_type = fltobj->criteria.source_type;
+    ref->trip_cnt = fltobj->criteria.trip_cnt_threshold;
+    ref->reset_cnt = fltobj->criteria.reset_cnt_threshold;
+    ref->fault_class = fltobj->flt_class.value;
+    ref->groups = fltobj->groups;
+    ref->trip_function = (fltobj->trip_function != NULL);
+
+    switch(ref->source_type)
+    {
+        case FLTOBJ_SOURCE_TYPE_UINT16:
+            ref->trip_level = fltobj->criteria.trip_level;
+            ref->reset_level = fltobj->criteria.reset_level;
+            break;
+        case FLTOBJ_SOURCE_TYPE_UINT32:
+            ref->trip_level = fltobj->criteria.trip_level_32;
+            ref->reset_level = fltobj->criteria.reset_level_32;
+            break;
+        case FLTOBJ_SOURCE_TYPE_INT32:
+            ref->trip_level = (int32_t)fltobj->criteria.trip_level_32;
+            ref->reset_level = (int32_t)fltobj->criteria.reset_level_32;
+            break;
+        default:
+            ref->trip_level = (int16_t)fltobj->criteria.trip_level;
+            ref->reset_level = (int16_t)fltobj->criteria.reset_level;
+            break;
+    }
+
+    ref->enabled = fltobj->status.bits.fltchk_enabled;
+    ref->active = fltobj->status.bits.fault_active;
+    ref->status = fltobj->status.bits.fault_status;
+    ref->counter = fltobj->criteria.counter;
+    ref->engine_status = ref->status;
+}
+
+static void feh_ModelInitialize(void)
+{
+    uint16_t i;
+
+    feh_model.size = 0;
+    for(i=0; i<os_fltobj_list_size; i++)
+    { if(os_fault_object_list[i] != NULL) { feh_ModelAdd(os_fault_object_list[i]); } }
+    for(i=0; i<user_fltobj_list_size; i++)
+    { feh_ModelAdd(user_fault_object_list[i]); }
+
+    feh_model.groups_disabled = fault_registry.groups_disabled;
+    feh_model.global_fault = task_mgr.status.bits.global_fault;
+    feh_model.global_warning = task_mgr.status.bits.global_warning;
+    feh_model.global_flag = task_mgr.status.bits.global_flag;
+}
+
+static int64_t feh_ModelSourceValue(const FEH_REFERENCE_t* ref)
+{
+    int64_t value, compare;
+
+    switch(ref->source_type)
+    {
+        case FLTOBJ_SOURCE_TYPE_UINT16:
+            value = (*ref->source & ref->source_mask);
+            compare = (ref->compare != NULL) ? (*ref->compare & ref->compare_mask) : 0;
+            break;
+        case FLTOBJ_SOURCE_TYPE_UINT32:
+            value = *(volatile uint32_t*)ref->source;
+            compare = (ref->compare != NULL) ? *(volatile uint32_t*)ref->compare : 0;
+            break;
+        case FLTOBJ_SOURCE_TYPE_INT32:
+            value = *(volatile int32_t*)ref->source;
+            compare = (ref->compare != NULL) ? *(volatile int32_t*)ref->compare : 0;
+            break;
+        default:
+            value = (int16_t)(*ref->source & ref->source_mask);
+            compare = (ref->compare != NULL) ? (int16_t)(*ref->compare & ref->compare_mask) : 0;
+            break;
+    }
+
+    if(ref->compare != NULL)
+    {
+        value = (value > compare) ? (value - compare) : (compare - value);
+        if(value > INT32_MAX) { value = INT32_MAX; } // only reachable by 32-bit signed types
+        if(ref->source_type == FLTOBJ_SOURCE_TYPE_UINT16) { value = (uint16_t)value; }
+    }
+
+    return(value);
+}
+
+static bool feh_ModelFaultActive(const FEH_REFERENCE_t* ref, int64_t value)
+{
+    switch(ref->compare_type)
+    {
+        case FAULT_LEVEL_GREATER_THAN:
+            if(value > ref->trip_level) { return(true); }
+            if(value < ref->reset_level) { return(false); }
+            return(ref->active);
+        case FAULT_LEVEL_LESS_THAN:
+            if(value < ref->trip_level) { return(true); }
+            if(value > ref->reset_level) { return(false); }
+            return(ref->active);
+        case FAULT_LEVEL_EQUAL: return(value == ref->trip_level);
+        case FAULT_LEVEL_NOT_EQUAL: return(value != ref->trip_level);
+        case FAULT_LEVEL_IN_RANGE: return((ref->reset_level < value) && (value < ref->trip_level));
+        case FAULT_LEVEL_OUT_OF_RANGE: return((value < ref->reset_level) || (value > ref->trip_level));
+        case FAULT_LEVEL_BOOLEAN: return(value != 0);
+        default: return(ref->active);
+    }
+}
+
+static void feh_ModelTrip(FEH_REFERENCE_t* ref)
+{
+    feh_model.trips++;
+
+    if(ref->fault_class & FLT_CLASS_CATASTROPHIC)
+    {
+        feh_model.global_fault = true;
+        feh_model.fault_mode = true;
+        feh_model.scheduler_terminated = true;
+        return;
+    }
+
+    if(ref->fault_class & FLT_CLASS_CRITICAL)
+    { feh_model.global_fault = true; feh_model.fault_mode = true; }
+    if(ref->fault_class & FLT_CLASS_WARNING) { feh_model.global_warning = true; }
+    if(ref->fault_class & FLT_CLASS_FLAG) { feh_model.global_flag = true; }
+    if((ref->fault_class & FLT_CLASS_USER_RESPONSE) && (ref->trip_function))
+    { feh_model.trip_calls++; }
+}
+
+static void feh_ModelCycle(void)
+{
+    uint16_t i, present = 0;
+
+    feh_model.fault_mode = false;
+    feh_model.scheduler_terminated = false;
+
+    for(i=0; i<feh_model.size; i++)
+    {
+        FEH_REFERENCE_t* ref = &feh_model.object[i];
+
+        if(!ref->enabled) { continue; }
+
+        // masked objects are not evaluated, but their latched status still counts
+        if(ref->groups & feh_model.groups_disabled)
+        {
+            if(ref->status) { present |= ref->fault_class; }
+            continue;
+        }
+        feh_model.evaluations++;
+
+        ref->active = feh_ModelFaultActive(ref, feh_ModelSourceValue(ref));
+
+        if(!ref->status)
+        {
+            if(!ref->active) { ref->counter = 0; }
+            else if(++ref->counter >= ref->trip_cnt)
+            {
+                ref->counter = ref->trip_cnt;
+                ref->status = true;
+                feh_ModelTrip(ref);
+            }
+        }
+        else
+        {
+            if(ref->active) { ref->counter = 0; }
+            else if(++ref->counter >= ref->reset_cnt)
+            {
+                ref->counter = ref->reset_cnt;
+                ref->status = false;
+                feh_model.releases++;
+            }
+        }
+
+        if(ref->status) { present |= ref->fault_class; }
+    }
+
+    if(!(present & FLT_CLASS_CRITICAL)) { feh_model.global_fault = false; }
+    if(!(present & FLT_CLASS_WARNING)) { feh_model.global_warning = false; }
+    if(!(present & FLT_CLASS_FLAG)) { feh_model.global_flag = false; }
+}
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Test run
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+static uint32_t feh_mismatches = 0;
+static uint32_t feh_digest = 2166136261UL; // FNV-1a offset basis
+
+static void feh_Mismatch(uint32_t cycle, const char* item, int64_t engine, int64_t model)
+{
+    if(feh_mismatches++ < FEH_MISMATCH_REPORT_MAX)
+    {
+        fprintf(stderr, "  MISMATCH cycle %u: %s: engine=%lld, model=%lld\n",
+            (unsigned)cycle, item, (long long)engine, (long long)model);
+    }
+}
+
+static void feh_Digest(uint32_t value)
+{
+    uint16_t i;
+    for(i=0; i<4; i++)
+    {
+        feh_digest ^= (value & 0xFF);
+        feh_digest *= 16777619UL; // FNV-1a prime
+        value >>= 8;
+    }
+}
+
+static void feh_Compare(uint32_t cycle, uint16_t fres)
+{
+    uint16_t i;
+    char item[64];
+
+    if(fres != 1) { feh_Mismatch(cycle, "exec_FaultCheckAll() return value", fres, 1); }
+
+    for(i=0; i<feh_model.size; i++)
+    {
+        FEH_REFERENCE_t* ref = &feh_model.object[i];
+        volatile FAULT_OBJECT_t* fltobj = ref->fltobj;
+
+        if(fltobj->status.bits.fault_active != ref->active)
+        {
+            snprintf(item, sizeof(item), "fault object %u fault_active", fltobj->id);
+            feh_Mismatch(cycle, item, fltobj->status.bits.fault_active, ref->active);
+        }
+        if(fltobj->status.bits.fault_status != ref->status)
+        {
+            snprintf(item, sizeof(item), "fault object %u fault_status", fltobj->id);
+            feh_Mismatch(cycle, item, fltobj->status.bits.fault_status, ref->status);
+        }
+        if(fltobj->criteria.counter != ref->counter)
+        {
+            snprintf(item, sizeof(item), "fault object %u counter", fltobj->id);
+            feh_Mismatch(cycle, item, fltobj->criteria.counter, ref->counter);
+        }
+    }
+
+    if(task_mgr.status.bits.global_fault != feh_model.global_fault)
+    { feh_Mismatch(cycle, "global_fault", task_mgr.status.bits.global_fault, feh_model.global_fault); }
+    if(task_mgr.status.bits.global_warning != feh_model.global_warning)
+    { feh_Mismatch(cycle, "global_warning", task_mgr.status.bits.global_warning, feh_model.global_warning); }
+    if(task_mgr.status.bits.global_flag != feh_model.global_flag)
+    { feh_Mismatch(cycle, "global_flag", task_mgr.status.bits.global_flag, feh_model.global_flag); }
+    if(feh_model.fault_mode && (task_mgr.op_mode.value != OP_MODE_FAULT))
+    { feh_Mismatch(cycle, "op_mode", task_mgr.op_mode.value, OP_MODE_FAULT); }
+    if(feh_model.fault_mode && (!task_mgr.status.bits.fault_override))
+    { feh_Mismatch(cycle, "fault_override", task_mgr.status.bits.fault_override, 1); }
+    if(run_scheduler == feh_model.scheduler_terminated)
+    { feh_Mismatch(cycle, "run_scheduler", run_scheduler, !feh_model.scheduler_terminated); }
+    if(feh_trip_calls != feh_model.trip_calls)
+    { feh_Mismatch(cycle, "trip function calls", feh_trip_calls, feh_model.trip_calls); }
+}
+
+static void feh_Fuzz(void)
+{
+    uint32_t dice = feh_Random();
+    uint16_t index, groups;
+
+    if((dice & 0x1F) == 0)
+    {
+        // toggle fault check of a user fault object
+        index = (uint16_t)(feh_Random() % feh_objects);
+        feh_fault_object[index].status.bits.fltchk_enabled = !feh_fault_object[index].status.bits.fltchk_enabled;
+        feh_model.object[feh_model.size - feh_objects + index].enabled = feh_fault_object[index].status.bits.fltchk_enabled;
+    }
+    else if((dice & 0x7F) == 1)
+    {
+        // mask/unmask a user fault group
+        groups = feh_groups[1 + (feh_Random() % (FEH_ARRAY_SIZE(feh_groups) - 1))];
+        if(feh_model.groups_disabled & groups) { EnableFaultGroups(groups); }
+        else { DisableFaultGroups(groups); }
+        feh_model.groups_disabled ^= groups;
+    }
+}
+
+static double feh_Seconds(const struct timespec* start, const struct timespec* stop)
+{
+    return((double)(stop->tv_sec - start->tv_sec) + (1e-9 * (double)(stop->tv_nsec - start->tv_nsec)));
+}
+
+static int feh_Usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [--objects N] [--cycles N] [--seed N] [--record FILE | --replay FILE]\n", name);
+    return(2);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t cycles = 10000, cycle, seed = 1, i;
+    const char* record = NULL;
+    const char* replay = NULL;
+    struct timespec t0, t1;
+    double engine_time = 0.0, model_time = 0.0;
+    uint16_t fres, init_fres;
+
+    for(i=1; i<(uint32_t)argc; i++)
+    {
+        if((strcmp(argv[i], "--objects") == 0) && (i+1 < (uint32_t)argc)) { feh_objects = (uint16_t)strtoul(argv[++i], NULL, 0); }
+        else if((strcmp(argv[i], "--cycles") == 0) && (i+1 < (uint32_t)argc)) { cycles = strtoul(argv[++i], NULL, 0); }
+        else if((strcmp(argv[i], "--seed") == 0) && (i+1 < (uint32_t)argc)) { seed = strtoul(argv[++i], NULL, 0); }
+        else if((strcmp(argv[i], "--record") == 0) && (i+1 < (uint32_t)argc)) { record = argv[++i]; }
+        else if((strcmp(argv[i], "--replay") == 0) && (i+1 < (uint32_t)argc)) { replay = argv[++i]; }
+        else { return(feh_Usage(argv[0])); }
+    }
+
+    if((feh_objects == 0) || (feh_objects > FEH_OBJECTS_MAX) || (record && replay))
+    { return(feh_Usage(argv[0])); }
+
+    feh_seed = (seed != 0) ? seed : 1;
+
+    // Recorded waveforms
+    if(record != NULL)
+    {
+        feh_GenerateWaveform(cycles);
+        feh_seed = (seed != 0) ? seed : 1; // replay of the recorded file generates identical fault objects
+        if(!feh_WriteWaveform(record)) { return(2); }
+    }
+    else if(replay != NULL)
+    {
+        if(!feh_ReadWaveform(replay)) { return(2); }
+    }
+
+    // Operating system state monitored by OS fault objects
+    task_mgr.os_timer.master_period = 0xFFFF;
+    task_mgr.task_queue.active_retval = 1;
+    task_mgr.op_mode.value = OP_MODE_STARTUP_SEQUENCE;
+
+    init_fres = os_FaultObjects_Initialize();
+    feh_ModelInitialize();
+
+    printf("fault engine harness: %u user + %u OS fault objects, %s mode, %u cycles, seed %u, %s waveform\n",
+        (unsigned)user_fltobj_list_size, (unsigned)os_fltobj_list_size,
+        fault_registry.list_scan ? "list scan" : "registry", (unsigned)cycles, (unsigned)seed,
+        (feh_waveform_size == 0) ? "randomized" : "recorded");
+
+    if((init_fres != 1) != fault_registry.list_scan)
+    { feh_Mismatch(0, "os_FaultObjects_Initialize() return value", init_fres, !fault_registry.list_scan); }
+
+    for(cycle=0; cycle<cycles; cycle++)
+    {
+        feh_UpdateStimulus(cycle);
+        feh_Fuzz();
+        task_mgr.os_timer.tick_counter++;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        fres = exec_FaultCheckAll();
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        engine_time += feh_Seconds(&t0, &t1);
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        feh_ModelCycle();
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        model_time += feh_Seconds(&t0, &t1);
+
+        feh_Compare(cycle, fres);
+
+        // add trip and release events of the fault engine to the trip digest
+        for(i=0; i<feh_model.size; i++)
+        {
+            FEH_REFERENCE_t* ref = &feh_model.object[i];
+            if(ref->fltobj->status.bits.fault_status != ref->engine_status)
+            {
+                ref->engine_status = ref->fltobj->status.bits.fault_status;
+                feh_Digest(cycle);
+                feh_Digest((i << 1) | ref->engine_status);
+            }
+        }
+
+        // a catastrophic fault would reset the CPU; the harness continues
+        run_scheduler = true;
+    }
+
+    printf("  engine:      %10.3e evaluations/s (%.1f ns per fault object, %.2f us per cycle)\n",
+        feh_model.evaluations / engine_time, 1e9 * engine_time / feh_model.evaluations, 1e6 * engine_time / cycles);
+    printf("  reference:   %10.3e evaluations/s\n", feh_model.evaluations / model_time);
+    printf("  events:      %u trips, %u releases, %u trip function calls, %u reset function calls\n",
+        (unsigned)feh_model.trips, (unsigned)feh_model.releases, (unsigned)feh_trip_calls, (unsigned)feh_reset_calls);
+    printf("  trip digest: 0x%08X\n", (unsigned)feh_digest);
+    printf("  result:      %s (%u mismatches)\n", (feh_mismatches == 0) ? "PASS" : "FAIL", (unsigned)feh_mismatches);
+
+    return((feh_mismatches == 0) ? 0 : 1);
+}
+
+// EOF
@@ -0,0 +1,29 @@
+/*!os_Globals.h (fault engine harness shim)
+ * ***********************************************************************************************
+ * Description:
+ * Host replacement of the project-wide global declarations. Only the operating system headers
+ * required by the fault engine sources are included, so drivers and peripheral libraries
+ * remain outside of the host build.
+ * ***********************************************************************************************/
+
+#ifndef PROJECT_GLOBAL_DECLARATIONS_H
+#define PROJECT_GLOBAL_DECLARATIONS_H
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "_root/generic/fdrv_FaultHandler.h"
+#include "_root/generic/fdrv_FaultObjects.h"
+#include "_root/generic/fdrv_FaultRegistry.h"
+#include "_root/generic/fdrv_FaultLog.h"
+#include "_root/generic/fdrv_FaultLatency.h"
+#include "_root/generic/fdrv_FaultFastPath.h"
+#include "_root/generic/fdrv_FaultRecovery.h"
+#include "_root/generic/fdrv_FaultRules.h"
+#include "_root/generic/fdrv_TrapHandler.h"
+#include "_root/generic/os_Initialize.h"
+#include "_root/generic/os_TaskManager.h"
+#include "_root/generic/os_BootProfiler.h"
+#include "_root/generic/os_Scheduler.h"
+
+extern volatile uint16_t APPLICATION_Reset(void);
+#endif
@@ -0,0 +1,15 @@
+/*!mcal.h (fault engine harness shim)
+ * ***********************************************************************************************
+ * Description:
+ * Host replacement of the microcontroller abstraction layer header. Only the clock 
+ * configuration and the PWM override function used by the fault engine are provided.
+ * ***********************************************************************************************/
+
+#ifndef MICROCONTROLLER_ABSTRACTION_LAYER_H
+#define MICROCONTROLLER_ABSTRACTION_LAYER_H
+#include <xc.h>
+#include "mcal/config/devcfg_oscillator.h"
+#include "mcal/config/devcfg_clocktree.h"
+
+extern volatile uint16_t smpsHSPWM_OVR_Hold(volatile uint16_t instance);
+#endif
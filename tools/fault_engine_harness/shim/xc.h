@@ -0,0 +1,22 @@
+/*!xc.h (fault engine harness shim)
+ * ***********************************************************************************************
+ * Description:
+ * Host replacement of the XC16 device header. Maps XC16-specific attributes and intrinsics
+ * onto host GCC equivalents and declares the special function registers referenced by the
+ * fault engine sources as plain variables (defined in fault_engine_harness.c).
+ * ***********************************************************************************************/
+
+#ifndef FAULT_ENGINE_HARNESS_XC_H
+#define FAULT_ENGINE_HARNESS_XC_H
+#include <stdint.h>
+#include <stddef.h>
+#define __XC16_VERSION 2000
+#define __interrupt__ unused
+#define persistent unused
+#define __persistent__ unused
+#define Nop()
+#define ClrWdt()
+extern volatile uint16_t RCON, INTTREG, IFS0, TMR1, PR1, _T1IF;
+extern volatile uint16_t _ADDRERR, _APLL, _COVAERR, _COVBERR, _DIV0ERR, _DOOVR, _MATHERR, 
+    _NAE, _OSCFAIL, _OVAERR, _OVBERR, _SGHT;
+#endif
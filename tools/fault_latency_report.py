@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+File:   fault_latency_report.py
+
+Summary:
+Host report generator of the fault response latency instrumentation
+(fault_latency) recorded by project/src/_root/generic/fdrv_FaultLatency.c
+
+Description:
+Reads a RAM dump of the fault_latency data structure, taken from the target
+or written by a host simulation, and prints the latency histograms of the
+detection, response and fault queue entry stages per fault object ID.
+
+Supported input formats:
+    - binary file (raw little-endian memory image starting at &fault_latency)
+    - text file of 16-bit hexadecimal words (e.g. copied from the MPLAB X
+      memory window), optionally preceded by an address column ending in ':'
+
+Usage:
+    fault_latency_report.py dump.bin [--fcy 100e6]
+
+Please note:
+The record layout must match FAULT_LATENCY_RECORD_t in fdrv_FaultLatency.h.
+Fault IDs refer to fault_object_index_e (UserFaultObjects.h).
+"""
+
+import argparse
+import struct
+import sys
+
+from fault_log_decoder import read_dump
+
+FAULT_LATENCY_STAGE_COUNT = 3
+FAULT_LATENCY_BINS = 16
+
+HEADER_FORMAT = '<H'        # object_count
+RECORD_FORMAT = '<3I4H3I%dH' % (FAULT_LATENCY_STAGE_COUNT * FAULT_LATENCY_BINS)
+
+STAGES = ('violation -> trip', 'trip -> response', 'trip -> fault queue')
+
+
+def decode(data):
+    hdr_len = struct.calcsize(HEADER_FORMAT)
+    rec_len = struct.calcsize(RECORD_FORMAT)
+    (count,) = struct.unpack_from(HEADER_FORMAT, data, 0)
+    if len(data) < hdr_len + count * rec_len:
+        raise ValueError('dump holds %d bytes, %d bytes expected' % (len(data), hdr_len + count * rec_len))
+
+    records = []
+    for i in range(count):
+        fields = struct.unpack_from(RECORD_FORMAT, data, hdr_len + i * rec_len)
+        hist = fields[10:]
+        records.append({
+            'sample_count': fields[4:7],
+            'latency_max': fields[7:10],
+            'histogram': [hist[s * FAULT_LATENCY_BINS:(s + 1) * FAULT_LATENCY_BINS]
+                          for s in range(FAULT_LATENCY_STAGE_COUNT)],
+        })
+    return records
+
+
+def format_time(cycles, fcy):
+    t = cycles / fcy
+    if t >= 1e-3:
+        return '%.3f ms' % (t * 1e3)
+    return '%.3f us' % (t * 1e6)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Print fault response latency histograms')
+    parser.add_argument('dump', help='memory dump of fault_latency (binary or hex words)')
+    parser.add_argument('--fcy', type=float, default=100e6,
+                        help='task manager timer clock frequency in Hz (default 100e6)')
+    args = parser.parse_args()
+
+    try:
+        records = decode(read_dump(args.dump))
+    except (ValueError, struct.error) as e:
+        sys.stderr.write('%s: %s\n' % (args.dump, e))
+        return 1
+
+    for fid, rec in enumerate(records):
+        if not any(rec['sample_count']):
+            continue
+        print('fault %d' % fid)
+        for s, name in enumerate(STAGES):
+            if not rec['sample_count'][s]:
+                continue
+            print('    %-20s samples: %5d   max: %s' % (
+                name, rec['sample_count'][s], format_time(rec['latency_max'][s], args.fcy)))
+            for b, n in enumerate(rec['histogram'][s]):
+                if n:
+                    lo = 0 if b == 0 else 4 ** b
+                    print('        %12s ... %12s %6d' % (
+                        format_time(lo, args.fcy), format_time(4 ** (b + 1) - 1, args.fcy), n))
+        print('')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+File:   fault_log_decoder.py
+
+Summary:
+Host decoder of the persistent fault history log (fault_log) recorded by
+project/src/_root/generic/fdrv_FaultLog.c
+
+Description:
+Reads a RAM dump of the fault_log data structure and prints all valid fault
+event records in chronological order followed by the occurrence statistics
+per fault object ID.
+
+Supported input formats:
+    - binary file (raw little-endian memory image starting at &fault_log)
+    - text file of 16-bit hexadecimal words (e.g. copied from the MPLAB X
+      memory window), optionally preceded by an address column ending in ':'
+
+Usage:
+    fault_log_decoder.py dump.bin [--size 16] [--objects 16] [--pace 100e-6]
+
+Please note:
+--size and --objects must match FAULT_LOG_SIZE and FAULT_LOG_OBJECT_COUNT in
+task_manager_config.h. Fault IDs and operating mode values refer to
+fault_object_index_e (UserFaultObjects.h) and SYSTEM_OPERATION_MODE_e
+(os_TaskManager.h).
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FAULT_LOG_SIGNATURE = 0xFA17
+FAULT_LOG_TIME_OPEN = 0xFFFFFFFF
+
+HEADER_FORMAT = '<5H'       # signature, signature_inv, index, event_count, boot_count
+ENTRY_FORMAT = '<HBBHIII'   # fault_id, op_mode, task_id, boot_count, timestamp, source_value, time_in_fault
+
+OP_MODES = {
+    0x00: 'UNKNOWN', 0x01: 'BOOT', 0x02: 'FIRMWARE_INIT', 0x04: 'STARTUP_SEQUENCE',
+    0x08: 'IDLE', 0x10: 'RUN', 0x40: 'FAULT', 0x80: 'STANDBY',
+}
+
+
+def read_dump(filename):
+    with open(filename, 'rb') as f:
+        data = f.read()
+    try:
+        text = data.decode('ascii')
+    except UnicodeDecodeError:
+        return data
+    if not re.fullmatch(r'[\s0-9A-Fa-fxX:]*', text):
+        return data
+    words = []
+    for line in text.splitlines():
+        line = line.split(':', 1)[-1]
+        for tok in line.split():
+            words.append(int(tok, 16) & 0xFFFF)
+    return b''.join(struct.pack('<H', w) for w in words)
+
+
+def decode(data, size, objects):
+    hdr_len = struct.calcsize(HEADER_FORMAT)
+    ent_len = struct.calcsize(ENTRY_FORMAT)
+    total = hdr_len + size * ent_len + objects * (2 + 4 + 2)
+    if len(data) < total:
+        raise ValueError('dump holds %d bytes, %d bytes expected' % (len(data), total))
+
+    sig, sig_inv, index, event_count, boot_count = struct.unpack_from(HEADER_FORMAT, data, 0)
+    if sig != FAULT_LOG_SIGNATURE or sig_inv != (~FAULT_LOG_SIGNATURE & 0xFFFF):
+        raise ValueError('invalid fault log signature 0x%04X/0x%04X' % (sig, sig_inv))
+    if index >= size:
+        raise ValueError('invalid ring buffer index %d' % index)
+
+    pos = hdr_len
+    entries = []
+    for _ in range(size):
+        entries.append(struct.unpack_from(ENTRY_FORMAT, data, pos))
+        pos += ent_len
+    trip_count = struct.unpack_from('<%dH' % objects, data, pos)
+    pos += 2 * objects
+    fault_time = struct.unpack_from('<%dI' % objects, data, pos)
+
+    # oldest record is located at the write index once the buffer has wrapped
+    valid = min(event_count, size)
+    order = [(index - valid + i) % size for i in range(valid)]
+
+    return {
+        'index': index, 'event_count': event_count, 'boot_count': boot_count,
+        'entries': [entries[i] for i in order],
+        'trip_count': trip_count, 'fault_time': fault_time,
+    }
+
+
+def format_time(ticks, pace):
+    if ticks == FAULT_LOG_TIME_OPEN:
+        return 'active'
+    return '%.4f s' % (ticks * pace)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the persistent fault history log')
+    parser.add_argument('dump', help='memory dump of fault_log (binary or hex words)')
+    parser.add_argument('--size', type=int, default=16, help='FAULT_LOG_SIZE (default 16)')
+    parser.add_argument('--objects', type=int, default=16, help='FAULT_LOG_OBJECT_COUNT (default 16)')
+    parser.add_argument('--pace', type=float, default=100e-6,
+                        help='time stamp tick period in seconds (TASK_MGR_MASTER_PACE, default 100e-6)')
+    args = parser.parse_args()
+
+    try:
+        log = decode(read_dump(args.dump), args.size, args.objects)
+    except (ValueError, struct.error) as e:
+        sys.stderr.write('%s: %s\n' % (args.dump, e))
+        return 1
+
+    print('boots since log clear: %d, recorded events: %d%s' % (
+        log['boot_count'], log['event_count'], ' (saturated)' if log['event_count'] == 0xFFFF else ''))
+    print('')
+    print('%4s %5s %8s %-18s %4s %14s %12s %12s' % (
+        '#', 'boot', 'fault', 'op-mode', 'task', 'time stamp', 'source', 'in fault'))
+    for n, (fid, op_mode, task_id, boot, stamp, value, tif) in enumerate(log['entries']):
+        print('%4d %5d %8d %-18s %4d %12.4f s %#12x %12s' % (
+            n, boot, fid, OP_MODES.get(op_mode, '0x%02X' % op_mode), task_id,
+            stamp * args.pace, value, format_time(tif, args.pace)))
+    print('')
+    print('%8s %8s %16s' % ('fault', 'trips', 'time in fault'))
+    for fid in range(args.objects):
+        if log['trip_count'][fid]:
+            print('%8d %8d %14.4f s' % (fid, log['trip_count'][fid], log['fault_time'][fid] * args.pace))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,332 @@
+#!/usr/bin/env python3
+"""
+File:   fault_rule_compiler.py
+
+Summary:
+Host tool compiling composite fault rules into the bytecode executed by the
+fault rule interpreter (project/src/_root/generic/fdrv_FaultRules.c).
+
+Description:
+Each non-empty line of the rule source file defines one rule:
+
+    rule <NAME> = <expression>
+
+Expressions support the operators 'not', 'and', 'xor', 'or' (in order of
+precedence), parentheses and the following functions:
+
+    active(<obj>)              fault_active flag of a fault object
+    latched(<obj>)             fault_status flag of a fault object
+    opmode(<MODE>[|<MODE>])    task manager is in one of the given op-modes
+    atleast(<k>, e1, ..., en)  at least k of n expressions are true (n <= 15)
+    on_delay(<expr>, <time>)   expression is true for at least <time>
+    off_delay(<expr>, <time>)  expression has been true within the past <time>
+    true / false               constants
+
+Fault objects are referenced as OS:<index> or USER:<index> (index into
+os_fault_object_list[] resp. user_fault_object_list[]). Times are given in
+fault check cycles (e.g. 50) or in s/ms/us, converted using the OS master
+pace (--pace, default 100us). Timer presets need to be at least one cycle,
+as rules with a preset of zero are rejected by ValidateFaultRule().
+
+A source file without rules generates an empty rule list.
+
+Lines starting with '#' are comments.
+
+Usage:
+    fault_rule_compiler.py rules.txt [-o UserFaultRules.c] [--pace 100e-6]
+
+Please note:
+Opcodes and encoding must match FAULT_RULE_OPCODE_e in fdrv_FaultRules.h
+"""
+
+import argparse
+import re
+import sys
+
+# Settings must match fdrv_FaultRules.h
+FLTRULE_PROGRAM_SIZE_MAX = 32
+FLTRULE_TIMER_COUNT = 4
+FLTRULE_STACK_DEPTH = 16
+
+OP_END = 0x00
+OP_ACTIVE = 0x01
+OP_STATUS = 0x02
+OP_OPMODE = 0x03
+OP_CONST = 0x04
+OP_NOT = 0x10
+OP_AND = 0x11
+OP_OR = 0x12
+OP_XOR = 0x13
+OP_ATLEAST = 0x14
+OP_ON_DELAY = 0x20
+OP_OFF_DELAY = 0x21
+
+OPERAND_USER_LIST = 0x80
+
+# Must match SYSTEM_OPERATION_MODE_e in os_TaskManager.h
+OP_MODES = {
+    'BOOT': 0x01,
+    'FIRMWARE_INIT': 0x02,
+    'STARTUP_SEQUENCE': 0x04,
+    'IDLE': 0x08,
+    'RUN': 0x10,
+    'FAULT': 0x40,
+    'STANDBY': 0x80,
+}
+
+TOKEN_RE = re.compile(r'\s*(?:(\d+(?:\.\d+)?(?:[eE][-+]?\d+)?)(s|ms|us)?|([A-Za-z_][A-Za-z_0-9]*)|(.))')
+
+
+class RuleError(Exception):
+    pass
+
+
+def tokenize(text):
+    tokens = []
+    pos = 0
+    text = text.strip()
+    while pos < len(text):
+        m = TOKEN_RE.match(text, pos)
+        if m is None:
+            raise RuleError("cannot parse '%s'" % text[pos:])
+        pos = m.end()
+        if m.group(1) is not None:
+            tokens.append(('num', (float(m.group(1)), m.group(2))))
+        elif m.group(3) is not None:
+            tokens.append(('id', m.group(3)))
+        elif m.group(4) is not None and not m.group(4).isspace():
+            tokens.append(('sym', m.group(4)))
+    tokens.append(('eof', None))
+    return tokens
+
+
+class RuleCompiler(object):
+    """Recursive descent parser emitting postfix bytecode"""
+
+    def __init__(self, text, pace):
+        self.tokens = tokenize(text)
+        self.pos = 0
+        self.pace = pace
+        self.code = []
+        self.depth = 0
+        self.max_depth = 0
+        self.timers = 0
+
+    # -- token helpers --------------------------------------------------------
+    def peek(self):
+        return self.tokens[self.pos]
+
+    def take(self, kind=None, value=None):
+        tok = self.tokens[self.pos]
+        if (kind is not None and tok[0] != kind) or (value is not None and tok[1] != value):
+            raise RuleError("expected %s, found '%s'" % (value or kind, tok[1]))
+        self.pos += 1
+        return tok
+
+    def is_keyword(self, word):
+        tok = self.peek()
+        return tok[0] == 'id' and tok[1].lower() == word
+
+    # -- code emitters --------------------------------------------------------
+    def emit(self, opcode, operand=0, push=0, extra=None):
+        self.code.append(((opcode & 0xFF) << 8) | (operand & 0xFF))
+        if extra is not None:
+            self.code.append(extra & 0xFFFF)
+        self.depth += push
+        self.max_depth = max(self.max_depth, self.depth)
+        if self.max_depth > FLTRULE_STACK_DEPTH:
+            raise RuleError("expression nests deeper than %d operands" % FLTRULE_STACK_DEPTH)
+
+    # -- grammar --------------------------------------------------------------
+    def compile(self):
+        self.expr()
+        self.take('eof')
+        if len(self.code) > FLTRULE_PROGRAM_SIZE_MAX:
+            raise RuleError("rule needs %d words (maximum is %d)" % (len(self.code), FLTRULE_PROGRAM_SIZE_MAX))
+        return self.code
+
+    def expr(self):
+        self.xor_term()
+        while self.is_keyword('or'):
+            self.take()
+            self.xor_term()
+            self.emit(OP_OR, push=-1)
+
+    def xor_term(self):
+        self.and_term()
+        while self.is_keyword('xor'):
+            self.take()
+            self.and_term()
+            self.emit(OP_XOR, push=-1)
+
+    def and_term(self):
+        self.factor()
+        while self.is_keyword('and'):
+            self.take()
+            self.factor()
+            self.emit(OP_AND, push=-1)
+
+    def factor(self):
+        if self.is_keyword('not'):
+            self.take()
+            self.factor()
+            self.emit(OP_NOT)
+            return
+        tok = self.peek()
+        if tok == ('sym', '('):
+            self.take()
+            self.expr()
+            self.take('sym', ')')
+            return
+        name = self.take('id')[1].lower()
+        if name in ('true', 'false'):
+            self.emit(OP_CONST, 1 if name == 'true' else 0, push=1)
+        elif name in ('active', 'latched'):
+            self.take('sym', '(')
+            operand = self.object_ref()
+            self.take('sym', ')')
+            self.emit(OP_ACTIVE if name == 'active' else OP_STATUS, operand, push=1)
+        elif name == 'opmode':
+            self.take('sym', '(')
+            mask = self.op_mode()
+            while self.peek() == ('sym', '|'):
+                self.take()
+                mask |= self.op_mode()
+            self.take('sym', ')')
+            self.emit(OP_OPMODE, mask, push=1)
+        elif name == 'atleast':
+            self.take('sym', '(')
+            k = int(self.take('num')[1][0])
+            n = 0
+            while self.peek() == ('sym', ','):
+                self.take()
+                self.expr()
+                n += 1
+            self.take('sym', ')')
+            if not (1 <= n <= 15) or not (0 <= k <= 15):
+                raise RuleError("atleast() supports k <= 15 of 1..15 expressions")
+            self.emit(OP_ATLEAST, (k << 4) | n, push=1 - n)
+        elif name in ('on_delay', 'off_delay'):
+            self.take('sym', '(')
+            self.expr()
+            self.take('sym', ',')
+            preset = self.time_value()
+            self.take('sym', ')')
+            if self.timers >= FLTRULE_TIMER_COUNT:
+                raise RuleError("rule uses more than %d timers" % FLTRULE_TIMER_COUNT)
+            self.emit(OP_ON_DELAY if name == 'on_delay' else OP_OFF_DELAY, self.timers, extra=preset)
+            self.timers += 1
+        else:
+            raise RuleError("unknown function '%s'" % name)
+
+    def object_ref(self):
+        lst = self.take('id')[1].upper()
+        self.take('sym', ':')
+        index = int(self.take('num')[1][0])
+        if lst not in ('OS', 'USER') or not (0 <= index <= 0x7F):
+            raise RuleError("invalid fault object reference %s:%d" % (lst, index))
+        return index | (OPERAND_USER_LIST if lst == 'USER' else 0)
+
+    def op_mode(self):
+        mode = self.take('id')[1].upper().replace('OP_MODE_', '')
+        if mode not in OP_MODES:
+            raise RuleError("unknown operating mode '%s'" % mode)
+        return OP_MODES[mode]
+
+    def time_value(self):
+        value, unit = self.take('num')[1]
+        if unit is not None:
+            value = value * {'s': 1.0, 'ms': 1e-3, 'us': 1e-6}[unit] / self.pace
+        cycles = int(round(value))
+        if not (1 <= cycles <= 0xFFFF):
+            raise RuleError("timer preset of %d cycles is out of range" % cycles)
+        return cycles
+
+
+def parse_rules(lines, pace):
+    rules = []
+    for lineno, line in enumerate(lines, 1):
+        line = line.split('#', 1)[0].strip()
+        if not line:
+            continue
+        m = re.match(r'rule\s+([A-Za-z_][A-Za-z_0-9]*)\s*=\s*(.+)$', line)
+        if m is None:
+            raise RuleError("line %d: expected 'rule <NAME> = <expression>'" % lineno)
+        try:
+            code = RuleCompiler(m.group(2), pace).compile()
+        except RuleError as e:
+            raise RuleError("line %d: %s" % (lineno, e))
+        rules.append((m.group(1), m.group(2), code))
+    return rules
+
+
+def generate_source(rules, source_name):
+    out = []
+    out.append('/*!UserFaultRules.c')
+    out.append(' * ****************************************************************************')
+    out.append(' * File:   UserFaultRules.c')
+    out.append(' *')
+    out.append(' * Description:')
+    out.append(' * Composite fault rules generated by tools/fault_rule_compiler.py from')
+    out.append(' * %s. Do not edit manually.' % source_name)
+    out.append(' ******************************************************************************/')
+    out.append('')
+    out.append('#include <xc.h> // include processor files - each processor file is guarded.  ')
+    out.append('#include <stdint.h> // include standard integer types header file')
+    out.append('#include <stddef.h> // include standard definition types header file')
+    out.append('')
+    out.append('#include "_root/generic/fdrv_FaultRules.h"')
+    out.append('')
+    for rid, (name, text, code) in enumerate(rules):
+        out.append('// rule %s = %s' % (name, text))
+        out.append('const uint16_t fltrule_%s_program[] = { %s };' %
+                   (name, ', '.join('0x%04X' % w for w in code)))
+        out.append('volatile FAULT_RULE_t fltrule_%s = {' % name)
+        out.append('    .id = %d, .status.value = FLTRULE_STATUS_ENABLED, ' % rid)
+        out.append('    .program = fltrule_%s_program, ' % name)
+        out.append('    .length = (sizeof(fltrule_%s_program)/sizeof(fltrule_%s_program[0]))' % (name, name))
+        out.append('};')
+        out.append('')
+    if rules:
+        out.append('volatile FAULT_RULE_t *user_fault_rule_list[] = {')
+        out.append(',\n'.join('    &fltrule_%s' % name for name, _, _ in rules))
+        out.append('};')
+        out.append('volatile uint16_t user_fltrule_list_size = (sizeof(user_fault_rule_list)/sizeof(user_fault_rule_list[0]));')
+    else:
+        out.append('volatile FAULT_RULE_t *user_fault_rule_list[] = { NULL };')
+        out.append('volatile uint16_t user_fltrule_list_size = 0;')
+    out.append('')
+    out.append('// EOF')
+    out.append('')
+    return '\n'.join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile composite fault rules into fault rule bytecode')
+    parser.add_argument('source', help='rule source file')
+    parser.add_argument('-o', '--output', help='generated C source file (default: stdout)')
+    parser.add_argument('--pace', type=float, default=100e-6,
+                        help='fault check period in seconds (TASK_MGR_MASTER_PACE, default 100e-6)')
+    args = parser.parse_args()
+
+    with open(args.source) as f:
+        try:
+            rules = parse_rules(f.readlines(), args.pace)
+        except RuleError as e:
+            sys.stderr.write('%s: %s\n' % (args.source, e))
+            return 1
+
+    for name, _, code in rules:
+        sys.stderr.write('rule %-24s %2d words\n' % (name, len(code)))
+
+    text = generate_source(rules, args.source.replace('\\', '/').split('/')[-1])
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,343 @@
+#!/usr/bin/env python3
+"""
+File:   fixed_point_scaling.py
+
+Summary:
+Host tool generating the integer and Q15 scaling constants of the power
+supply design (project/h/hal/config/syscfg_fixpoint.h)
+
+Description:
+The physical design values (voltage dividers, amplifier gains, shunt
+resistance, switching frequency, T_ACLK, voltage and current limits, etc.)
+are read from the C header files listed by 'import' lines. Every '#define'
+whose value is a constant expression of numbers and previously defined names
+is picked up; all other defines are ignored. Type casts are removed and all
+arithmetic is evaluated exactly (C integer division does not apply).
+
+The scaling source file then declares the constants to be generated:
+
+    import <header file>                  read design values from header file
+    let <NAME> = <expression>             intermediate value (not exported)
+    u16 <NAME> = <expression> [in <min>..<max>]
+    i16 <NAME> = <expression> [in <min>..<max>]
+    q15 <NAME>[, <SHIFT>] = <expression>
+
+u16/i16 constants are rounded to the nearest integer. q15 constants are
+normalized into a signed 16-bit fraction and a bit-shift:
+
+    value = <NAME> * 2^<SHIFT> / 2^15
+
+The shift is exported as <SHIFT> (default <NAME>_BSFT). At runtime, a value
+x is scaled by (x * <NAME>) >> (15 - <SHIFT>) using a single 16x16-bit
+multiplication (see FXP_ScaleU16() in hal_scaling.h). Exported constants can
+be used in subsequent expressions, where they represent their quantized
+value (e.g. duty cycle limits derived from the rounded switching period).
+
+For each constant, the quantization error is reported in LSB and in percent
+of the exact value and written into the generated header. Constants exceeding
+the maximum relative error (--max-error) or their value range are reported
+as errors. The value range of u16/i16 constants can be narrowed by an 'in'
+clause (e.g. ADC result or register bit field range).
+
+The text following '#' on a constant line is used as comment of the
+generated define. Lines starting with '#' are comments.
+
+Usage:
+    fixed_point_scaling.py syscfg_fixpoint.txt [-o syscfg_fixpoint.h] [--max-error 1.0] [--check]
+
+Please note:
+With --check, the output file is not written but compared against the
+generated contents. The tool exits with an error if the header is outdated
+(e.g. design values changed without regenerating the constants).
+"""
+
+import argparse
+import ast
+import math
+import os
+import re
+import sys
+
+INT_RANGE = {'u16': (0, 0xFFFF), 'i16': (-0x8000, 0x7FFF)}
+Q15_SHIFT_RANGE = (-16, 15)
+
+DEFINE_RE = re.compile(r'^\s*#\s*define\s+([A-Za-z_][A-Za-z_0-9]*)(?:\s+(.*))?$')
+CAST_RE = re.compile(r'\(\s*(?:const\s+)?(?:float|double|long|int|unsigned|signed|u?int(?:8|16|32|64)_t)(?:\s+(?:int|long))*\s*\)')
+INT_SUFFIX_RE = re.compile(r'\b(0[xX][0-9a-fA-F]+|0[bB][01]+|\d+)[uUlL]+\b')
+FLOAT_SUFFIX_RE = re.compile(r'\b(\d+\.\d*(?:[eE][+-]?\d+)?|\d+[eE][+-]?\d+|\.\d+(?:[eE][+-]?\d+)?)[fF]\b')
+CONST_RE = re.compile(r'^(u16|i16|q15)\s+([A-Za-z_]\w*)(?:\s*,\s*([A-Za-z_]\w*))?\s*=\s*(.+?)(?:\s+in\s+(\S+)\s*\.\.\s*(\S+))?$')
+LET_RE = re.compile(r'^let\s+([A-Za-z_]\w*)\s*=\s*(.+)$')
+
+FUNCTIONS = {
+    'pow': math.pow, 'sqrt': math.sqrt, 'log2': math.log2,
+    'ceil': math.ceil, 'floor': math.floor, 'fabs': math.fabs,
+}
+BINARY_OPS = {
+    ast.Add: lambda a, b: a + b, ast.Sub: lambda a, b: a - b,
+    ast.Mult: lambda a, b: a * b, ast.Div: lambda a, b: a / b,
+    ast.Pow: lambda a, b: a ** b, ast.LShift: lambda a, b: int(a) << int(b),
+    ast.RShift: lambda a, b: int(a) >> int(b), ast.BitAnd: lambda a, b: int(a) & int(b),
+    ast.BitOr: lambda a, b: int(a) | int(b), ast.BitXor: lambda a, b: int(a) ^ int(b),
+}
+UNARY_OPS = {
+    ast.USub: lambda a: -a, ast.UAdd: lambda a: a, ast.Invert: lambda a: ~int(a),
+}
+
+
+class ScalingError(Exception):
+    pass
+
+
+class UnknownName(ScalingError):
+    pass
+
+
+def evaluate(text, symbols):
+    """Evaluates a C constant expression using exact (real number) arithmetic"""
+    text = CAST_RE.sub('', text)
+    text = INT_SUFFIX_RE.sub(r'\1', text)
+    text = FLOAT_SUFFIX_RE.sub(r'\1', text)
+    try:
+        tree = ast.parse(text.strip(), mode='eval')
+    except SyntaxError:
+        raise ScalingError('cannot parse \'%s\'' % text.strip())
+
+    def node_value(node):
+        if isinstance(node, ast.Expression):
+            return node_value(node.body)
+        if isinstance(node, ast.Constant) and isinstance(node.value, (int, float)) and not isinstance(node.value, bool):
+            return node.value
+        if isinstance(node, ast.Name):
+            if node.id in ('true', 'false'):
+                return 1 if node.id == 'true' else 0
+            if node.id not in symbols:
+                raise UnknownName('undefined name \'%s\'' % node.id)
+            if symbols[node.id] is None:
+                raise ScalingError('\'%s\' is defined more than once with different values' % node.id)
+            return symbols[node.id]
+        if isinstance(node, ast.BinOp) and type(node.op) in BINARY_OPS:
+            try:
+                return BINARY_OPS[type(node.op)](node_value(node.left), node_value(node.right))
+            except ZeroDivisionError:
+                raise ScalingError('division by zero in \'%s\'' % text.strip())
+        if isinstance(node, ast.UnaryOp) and type(node.op) in UNARY_OPS:
+            return UNARY_OPS[type(node.op)](node_value(node.operand))
+        if isinstance(node, ast.Call) and isinstance(node.func, ast.Name) and node.func.id in FUNCTIONS and not node.keywords:
+            return FUNCTIONS[node.func.id](*[node_value(arg) for arg in node.args])
+        raise ScalingError('unsupported expression \'%s\'' % text.strip())
+
+    return node_value(tree)
+
+
+def import_header(path, symbols, origin):
+    """Reads all numeric defines of a C header file into the symbol table"""
+    with open(path, encoding='latin-1') as f:
+        text = f.read()
+    text = re.sub(r'/\*.*?\*/', ' ', text, flags=re.S)
+    text = text.replace('\\\n', ' ')
+    for line in text.splitlines():
+        m = DEFINE_RE.match(line)
+        if not m or not m.group(2):
+            continue
+        expr = m.group(2).split('//', 1)[0].strip()
+        if not expr:
+            continue
+        try:
+            value = evaluate(expr, symbols)
+        except ScalingError:
+            continue
+        name = m.group(1)
+        if name in symbols and symbols[name] != value:
+            symbols[name] = None     # ambiguous (e.g. alternative #if branches)
+        else:
+            symbols[name] = value
+        origin[name] = path
+
+
+def quantize_q15(value):
+    """Returns the Q15 fraction and bit-shift representing value"""
+    if value == 0:
+        return 0, 0
+    shift = max(math.ceil(math.log2(abs(value))), Q15_SHIFT_RANGE[0])
+    while True:
+        if shift > Q15_SHIFT_RANGE[1]:
+            raise ScalingError('%g exceeds the Q15 normalization range' % value)
+        fraction = int(round(value * 2 ** (15 - shift)))
+        if -0x8000 <= fraction <= 0x7FFF:
+            return fraction, shift
+        shift += 1
+
+
+def parse_source(path, max_error):
+    symbols = {}
+    origin = {}
+    constants = []
+    with open(path) as f:
+        lines = f.readlines()
+
+    for line_no, line in enumerate(lines, 1):
+        text, _, comment = line.partition('#')
+        text = text.strip()
+        comment = comment.strip()
+        if not text:
+            continue
+        try:
+            if text.startswith('import '):
+                header = os.path.join(os.path.dirname(path), text.split(None, 1)[1].strip())
+                if not os.path.isfile(header):
+                    raise ScalingError('cannot open \'%s\'' % header)
+                import_header(header, symbols, origin)
+                continue
+
+            m = LET_RE.match(text)
+            if m:
+                name, expr = m.groups()
+                if name in symbols:
+                    raise ScalingError('\'%s\' is already defined in %s' % (name, origin.get(name, path)))
+                symbols[name] = evaluate(expr, symbols)
+                origin[name] = path
+                continue
+
+            m = CONST_RE.match(text)
+            if not m:
+                raise ScalingError('expected \'import\', \'let\', \'u16\', \'i16\' or \'q15\' declaration')
+            kind, name, shift_name, expr, low, high = m.groups()
+            if kind != 'q15' and shift_name:
+                raise ScalingError('shift name is only supported by q15 constants')
+            if kind == 'q15' and low is not None:
+                raise ScalingError('value range is not supported by q15 constants')
+            shift_name = shift_name or (name + '_BSFT')
+            for n in ((name, shift_name) if kind == 'q15' else (name,)):
+                if n in symbols:
+                    raise ScalingError('\'%s\' is already defined in %s' % (n, origin.get(n, path)))
+
+            exact = evaluate(expr, symbols)
+            if kind == 'q15':
+                fraction, shift = quantize_q15(exact)
+                quantized = fraction * 2.0 ** (shift - 15)
+                lsb = 2.0 ** (shift - 15)
+                constants.append((kind, name, shift_name, fraction, shift, exact, quantized, lsb, comment, line_no))
+                symbols[name] = quantized
+                symbols[shift_name] = shift
+            else:
+                lo, hi = INT_RANGE[kind]
+                if low is not None:
+                    lo, hi = max(lo, int(evaluate(low, symbols))), min(hi, int(evaluate(high, symbols)))
+                value = int(math.floor(exact + 0.5))
+                if value < lo or value > hi:
+                    raise ScalingError('%s = %g is out of range (%d..%d)' % (name, exact, lo, hi))
+                quantized = value
+                lsb = 1.0
+                constants.append((kind, name, None, value, None, exact, quantized, lsb, comment, line_no))
+                symbols[name] = value
+            origin[name] = path
+        except ScalingError as e:
+            raise ScalingError('line %d: %s' % (line_no, e))
+
+    errors = []
+    for c in constants:
+        kind, name, exact, quantized = c[0], c[1], c[5], c[6]
+        if relative_error(exact, quantized) > max_error:
+            errors.append('line %d: %s = %g quantized to %g (%.3f %% error exceeds %.3f %%)' % (
+                c[9], name, exact, quantized, relative_error(exact, quantized), max_error))
+    if errors:
+        raise ScalingError('\n'.join(errors))
+    return constants
+
+
+def relative_error(exact, quantized):
+    if exact == 0:
+        return 0.0 if quantized == 0 else float('inf')
+    return abs(quantized - exact) * 100.0 / abs(exact)
+
+
+def error_text(c):
+    exact, quantized, lsb = c[5], c[6], c[7]
+    return '%.6g (%+.3f LSB, %.3f %%)' % (exact, (quantized - exact) / lsb, relative_error(exact, quantized))
+
+
+def generate_header(constants, source_name):
+    out = []
+    out.append('/*!syscfg_fixpoint.h')
+    out.append(' * ****************************************************************************')
+    out.append(' * File:   syscfg_fixpoint.h')
+    out.append(' *')
+    out.append(' * Description:')
+    out.append(' * Fixed-point scaling constants generated by tools/fixed_point_scaling.py')
+    out.append(' * from %s. Do not edit manually.' % source_name)
+    out.append(' *')
+    out.append(' * Each define is followed by the exact value of its design expression and the')
+    out.append(' * quantization error in LSB and percent. Q15 factors are applied by')
+    out.append(' * (x * <factor>) >> (15 - <factor>_BSFT) (see hal_scaling.h).')
+    out.append(' ******************************************************************************/')
+    out.append('')
+    out.append('#ifndef _HARDWARE_ABSTRACTION_LAYER_SYSTEM_FIXPOINT_H_')
+    out.append('#define\t_HARDWARE_ABSTRACTION_LAYER_SYSTEM_FIXPOINT_H_')
+    out.append('')
+    width = max([len(c[1]) for c in constants] + [len(c[2]) for c in constants if c[2]] + [0]) + 4
+    for c in constants:
+        kind, name, shift_name, value, shift, comment = c[0], c[1], c[2], c[3], c[4], c[8]
+        if kind == 'u16':
+            literal = '%du' % value
+        elif kind == 'i16':
+            literal = '(%d)' % value if value < 0 else '%d' % value
+        else:
+            literal = '(-0x%04X)' % -value if value < 0 else '0x%04X' % value
+        text = '// %s' % error_text(c)
+        if comment:
+            text += ' %s' % comment
+        out.append('#define %-*s %-10s %s' % (width, name, literal, text))
+        if kind == 'q15':
+            out.append('#define %-*s %-10s // Bit-shift of %s' % (
+                width, shift_name, '(%d)' % shift if shift < 0 else '%d' % shift, name))
+    out.append('')
+    out.append('#endif\t/* _HARDWARE_ABSTRACTION_LAYER_SYSTEM_FIXPOINT_H_ */')
+    out.append('')
+    out.append('// EOF')
+    out.append('')
+    return '\n'.join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate fixed-point scaling constants')
+    parser.add_argument('source', help='scaling source file')
+    parser.add_argument('-o', '--output', help='generated C header file (default: stdout)')
+    parser.add_argument('--max-error', type=float, default=1.0,
+                        help='maximum relative quantization error in percent (default: 1.0)')
+    parser.add_argument('--check', action='store_true',
+                        help='verify the output file is up to date instead of writing it')
+    args = parser.parse_args()
+
+    try:
+        constants = parse_source(args.source, args.max_error)
+    except ScalingError as e:
+        sys.stderr.write('%s: %s\n' % (args.source, e))
+        return 1
+
+    for c in constants:
+        sys.stderr.write('%-28s %s %8d  %s\n' % (
+            c[1], c[0], c[3], error_text(c)))
+
+    text = generate_header(constants, args.source.replace('\\', '/').split('/')[-1])
+    if args.check:
+        if not args.output:
+            sys.stderr.write('--check requires an output file\n')
+            return 1
+        try:
+            with open(args.output) as f:
+                current = f.read()
+        except OSError:
+            current = None
+        if current != text:
+            sys.stderr.write('%s is out of date\n' % args.output)
+            return 1
+    elif args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
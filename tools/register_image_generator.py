@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+File:   register_image_generator.py
+
+Summary:
+Host tool generating the constant peripheral register images applied by
+project/src/mcal/initialization/init_regimage.c
+
+Description:
+The source file declares one or more register images, each covering the
+configuration registers of one peripheral:
+
+    image <NAME>
+        <SFR> = <value>[/<mask>] [<value>[/<mask>] ...]
+
+Each register line defines a block of consecutive 16-bit registers starting
+at the special function register <SFR>. The first value is written to <SFR>,
+the following values to the next register addresses. Values and masks are
+given as decimal, hexadecimal (0x) or binary (0b) numbers. The optional mask
+selects the bits covered by the readback verification (default 0xFFFF) and
+is used to exclude status flags, write-only bits and bits changed by
+hardware or by the application during operation.
+
+Blocks are written in the order they are listed. Enable bits (e.g. ON, ADON)
+should therefore be set by the last block of an image. Register values can be
+copied from the MPLAB X SFR window after the peripheral has been configured
+once by the peripheral library or MCC generated code.
+
+Lines starting with '#' are comments.
+
+Usage:
+    register_image_generator.py images.txt [-o UserRegisterImages.c]
+
+Please note:
+The checksum algorithm must match RegisterImage_GetChecksum() in
+init_regimage.c (CRC-16-CCITT over 16-bit words, polynomial 0x1021,
+initial value 0xFFFF, MSB first).
+"""
+
+import argparse
+import re
+import sys
+
+NAME_RE = re.compile(r'^[A-Za-z_][A-Za-z_0-9]*$')
+WORD_MASK = 0xFFFF
+CRC_POLYNOM = 0x1021
+CRC_SEED = 0xFFFF
+
+
+class ImageError(Exception):
+    pass
+
+
+def parse_number(text, line_no):
+    try:
+        value = int(text, 0)
+    except ValueError:
+        raise ImageError('line %d: invalid number \'%s\'' % (line_no, text))
+    if value < 0 or value > WORD_MASK:
+        raise ImageError('line %d: value \'%s\' exceeds 16 bits' % (line_no, text))
+    return value
+
+
+def parse_images(lines):
+    images = []
+    for line_no, line in enumerate(lines, 1):
+        line = line.split('#', 1)[0].strip()
+        if not line:
+            continue
+        words = line.split()
+        if words[0] == 'image':
+            if len(words) != 2 or not NAME_RE.match(words[1]):
+                raise ImageError('line %d: expected \'image <NAME>\'' % line_no)
+            if any(name == words[1] for name, _ in images):
+                raise ImageError('line %d: image %s already defined' % (line_no, words[1]))
+            images.append((words[1], []))
+            continue
+        if '=' not in line:
+            raise ImageError('line %d: expected \'<SFR> = <value>[/<mask>] ...\'' % line_no)
+        if not images:
+            raise ImageError('line %d: register block outside of an image' % line_no)
+        sfr, data = (s.strip() for s in line.split('=', 1))
+        if not NAME_RE.match(sfr):
+            raise ImageError('line %d: invalid register name \'%s\'' % (line_no, sfr))
+        if not data:
+            raise ImageError('line %d: no register values given' % line_no)
+        values = []
+        for item in data.split():
+            value, _, mask = item.partition('/')
+            values.append((parse_number(value, line_no), parse_number(mask, line_no) if mask else WORD_MASK))
+        images[-1][1].append((sfr, values))
+
+    for name, blocks in images:
+        if not blocks:
+            raise ImageError('image %s has no register blocks' % name)
+    return images
+
+
+def checksum(blocks):
+    crc = CRC_SEED
+    for _, values in blocks:
+        for value, mask in values:
+            crc ^= (value & mask)
+            for _ in range(16):
+                if crc & 0x8000:
+                    crc = ((crc << 1) ^ CRC_POLYNOM) & WORD_MASK
+                else:
+                    crc = (crc << 1) & WORD_MASK
+    return crc
+
+
+def generate_source(images, source_name):
+    out = []
+    out.append('/*!UserRegisterImages.c')
+    out.append(' * ****************************************************************************')
+    out.append(' * File:   UserRegisterImages.c')
+    out.append(' *')
+    out.append(' * Description:')
+    out.append(' * Peripheral register images generated by tools/register_image_generator.py')
+    out.append(' * from %s. Do not edit manually.' % source_name)
+    out.append(' ******************************************************************************/')
+    out.append('')
+    out.append('#include <xc.h> // include processor files - each processor file is guarded.  ')
+    out.append('#include <stdint.h> // include standard integer types header file')
+    out.append('#include <stddef.h> // include standard definition types header file')
+    out.append('')
+    out.append('#include "_root/config/task_manager_config.h"')
+    out.append('#include "mcal/initialization/init_regimage.h"')
+    out.append('')
+    out.append('#if (USE_REGISTER_IMAGES == 1)')
+    out.append('')
+    for name, blocks in images:
+        flat = [vm for _, values in blocks for vm in values]
+        out.append('// image %s: %d blocks, %d registers' % (name, len(blocks), len(flat)))
+        out.append('const uint16_t regimg_%s_value[] = { %s };' %
+                   (name, ', '.join('0x%04X' % v for v, _ in flat)))
+        out.append('const uint16_t regimg_%s_mask[] = { %s };' %
+                   (name, ', '.join('0x%04X' % m for _, m in flat)))
+        out.append('const REGISTER_IMAGE_BLOCK_t regimg_%s_block[] = {' % name)
+        rows = []
+        offset = 0
+        for sfr, values in blocks:
+            rows.append('    { .sfr = &%s, .count = %d, .value = &regimg_%s_value[%d], .mask = &regimg_%s_mask[%d] }' %
+                        (sfr, len(values), name, offset, name, offset))
+            offset += len(values)
+        out.append(',\n'.join(rows))
+        out.append('};')
+        out.append('const REGISTER_IMAGE_t regimg_%s = {' % name)
+        out.append('    .block = regimg_%s_block, ' % name)
+        out.append('    .size = (sizeof(regimg_%s_block)/sizeof(regimg_%s_block[0])), ' % (name, name))
+        out.append('    .crc = 0x%04X' % checksum(blocks))
+        out.append('};')
+        out.append('')
+    if images:
+        out.append('const REGISTER_IMAGE_t *register_image_list[] = {')
+        out.append(',\n'.join('    &regimg_%s' % name for name, _ in images))
+        out.append('};')
+        out.append('const uint16_t register_image_list_size = (sizeof(register_image_list)/sizeof(register_image_list[0]));')
+    else:
+        out.append('const REGISTER_IMAGE_t *register_image_list[] = { NULL };')
+        out.append('const uint16_t register_image_list_size = 0;')
+    out.append('')
+    out.append('#endif')
+    out.append('')
+    out.append('// EOF')
+    out.append('')
+    return '\n'.join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate constant peripheral register images')
+    parser.add_argument('source', help='register image source file')
+    parser.add_argument('-o', '--output', help='generated C source file (default: stdout)')
+    args = parser.parse_args()
+
+    with open(args.source) as f:
+        try:
+            images = parse_images(f.readlines())
+        except ImageError as e:
+            sys.stderr.write('%s: %s\n' % (args.source, e))
+            return 1
+
+    for name, blocks in images:
+        sys.stderr.write('image %-24s %2d blocks %3d registers  crc 0x%04X\n' % (
+            name, len(blocks), sum(len(values) for _, values in blocks), checksum(blocks)))
+
+    text = generate_source(images, args.source.replace('\\', '/').split('/')[-1])
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())